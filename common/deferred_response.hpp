@@ -0,0 +1,185 @@
+#pragma once
+
+#include "libpldm/base.h"
+#include "libpldm/requester/pldm.h"
+
+#include "common/flight_recorder.hpp"
+#include "common/metrics.hpp"
+#include "common/tx_batch.hpp"
+#include "common/types.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <iostream>
+#include <optional>
+#include <utility>
+
+namespace pldm
+{
+namespace deferred
+{
+
+/** @class Responder
+ *
+ *  Sends the response to a request whose handler returned before the response
+ *  was ready, for instance while a D-Bus call it depends on is in flight
+ */
+class Responder
+{
+  public:
+    Responder() = delete;
+
+    /** @brief Constructor
+     *
+     *  @param[in] fd - fd of the MCTP communications socket
+     *  @param[in] eid - endpoint ID of the requester
+     *  @param[in] hdr - header of the request
+     */
+    Responder(int fd, mctp_eid_t eid, const pldm_header_info& hdr) :
+        fd(fd), eid(eid), hdr(hdr), startTime(std::chrono::steady_clock::now())
+    {}
+
+    /** @brief Get the endpoint ID of the requester */
+    mctp_eid_t requester() const
+    {
+        return eid;
+    }
+
+    /** @brief Get the instance ID to encode the response with */
+    uint8_t instanceId() const
+    {
+        return hdr.instance;
+    }
+
+    /** @brief Send the response
+     *
+     *  @param[in] response - PLDM response message
+     *
+     *  @return PLDM_SUCCESS on success and PLDM_ERROR otherwise
+     */
+    int send(Response&& response) const
+    {
+        if (response.size() > sizeof(pldm_msg_hdr))
+        {
+            pldm::metrics::Metrics::GetInstance().handled(
+                hdr.pldm_type, hdr.command, response[sizeof(pldm_msg_hdr)],
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - startTime));
+        }
+        pldm::flightrecorder::FlightRecorder::GetInstance().saveRecord(
+            eid, response.data(), response.size(), true);
+
+        // The reply may arrive while the daemon handles received messages
+        auto& txBatch = pldm::txbatch::TxBatch::GetInstance();
+        if (txBatch.isOpen(fd))
+        {
+            txBatch.add(eid, std::move(response));
+            return PLDM_SUCCESS;
+        }
+
+        auto rc = pldm_send(eid, fd, response.data(), response.size());
+        if (rc < 0)
+        {
+            std::cerr << "Failed to send deferred PLDM response. RC = " << rc
+                      << ", errno = " << errno << "\n";
+            return PLDM_ERROR;
+        }
+        return PLDM_SUCCESS;
+    }
+
+  private:
+    int fd;
+    mctp_eid_t eid;
+    pldm_header_info hdr;
+    std::chrono::steady_clock::time_point startTime;
+};
+
+/** @class DeferredResponse
+ *
+ *  Lets the command handler of the request being handled take over sending
+ *  its response. The response the handler returns is then dropped, and the
+ *  handler sends the actual one through the Responder once it is ready,
+ *  without blocking the event loop meanwhile.
+ */
+class DeferredResponse
+{
+  private:
+    DeferredResponse() = default;
+
+    /** @brief Responder of the request being handled, if any */
+    std::optional<Responder> current;
+
+    /** @brief True if the handler of the request being handled deferred its
+     *         response
+     */
+    bool deferred = false;
+
+  public:
+    DeferredResponse(const DeferredResponse&) = delete;
+    DeferredResponse(DeferredResponse&&) = delete;
+    DeferredResponse& operator=(const DeferredResponse&) = delete;
+    DeferredResponse& operator=(DeferredResponse&&) = delete;
+    ~DeferredResponse() = default;
+
+    static DeferredResponse& GetInstance()
+    {
+        static DeferredResponse deferredResponse;
+        return deferredResponse;
+    }
+
+    /** @brief Mark the start of the handling of a request
+     *
+     *  @param[in] fd - fd of the MCTP communications socket
+     *  @param[in] eid - endpoint ID of the requester
+     *  @param[in] hdr - header of the request
+     */
+    void begin(int fd, mctp_eid_t eid, const pldm_header_info& hdr)
+    {
+        current.emplace(fd, eid, hdr);
+        deferred = false;
+    }
+
+    /** @brief Mark the end of the handling of a request
+     *
+     *  @return true if the handler deferred the response, that is the
+     *          response it returned is not to be sent
+     */
+    bool end()
+    {
+        current.reset();
+        return std::exchange(deferred, false);
+    }
+
+    /** @brief Get the requester of the request being handled
+     *
+     *  @return the endpoint ID of the requester, std::nullopt if no request
+     *          is being handled
+     */
+    std::optional<mctp_eid_t> requester() const
+    {
+        if (!current)
+        {
+            return std::nullopt;
+        }
+        return current->requester();
+    }
+
+    /** @brief Defer the response to the request being handled
+     *
+     *  @return the responder to send the response with, std::nullopt if no
+     *          request is being handled, in which case the handler must
+     *          return its response
+     */
+    std::optional<Responder> defer()
+    {
+        if (!current)
+        {
+            return std::nullopt;
+        }
+        deferred = true;
+        return current;
+    }
+};
+
+} // namespace deferred
+} // namespace pldm
@@ -2,56 +2,397 @@
 
 #include <config.h>
 
-#include <common/utils.hpp>
+#include "libpldm/base.h"
+#include "libpldm/bios.h"
+#include "libpldm/fru.h"
+#include "libpldm/platform.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
-#include <vector>
 namespace pldm
 {
 namespace flightrecorder
 {
 
 using ReqOrResponse = bool;
-using FlightRecorderData = std::vector<uint8_t>;
-using FlightRecorderTimeStamp = std::string;
-using FlightRecorderRecord =
-    std::tuple<FlightRecorderTimeStamp, ReqOrResponse, FlightRecorderData>;
-using FlightRecorderCassette = std::vector<FlightRecorderRecord>;
 
-static constexpr auto flightRecorderDumpPath = "/tmp/pldm_flight_recorder";
+/** @brief "PLFR", identifies a flight recorder ring */
+constexpr uint32_t recorderMagic = 0x52464c50;
+constexpr uint16_t recorderVersion = 1;
 
-/** @class FlightRecorder
+/** @brief Number of bytes of a PLDM message kept in a record, the PLDM header
+ *         and the start of the payload, set by the flightrecorder-data-size
+ *         option
+ */
+constexpr size_t recordDataSize = FLIGHT_RECORDER_DATA_SIZE;
+
+/** @struct RecorderHeader
+ *
+ *  Header of the ring of records, at the start of the recorder memory. The
+ *  layout is the one of the recorder file the decoder reads.
+ */
+struct RecorderHeader
+{
+    uint32_t magic;   //!< recorderMagic
+    uint16_t version; //!< recorderVersion
+    uint16_t recordSize;
+    uint32_t numRecords;
+    uint32_t reserved;
+    int64_t realTimeOffsetNs; //!< CLOCK_REALTIME - CLOCK_MONOTONIC
+    uint64_t writeIndex;      //!< number of records written so far
+};
+
+/** @struct Record
  *
- *  The class for implementing the PLDM flight recorder logic. This class
- *  handles the insertion of the data into the recorder and also provides
- *  API's to dump the flight recorder into a file.
+ *  A PLDM message sent or received, the record at position i of the ring is
+ *  valid if its sequence is i + 1.
  */
+struct Record
+{
+    uint64_t sequence;
+    uint64_t timeStampNs; //!< CLOCK_MONOTONIC
+    uint32_t length;      //!< length of the PLDM message
+    uint8_t eid;          //!< remote MCTP endpoint
+    uint8_t isTx;
+    uint8_t reserved[2];
+    uint8_t data[recordDataSize];
+};
 
+static_assert(sizeof(RecorderHeader) == 32);
+static_assert(sizeof(Record) == 24 + recordDataSize,
+              "flightrecorder-data-size must be a multiple of 8");
+
+/** @brief Size of the memory of a ring of records
+ *
+ *  @param[in] numRecords - number of records in the ring
+ *
+ *  @return size in bytes
+ */
+inline size_t recorderSize(size_t numRecords)
+{
+    return sizeof(RecorderHeader) + numRecords * sizeof(Record);
+}
+
+/** @brief Get the current time of a clock in nanoseconds */
+inline int64_t clockNs(clockid_t clock)
+{
+    struct timespec ts
+    {};
+    clock_gettime(clock, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+/** @brief Set up a ring of records, the records of a ring with the same
+ *         geometry are kept
+ *
+ *  @param[in] memory - memory of the ring, of recorderSize(numRecords) bytes
+ *  @param[in] numRecords - number of records in the ring
+ */
+inline void initRecorder(void* memory, size_t numRecords)
+{
+    auto header = static_cast<RecorderHeader*>(memory);
+    if (header->magic == recorderMagic && header->version == recorderVersion &&
+        header->recordSize == sizeof(Record) &&
+        header->numRecords == numRecords)
+    {
+        return;
+    }
+
+    std::memset(memory, 0, recorderSize(numRecords));
+    header->version = recorderVersion;
+    header->recordSize = sizeof(Record);
+    header->numRecords = numRecords;
+    header->realTimeOffsetNs =
+        clockNs(CLOCK_REALTIME) - clockNs(CLOCK_MONOTONIC);
+    header->magic = recorderMagic;
+}
+
+/** @brief Add a PLDM message to a ring of records
+ *
+ *  @param[in] memory - memory of the ring set up by initRecorder()
+ *  @param[in] eid - remote MCTP endpoint
+ *  @param[in] msg - PLDM message
+ *  @param[in] length - length of the PLDM message
+ *  @param[in] isTx - true if the message is sent
+ */
+inline void writeRecord(void* memory, uint8_t eid, const uint8_t* msg,
+                        size_t length, ReqOrResponse isTx)
+{
+    auto header = static_cast<RecorderHeader*>(memory);
+    auto records = reinterpret_cast<Record*>(header + 1);
+
+    auto index = std::atomic_ref<uint64_t>(header->writeIndex)
+                     .fetch_add(1, std::memory_order_relaxed);
+    auto& record = records[index % header->numRecords];
+    std::atomic_ref<uint64_t> sequence(record.sequence);
+    // A reader seeing the record while it is written skips it
+    sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    record.timeStampNs = clockNs(CLOCK_MONOTONIC);
+    record.length = length;
+    record.eid = eid;
+    record.isTx = isTx;
+    std::memcpy(record.data, msg, std::min(length, recordDataSize));
+    sequence.store(index + 1, std::memory_order_release);
+}
+
+/** @brief Get the name of a PLDM command
+ *
+ *  @param[in] type - PLDM type
+ *  @param[in] command - PLDM command
+ *
+ *  @return name of the command, nullptr if it is not known
+ */
+inline const char* commandName(uint8_t type, uint8_t command)
+{
+    switch (type)
+    {
+        case PLDM_BASE:
+            switch (command)
+            {
+                case PLDM_GET_TID:
+                    return "GetTID";
+                case PLDM_GET_PLDM_VERSION:
+                    return "GetPLDMVersion";
+                case PLDM_GET_PLDM_TYPES:
+                    return "GetPLDMTypes";
+                case PLDM_GET_PLDM_COMMANDS:
+                    return "GetPLDMCommands";
+            }
+            break;
+        case PLDM_PLATFORM:
+            switch (command)
+            {
+                case PLDM_SET_EVENT_RECEIVER:
+                    return "SetEventReceiver";
+                case PLDM_PLATFORM_EVENT_MESSAGE:
+                    return "PlatformEventMessage";
+                case PLDM_GET_SENSOR_READING:
+                    return "GetSensorReading";
+                case PLDM_GET_STATE_SENSOR_READINGS:
+                    return "GetStateSensorReadings";
+                case PLDM_SET_NUMERIC_EFFECTER_VALUE:
+                    return "SetNumericEffecterValue";
+                case PLDM_GET_NUMERIC_EFFECTER_VALUE:
+                    return "GetNumericEffecterValue";
+                case PLDM_SET_STATE_EFFECTER_STATES:
+                    return "SetStateEffecterStates";
+                case PLDM_GET_PDR:
+                    return "GetPDR";
+            }
+            break;
+        case PLDM_BIOS:
+            switch (command)
+            {
+                case PLDM_GET_BIOS_TABLE:
+                    return "GetBIOSTable";
+                case PLDM_SET_BIOS_TABLE:
+                    return "SetBIOSTable";
+                case PLDM_SET_BIOS_ATTRIBUTE_CURRENT_VALUE:
+                    return "SetBIOSAttributeCurrentValue";
+                case PLDM_GET_BIOS_ATTRIBUTE_CURRENT_VALUE_BY_HANDLE:
+                    return "GetBIOSAttributeCurrentValueByHandle";
+                case PLDM_GET_DATE_TIME:
+                    return "GetDateTime";
+                case PLDM_SET_DATE_TIME:
+                    return "SetDateTime";
+            }
+            break;
+        case PLDM_FRU:
+            switch (command)
+            {
+                case PLDM_GET_FRU_RECORD_TABLE_METADATA:
+                    return "GetFRURecordTableMetadata";
+                case PLDM_GET_FRU_RECORD_TABLE:
+                    return "GetFRURecordTable";
+                case PLDM_SET_FRU_RECORD_TABLE:
+                    return "SetFRURecordTable";
+                case PLDM_GET_FRU_RECORD_BY_OPTION:
+                    return "GetFRURecordByOption";
+            }
+            break;
+    }
+    return nullptr;
+}
+
+/** @brief Write the records of a ring as text, oldest first
+ *
+ *  @param[in] out - stream to write to
+ *  @param[in] memory - memory of the ring
+ *  @param[in] size - size of the memory
+ *
+ *  @return number of records written, -1 if the memory is not a ring of
+ *          records
+ */
+inline int decodeRecorder(std::ostream& out, const void* memory, size_t size)
+{
+    auto header = static_cast<const RecorderHeader*>(memory);
+    if (size < sizeof(RecorderHeader) || header->magic != recorderMagic ||
+        header->version != recorderVersion ||
+        header->recordSize != sizeof(Record) || !header->numRecords ||
+        size < recorderSize(header->numRecords))
+    {
+        return -1;
+    }
+    auto records = reinterpret_cast<const Record*>(header + 1);
+
+    auto writeIndex =
+        std::atomic_ref<uint64_t>(const_cast<uint64_t&>(header->writeIndex))
+            .load(std::memory_order_acquire);
+    auto first =
+        writeIndex > header->numRecords ? writeIndex - header->numRecords : 0;
+    int count = 0;
+    for (auto index = first; index < writeIndex; ++index)
+    {
+        Record record{};
+        const auto& slot = records[index % header->numRecords];
+        std::memcpy(&record, &slot, sizeof(record));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (record.sequence != index + 1 ||
+            std::atomic_ref<uint64_t>(const_cast<uint64_t&>(slot.sequence))
+                    .load(std::memory_order_relaxed) != index + 1)
+        {
+            // Overwritten or being written
+            continue;
+        }
+
+        auto realTimeNs = header->realTimeOffsetNs +
+                          static_cast<int64_t>(record.timeStampNs);
+        time_t seconds = realTimeNs / 1000000000;
+        struct tm tm
+        {};
+        localtime_r(&seconds, &tm);
+        out << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << "." << std::dec
+            << std::setfill('0') << std::setw(9) << realTimeNs % 1000000000
+            << " : " << (record.isTx ? "Tx" : "Rx")
+            << " EID=" << static_cast<unsigned>(record.eid);
+
+        auto captured = std::min<size_t>(record.length, recordDataSize);
+        if (captured >= sizeof(pldm_msg_hdr))
+        {
+            auto hdr = reinterpret_cast<const pldm_msg_hdr*>(record.data);
+            auto name = commandName(hdr->type, hdr->command);
+            out << (hdr->request ? " Request " : " Response ");
+            if (name)
+            {
+                out << name;
+            }
+            else
+            {
+                out << "Type=" << static_cast<unsigned>(hdr->type)
+                    << " Command=" << static_cast<unsigned>(hdr->command);
+            }
+            out << " InstanceId=" << static_cast<unsigned>(hdr->instance_id);
+        }
+        out << " :";
+        for (size_t i = 0; i < captured; ++i)
+        {
+            out << " " << std::setfill('0') << std::setw(2) << std::hex
+                << static_cast<unsigned>(record.data[i]);
+        }
+        if (record.length > captured)
+        {
+            out << " ... (" << std::dec << record.length << " bytes)";
+        }
+        out << std::dec << "\n";
+        ++count;
+    }
+    return count;
+}
+
+/** @class FlightRecorder
+ *
+ *  The class for implementing the PLDM flight recorder logic. The messages are
+ *  kept in a fixed ring of binary records, in a memory mapped file when
+ *  FLIGHT_RECORDER_FILE is set so that the records outlive a crash of the
+ *  daemon. This class handles the insertion of the data into the recorder and
+ *  also provides API's to dump the flight recorder into a file.
+ */
 class FlightRecorder
 {
   private:
-    FlightRecorder() : index(0)
+    FlightRecorder()
+    {
+        if (FLIGHT_RECORDER_MAX_ENTRIES)
+        {
+            mapRecorder(FLIGHT_RECORDER_FILE);
+        }
+    }
+
+    /** @brief Map the memory of the ring of records
+     *
+     *  @param[in] path - file backing the ring, anonymous memory if empty or
+     *                    if the file cannot be mapped
+     */
+    void mapRecorder(const std::string& path)
     {
-        flightRecorderPolicy = FLIGHT_RECORDER_MAX_ENTRIES ? true : false;
-        if (flightRecorderPolicy)
+        size = recorderSize(FLIGHT_RECORDER_MAX_ENTRIES);
+        if (!path.empty())
         {
-            tapeRecorder = FlightRecorderCassette(FLIGHT_RECORDER_MAX_ENTRIES);
+            std::error_code ec;
+            std::filesystem::create_directories(
+                std::filesystem::path(path).parent_path(), ec);
+            int fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+            if (fd >= 0)
+            {
+                if (ftruncate(fd, size) == 0)
+                {
+                    memory = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                                  MAP_SHARED, fd, 0);
+                }
+                close(fd);
+            }
+            if (memory == MAP_FAILED || memory == nullptr)
+            {
+                std::cerr << "Failed to map the flight recorder file " << path
+                          << ", errno = " << errno << "\n";
+                memory = nullptr;
+            }
+        }
+        if (!memory)
+        {
+            memory = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (memory == MAP_FAILED)
+            {
+                std::cerr << "Failed to allocate the flight recorder, errno = "
+                          << errno << "\n";
+                memory = nullptr;
+                return;
+            }
         }
+        initRecorder(memory, FLIGHT_RECORDER_MAX_ENTRIES);
     }
 
   protected:
-    int index;
-    FlightRecorderCassette tapeRecorder;
-    bool flightRecorderPolicy;
+    void* memory = nullptr; //!< memory of the ring, nullptr if disabled
+    size_t size = 0;        //!< size of the memory of the ring
 
   public:
     FlightRecorder(const FlightRecorder&) = delete;
     FlightRecorder(FlightRecorder&&) = delete;
     FlightRecorder& operator=(const FlightRecorder&) = delete;
     FlightRecorder& operator=(FlightRecorder&&) = delete;
-    ~FlightRecorder() = default;
+    ~FlightRecorder()
+    {
+        if (memory)
+        {
+            munmap(memory, size);
+        }
+    }
 
     static FlightRecorder& GetInstance()
     {
@@ -61,24 +402,26 @@ class FlightRecorder
 
     /** @brief Add records to the flightRecorder
      *
-     *  @param[in] buffer  - The request/respose byte buffer
+     *  Only the start of the message is kept, in the record it replaces, so
+     *  recording costs no allocation and no formatting.
+     *
+     *  @param[in] eid - remote MCTP endpoint
+     *  @param[in] buffer - The PLDM request/respose message
+     *  @param[in] length - The length of the message
      *  @param[in] isRequest - bool that captures if it is a request message or
      *                         a response message
      *
      *  @return void
      */
-    void saveRecord(const FlightRecorderData& buffer, ReqOrResponse isRequest)
+    void saveRecord(uint8_t eid, const uint8_t* buffer, size_t length,
+                    ReqOrResponse isRequest)
     {
         // if the flight recorder policy is enabled, then only insert the
         // messages into the flight recorder, if not this function will be just
         // a no-op
-        if (flightRecorderPolicy)
+        if (memory)
         {
-            int currentIndex = index++;
-            tapeRecorder[currentIndex] = std::make_tuple(
-                pldm::utils::getCurrentSystemTime(), isRequest, buffer);
-            index =
-                (currentIndex == FLIGHT_RECORDER_MAX_ENTRIES - 1) ? 0 : index;
+            writeRecord(memory, eid, buffer, length, isRequest);
         }
     }
 
@@ -89,31 +432,12 @@ class FlightRecorder
 
     void playRecorder()
     {
-        if (flightRecorderPolicy)
+        if (memory)
         {
-            std::ofstream recorderOutputFile(flightRecorderDumpPath);
+            std::ofstream recorderOutputFile(FLIGHT_RECORDER_DUMP_PATH);
             std::cout << "Dumping the flight recorder into : "
-                      << flightRecorderDumpPath << "\n";
-
-            for (const auto& message : tapeRecorder)
-            {
-                recorderOutputFile << std::get<FlightRecorderTimeStamp>(message)
-                                   << " : ";
-                if (std::get<ReqOrResponse>(message))
-                {
-                    recorderOutputFile << "Tx : \n";
-                }
-                else
-                {
-                    recorderOutputFile << "Rx : \n";
-                }
-                for (const auto& word : std::get<FlightRecorderData>(message))
-                {
-                    recorderOutputFile << std::setfill('0') << std::setw(2)
-                                       << std::hex << (unsigned)word << " ";
-                }
-                recorderOutputFile << std::endl;
-            }
+                      << FLIGHT_RECORDER_DUMP_PATH << "\n";
+            decodeRecorder(recorderOutputFile, memory, size);
             recorderOutputFile.close();
         }
         else
@@ -0,0 +1,271 @@
+#pragma once
+
+#include "libpldm/requester/pldm.h"
+
+#include "common/flight_recorder.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace pldm
+{
+namespace metrics
+{
+
+/** @brief Number of buckets of the latency histograms, bucket i counts the
+ *         latencies less than 2^i microseconds, the last one the rest
+ */
+constexpr size_t histogramBuckets = 24;
+
+/** @struct Histogram
+ *
+ *  Latency histogram with power of two buckets in microseconds
+ */
+struct Histogram
+{
+    std::array<uint64_t, histogramBuckets> buckets{};
+    uint64_t count = 0;
+    uint64_t sumUs = 0;
+    uint64_t maxUs = 0;
+
+    void add(std::chrono::microseconds latency)
+    {
+        auto us = static_cast<uint64_t>(std::max<int64_t>(latency.count(), 0));
+        auto bucket =
+            std::min<size_t>(std::bit_width(us), histogramBuckets - 1);
+        ++buckets[bucket];
+        ++count;
+        sumUs += us;
+        maxUs = std::max(maxUs, us);
+    }
+
+    nlohmann::ordered_json toJson() const
+    {
+        nlohmann::ordered_json json;
+        json["Count"] = count;
+        json["MeanUs"] = count ? sumUs / count : 0;
+        json["MaxUs"] = maxUs;
+        auto& histogram = json["Histogram"] = nlohmann::ordered_json::object();
+        for (size_t i = 0; i < histogramBuckets; ++i)
+        {
+            if (buckets[i])
+            {
+                auto bound =
+                    i + 1 < histogramBuckets
+                        ? "<" + std::to_string(uint64_t(1) << i)
+                        : ">=" + std::to_string(uint64_t(1) << (i - 1));
+                histogram[bound] = buckets[i];
+            }
+        }
+        return json;
+    }
+};
+
+/** @struct ResponderMetrics
+ *
+ *  Metrics of the requests pldmd handled for a PLDM command
+ */
+struct ResponderMetrics
+{
+    uint64_t requests = 0;
+    std::map<uint8_t, uint64_t> completionCodes;
+    Histogram latency; //!< time spent in the command handler
+};
+
+/** @struct RequesterMetrics
+ *
+ *  Metrics of the requests pldmd sent for a PLDM command
+ */
+struct RequesterMetrics
+{
+    uint64_t requests = 0;
+    uint64_t responses = 0;
+    uint64_t retries = 0;
+    uint64_t timeouts = 0; //!< requests whose instance ID expired
+    Histogram rtt;         //!< time from the first send to the response
+};
+
+/** @struct QueueMetrics
+ *
+ *  Depth of the queue of the requests waiting to be sent to an endpoint
+ */
+struct QueueMetrics
+{
+    size_t depth = 0;
+    size_t maxDepth = 0;
+};
+
+/** @class Metrics
+ *
+ *  Registry of the counters and latency histograms of pldmd, updated from
+ *  the event loop and published on D-Bus
+ */
+class Metrics
+{
+  private:
+    Metrics() = default;
+
+    /** @brief Key of the per command metrics, PLDM type and PLDM command */
+    static uint16_t key(uint8_t type, uint8_t command)
+    {
+        return static_cast<uint16_t>(type << 8 | command);
+    }
+
+    std::map<uint16_t, ResponderMetrics> responder;
+    std::map<uint16_t, RequesterMetrics> requester;
+    std::map<mctp_eid_t, QueueMetrics> queues;
+
+  public:
+    Metrics(const Metrics&) = delete;
+    Metrics(Metrics&&) = delete;
+    Metrics& operator=(const Metrics&) = delete;
+    Metrics& operator=(Metrics&&) = delete;
+    ~Metrics() = default;
+
+    static Metrics& GetInstance()
+    {
+        static Metrics metrics;
+        return metrics;
+    }
+
+    /** @brief Account for a request handled by pldmd
+     *
+     *  @param[in] type - PLDM type
+     *  @param[in] command - PLDM command
+     *  @param[in] completionCode - completion code of the response
+     *  @param[in] latency - time spent in the command handler
+     */
+    void handled(uint8_t type, uint8_t command, uint8_t completionCode,
+                 std::chrono::microseconds latency)
+    {
+        auto& metrics = responder[key(type, command)];
+        ++metrics.requests;
+        ++metrics.completionCodes[completionCode];
+        metrics.latency.add(latency);
+    }
+
+    /** @brief Account for a request sent by pldmd
+     *
+     *  @param[in] type - PLDM type
+     *  @param[in] command - PLDM command
+     */
+    void sent(uint8_t type, uint8_t command)
+    {
+        ++requester[key(type, command)].requests;
+    }
+
+    /** @brief Account for a response to a request sent by pldmd
+     *
+     *  @param[in] type - PLDM type
+     *  @param[in] command - PLDM command
+     *  @param[in] retries - number of times the request was sent again
+     *  @param[in] rtt - time from the first send to the response
+     */
+    void responded(uint8_t type, uint8_t command, uint8_t retries,
+                   std::chrono::microseconds rtt)
+    {
+        auto& metrics = requester[key(type, command)];
+        ++metrics.responses;
+        metrics.retries += retries;
+        metrics.rtt.add(rtt);
+    }
+
+    /** @brief Account for a request sent by pldmd that got no response
+     *
+     *  @param[in] type - PLDM type
+     *  @param[in] command - PLDM command
+     *  @param[in] retries - number of times the request was sent again
+     */
+    void timedOut(uint8_t type, uint8_t command, uint8_t retries)
+    {
+        auto& metrics = requester[key(type, command)];
+        ++metrics.timeouts;
+        metrics.retries += retries;
+    }
+
+    /** @brief Update the depth of the request queue of an endpoint
+     *
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     *  @param[in] depth - number of requests waiting to be sent
+     */
+    void queueDepth(mctp_eid_t eid, size_t depth)
+    {
+        auto& metrics = queues[eid];
+        metrics.depth = depth;
+        metrics.maxDepth = std::max(metrics.maxDepth, depth);
+    }
+
+    /** @brief Clear the metrics */
+    void reset()
+    {
+        responder.clear();
+        requester.clear();
+        queues.clear();
+    }
+
+    /** @brief Get the metrics as JSON */
+    nlohmann::ordered_json toJson() const
+    {
+        auto command = [](uint16_t key) {
+            nlohmann::ordered_json json;
+            uint8_t type = key >> 8;
+            uint8_t cmd = key & 0xFF;
+            json["Type"] = type;
+            json["Command"] = cmd;
+            auto name = pldm::flightrecorder::commandName(type, cmd);
+            json["Name"] = name ? name : "";
+            return json;
+        };
+
+        nlohmann::ordered_json json;
+        auto& responderJson = json["Responder"] =
+            nlohmann::ordered_json::array();
+        for (const auto& [key, metrics] : responder)
+        {
+            auto entry = command(key);
+            entry["Requests"] = metrics.requests;
+            auto& codes = entry["CompletionCodes"] =
+                nlohmann::ordered_json::object();
+            for (const auto& [cc, count] : metrics.completionCodes)
+            {
+                codes[std::to_string(cc)] = count;
+            }
+            entry["Latency"] = metrics.latency.toJson();
+            responderJson.push_back(std::move(entry));
+        }
+
+        auto& requesterJson = json["Requester"] =
+            nlohmann::ordered_json::array();
+        for (const auto& [key, metrics] : requester)
+        {
+            auto entry = command(key);
+            entry["Requests"] = metrics.requests;
+            entry["Responses"] = metrics.responses;
+            entry["Retries"] = metrics.retries;
+            entry["Timeouts"] = metrics.timeouts;
+            entry["RoundTripTime"] = metrics.rtt.toJson();
+            requesterJson.push_back(std::move(entry));
+        }
+
+        auto& queuesJson = json["Queues"] = nlohmann::ordered_json::array();
+        for (const auto& [eid, metrics] : queues)
+        {
+            nlohmann::ordered_json entry;
+            entry["EID"] = eid;
+            entry["Depth"] = metrics.depth;
+            entry["MaxDepth"] = metrics.maxDepth;
+            queuesJson.push_back(std::move(entry));
+        }
+        return json;
+    }
+};
+
+} // namespace metrics
+} // namespace pldm
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace pldm
+{
+namespace utils
+{
+
+/** @class ServiceCache
+ *
+ *  Service names resolved by DBusHandler::getService(), by object path and
+ *  interface, along with the number of lookups answered from the cache and
+ *  missed. The signals invalidating the entries and the lookups are all
+ *  processed on the event loop of pldmd, so it is not locked.
+ */
+class ServiceCache
+{
+  public:
+    /** @brief Look the service of an object path and interface up, counting
+     *         the lookup as a hit or a miss
+     *
+     *  @param[in] path - D-Bus object path
+     *  @param[in] interface - D-Bus interface, empty for any
+     *
+     *  @return the service name, std::nullopt if it is not cached
+     */
+    std::optional<std::string> find(const std::string& path,
+                                     const std::string& interface)
+    {
+        auto it = services.find({path, interface});
+        if (it == services.end())
+        {
+            ++misses;
+            return std::nullopt;
+        }
+        ++hits;
+        return it->second;
+    }
+
+    /** @brief Cache the service of an object path and interface
+     *
+     *  @param[in] path - D-Bus object path
+     *  @param[in] interface - D-Bus interface, empty for any
+     *  @param[in] service - service name
+     */
+    void insert(const std::string& path, const std::string& interface,
+                const std::string& service)
+    {
+        services.insert_or_assign({path, interface}, service);
+    }
+
+    /** @brief Drop the services of an object path */
+    void evictPath(const std::string& path)
+    {
+        auto it = services.lower_bound({path, ""});
+        while (it != services.end() && it->first.first == path)
+        {
+            it = services.erase(it);
+        }
+    }
+
+    /** @brief Drop the paths a service was resolved for */
+    void evictService(const std::string& service)
+    {
+        std::erase_if(services, [&service](const auto& entry) {
+            return entry.second == service;
+        });
+    }
+
+    /** @brief Get the number of entries cached */
+    size_t size() const
+    {
+        return services.size();
+    }
+
+    /** @brief Get the number of lookups answered from the cache and the
+     *         number of them missed
+     */
+    std::pair<uint64_t, uint64_t> stats() const
+    {
+        return {hits, misses};
+    }
+
+  private:
+    std::map<std::pair<std::string, std::string>, std::string> services;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+};
+
+} // namespace utils
+} // namespace pldm
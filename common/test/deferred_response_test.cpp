@@ -0,0 +1,101 @@
+#include "common/deferred_response.hpp"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::deferred;
+using namespace pldm::txbatch;
+
+class DeferredResponseTest : public testing::Test
+{
+  protected:
+    DeferredResponseTest()
+    {
+        // Stands for the connection to the MCTP demux daemon
+        EXPECT_EQ(socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds), 0);
+        hdr.msg_type = PLDM_REQUEST;
+        hdr.instance = 5;
+        hdr.pldm_type = PLDM_BASE;
+        hdr.command = PLDM_GET_TID;
+    }
+
+    ~DeferredResponseTest()
+    {
+        close(fds[0]);
+        close(fds[1]);
+    }
+
+    /** @brief Read a message sent to the MCTP demux daemon
+     *
+     *  @return the message, with the EID and message type bytes
+     */
+    std::vector<uint8_t> receive()
+    {
+        std::vector<uint8_t> buffer(256);
+        auto len = recv(fds[1], buffer.data(), buffer.size(), MSG_DONTWAIT);
+        buffer.resize(len > 0 ? len : 0);
+        return buffer;
+    }
+
+    int fds[2]{};
+    pldm_header_info hdr{};
+};
+
+TEST_F(DeferredResponseTest, noRequestBeingHandled)
+{
+    auto& deferredResponse = DeferredResponse::GetInstance();
+    EXPECT_FALSE(deferredResponse.defer().has_value());
+    EXPECT_FALSE(deferredResponse.end());
+}
+
+TEST_F(DeferredResponseTest, responseNotDeferred)
+{
+    auto& deferredResponse = DeferredResponse::GetInstance();
+    deferredResponse.begin(fds[0], 9, hdr);
+    EXPECT_FALSE(deferredResponse.end());
+    EXPECT_FALSE(deferredResponse.defer().has_value());
+}
+
+TEST_F(DeferredResponseTest, responseSentLater)
+{
+    auto& deferredResponse = DeferredResponse::GetInstance();
+    deferredResponse.begin(fds[0], 9, hdr);
+    auto responder = deferredResponse.defer();
+    ASSERT_TRUE(responder.has_value());
+    EXPECT_EQ(responder->instanceId(), 5);
+    EXPECT_TRUE(deferredResponse.end());
+    EXPECT_TRUE(receive().empty());
+
+    // The next request does not inherit the deferral
+    deferredResponse.begin(fds[0], 9, hdr);
+    EXPECT_FALSE(deferredResponse.end());
+
+    EXPECT_EQ(responder->send({0x05, 0x00, 0x02, PLDM_SUCCESS, 0x01}),
+              PLDM_SUCCESS);
+    std::vector<uint8_t> expected{9,    mctpMsgTypePldm, 0x05, 0x00, 0x02,
+                                  0x00, 0x01};
+    EXPECT_EQ(receive(), expected);
+}
+
+TEST_F(DeferredResponseTest, responseSentWithBatch)
+{
+    auto& deferredResponse = DeferredResponse::GetInstance();
+    deferredResponse.begin(fds[0], 9, hdr);
+    auto responder = deferredResponse.defer();
+    ASSERT_TRUE(responder.has_value());
+    EXPECT_TRUE(deferredResponse.end());
+
+    // The D-Bus reply is processed while the daemon handles other messages
+    auto& txBatch = TxBatch::GetInstance();
+    txBatch.open(fds[0]);
+    EXPECT_EQ(responder->send({0x05, 0x00, 0x02, PLDM_ERROR}), PLDM_SUCCESS);
+    EXPECT_EQ(txBatch.size(), 1);
+    EXPECT_TRUE(receive().empty());
+    EXPECT_EQ(txBatch.flush(), 1);
+
+    std::vector<uint8_t> expected{9, mctpMsgTypePldm, 0x05, 0x00, 0x02,
+                                  PLDM_ERROR};
+    EXPECT_EQ(receive(), expected);
+}
@@ -0,0 +1,79 @@
+#include "libpldm/base.h"
+#include "libpldm/platform.h"
+
+#include "common/flight_recorder.hpp"
+
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::flightrecorder;
+
+TEST(FlightRecorder, ringKeepsNewestRecords)
+{
+    constexpr size_t numRecords = 4;
+    std::vector<uint8_t> memory(recorderSize(numRecords));
+    initRecorder(memory.data(), numRecords);
+
+    // Six GetPDR requests, the two oldest are overwritten
+    for (uint8_t i = 0; i < 6; ++i)
+    {
+        std::vector<uint8_t> msg(sizeof(pldm_msg_hdr) + PLDM_GET_PDR_REQ_BYTES);
+        auto request = reinterpret_cast<pldm_msg*>(msg.data());
+        ASSERT_EQ(encode_get_pdr_req(i, i, 0, PLDM_GET_FIRSTPART, 0xffff, 0,
+                                     request, PLDM_GET_PDR_REQ_BYTES),
+                  PLDM_SUCCESS);
+        writeRecord(memory.data(), 9, msg.data(), msg.size(), true);
+    }
+
+    std::ostringstream out;
+    EXPECT_EQ(decodeRecorder(out, memory.data(), memory.size()),
+              static_cast<int>(numRecords));
+    auto text = out.str();
+    EXPECT_EQ(text.find("InstanceId=1 "), std::string::npos);
+    auto first = text.find("InstanceId=2 ");
+    auto last = text.find("InstanceId=5 ");
+    ASSERT_NE(first, std::string::npos);
+    ASSERT_NE(last, std::string::npos);
+    EXPECT_LT(first, last);
+    EXPECT_NE(text.find("Tx EID=9 Request GetPDR"), std::string::npos);
+}
+
+TEST(FlightRecorder, longMessageTruncated)
+{
+    std::vector<uint8_t> memory(recorderSize(1));
+    initRecorder(memory.data(), 1);
+
+    std::vector<uint8_t> msg(recordDataSize + 10);
+    writeRecord(memory.data(), 8, msg.data(), msg.size(), false);
+
+    std::ostringstream out;
+    EXPECT_EQ(decodeRecorder(out, memory.data(), memory.size()), 1);
+    EXPECT_NE(out.str().find("Rx EID=8 Response"), std::string::npos);
+    EXPECT_NE(out.str().find("(" + std::to_string(msg.size()) + " bytes)"),
+              std::string::npos);
+}
+
+TEST(FlightRecorder, reopenedRingKept)
+{
+    std::vector<uint8_t> memory(recorderSize(2));
+    initRecorder(memory.data(), 2);
+    std::vector<uint8_t> msg(sizeof(pldm_msg_hdr));
+    writeRecord(memory.data(), 8, msg.data(), msg.size(), false);
+
+    // As after a restart of pldmd with the recorder file in place
+    initRecorder(memory.data(), 2);
+    std::ostringstream out;
+    EXPECT_EQ(decodeRecorder(out, memory.data(), memory.size()), 1);
+
+    // A ring of another geometry is reset
+    initRecorder(memory.data(), 1);
+    EXPECT_EQ(decodeRecorder(out, memory.data(), memory.size()), 0);
+}
+
+TEST(FlightRecorder, notARecorder)
+{
+    std::vector<uint8_t> memory(recorderSize(2));
+    std::ostringstream out;
+    EXPECT_EQ(decodeRecorder(out, memory.data(), memory.size()), -1);
+}
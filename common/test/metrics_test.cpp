@@ -0,0 +1,71 @@
+#include "libpldm/base.h"
+#include "libpldm/platform.h"
+
+#include "common/metrics.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace pldm::metrics;
+using namespace std::chrono;
+
+TEST(Histogram, powerOfTwoBuckets)
+{
+    Histogram histogram;
+    histogram.add(microseconds(0));
+    histogram.add(microseconds(1));
+    histogram.add(microseconds(5));
+    histogram.add(microseconds(7));
+    histogram.add(seconds(100));
+
+    EXPECT_EQ(histogram.buckets[0], 1u);
+    EXPECT_EQ(histogram.buckets[1], 1u);
+    EXPECT_EQ(histogram.buckets[3], 2u);
+    EXPECT_EQ(histogram.buckets[histogramBuckets - 1], 1u);
+    EXPECT_EQ(histogram.count, 5u);
+    EXPECT_EQ(histogram.maxUs, 100000000u);
+
+    auto json = histogram.toJson();
+    EXPECT_EQ(json["Histogram"]["<8"], 2);
+    EXPECT_EQ(json["Histogram"][">=4194304"], 1);
+}
+
+TEST(Metrics, perCommandCounters)
+{
+    auto& metrics = Metrics::GetInstance();
+    metrics.reset();
+
+    metrics.handled(PLDM_PLATFORM, PLDM_GET_PDR, PLDM_SUCCESS,
+                    microseconds(40));
+    metrics.handled(PLDM_PLATFORM, PLDM_GET_PDR, PLDM_ERROR_INVALID_DATA,
+                    microseconds(20));
+    metrics.sent(PLDM_BASE, PLDM_GET_TID);
+    metrics.sent(PLDM_BASE, PLDM_GET_TID);
+    metrics.responded(PLDM_BASE, PLDM_GET_TID, 1, milliseconds(3));
+    metrics.timedOut(PLDM_BASE, PLDM_GET_TID, 2);
+    metrics.queueDepth(9, 4);
+    metrics.queueDepth(9, 1);
+
+    auto json = metrics.toJson();
+    ASSERT_EQ(json["Responder"].size(), 1u);
+    auto& responder = json["Responder"][0];
+    EXPECT_EQ(responder["Name"], "GetPDR");
+    EXPECT_EQ(responder["Requests"], 2);
+    EXPECT_EQ(responder["CompletionCodes"]["0"], 1);
+    EXPECT_EQ(responder["CompletionCodes"]["2"], 1);
+    EXPECT_EQ(responder["Latency"]["MeanUs"], 30);
+
+    ASSERT_EQ(json["Requester"].size(), 1u);
+    auto& requester = json["Requester"][0];
+    EXPECT_EQ(requester["Name"], "GetTID");
+    EXPECT_EQ(requester["Requests"], 2);
+    EXPECT_EQ(requester["Responses"], 1);
+    EXPECT_EQ(requester["Retries"], 3);
+    EXPECT_EQ(requester["Timeouts"], 1);
+
+    ASSERT_EQ(json["Queues"].size(), 1u);
+    EXPECT_EQ(json["Queues"][0]["Depth"], 1);
+    EXPECT_EQ(json["Queues"][0]["MaxDepth"], 4);
+
+    metrics.reset();
+    EXPECT_TRUE(metrics.toJson()["Responder"].empty());
+}
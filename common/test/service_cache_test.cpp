@@ -0,0 +1,67 @@
+#include "common/service_cache.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace pldm::utils;
+
+constexpr auto sensorPath = "/xyz/openbmc_project/sensors/temperature/cpu0";
+constexpr auto chassisPath = "/xyz/openbmc_project/inventory/system/chassis";
+constexpr auto valueIntf = "xyz.openbmc_project.Sensor.Value";
+constexpr auto itemIntf = "xyz.openbmc_project.Inventory.Item";
+constexpr auto sensorService = "xyz.openbmc_project.HwmonTempSensor";
+constexpr auto inventoryService = "xyz.openbmc_project.Inventory.Manager";
+
+TEST(ServiceCache, hitsAndMisses)
+{
+    ServiceCache cache;
+    EXPECT_EQ(cache.find(sensorPath, valueIntf), std::nullopt);
+
+    cache.insert(sensorPath, valueIntf, sensorService);
+    EXPECT_EQ(cache.find(sensorPath, valueIntf), sensorService);
+    EXPECT_EQ(cache.find(sensorPath, valueIntf), sensorService);
+
+    // The interface is part of the key
+    EXPECT_EQ(cache.find(sensorPath, ""), std::nullopt);
+    EXPECT_EQ(cache.stats(), std::make_pair(uint64_t{2}, uint64_t{2}));
+}
+
+TEST(ServiceCache, evictPath)
+{
+    ServiceCache cache;
+    cache.insert(sensorPath, valueIntf, sensorService);
+    cache.insert(sensorPath, "", sensorService);
+    cache.insert(chassisPath, itemIntf, inventoryService);
+    // A path sorting right after the one evicted
+    cache.insert(std::string(sensorPath) + "_vr", valueIntf, sensorService);
+
+    cache.evictPath(sensorPath);
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_EQ(cache.find(sensorPath, valueIntf), std::nullopt);
+    EXPECT_EQ(cache.find(sensorPath, ""), std::nullopt);
+    EXPECT_EQ(cache.find(chassisPath, itemIntf), inventoryService);
+    EXPECT_EQ(cache.find(std::string(sensorPath) + "_vr", valueIntf),
+              sensorService);
+
+    // Evicting a path not cached does nothing
+    cache.evictPath("/xyz/openbmc_project/sensors");
+    EXPECT_EQ(cache.size(), 2);
+}
+
+TEST(ServiceCache, evictService)
+{
+    ServiceCache cache;
+    cache.insert(sensorPath, valueIntf, sensorService);
+    cache.insert(std::string(sensorPath) + "_vr", valueIntf, sensorService);
+    cache.insert(chassisPath, itemIntf, inventoryService);
+
+    // The service restarted, it may not serve the same paths
+    cache.evictService(sensorService);
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_EQ(cache.find(sensorPath, valueIntf), std::nullopt);
+    EXPECT_EQ(cache.find(chassisPath, itemIntf), inventoryService);
+
+    // A lookup missed is resolved and cached again
+    cache.insert(sensorPath, valueIntf, sensorService);
+    EXPECT_EQ(cache.find(sensorPath, valueIntf), sensorService);
+    EXPECT_EQ(cache.stats(), std::make_pair(uint64_t{2}, uint64_t{1}));
+}
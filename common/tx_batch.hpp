@@ -0,0 +1,152 @@
+#pragma once
+
+#include "libpldm/requester/pldm.h"
+
+#include <sys/socket.h>
+
+#include <array>
+#include <cerrno>
+#include <iostream>
+#include <vector>
+
+namespace pldm
+{
+namespace txbatch
+{
+
+/** @brief MCTP message type of the PLDM messages */
+constexpr uint8_t mctpMsgTypePldm = 1;
+
+/** @class TxBatch
+ *
+ *  The class for batching the PLDM messages sent on the MCTP socket. While a
+ *  batch is open, the responses and requests are queued instead of being sent
+ *  one sendmsg at a time, and flush() sends them all with sendmmsg.
+ */
+class TxBatch
+{
+  private:
+    TxBatch() = default;
+
+  protected:
+    /** @brief fd of the socket the batch is open on, -1 if not open */
+    int fd = -1;
+
+    /** @brief MCTP header, that is the EID and the message type, of the queued
+     *         messages
+     */
+    std::vector<std::array<uint8_t, 2>> headers;
+
+    /** @brief The queued PLDM messages */
+    std::vector<std::vector<uint8_t>> messages;
+
+    /** @brief Scatter/gather arrays for sendmmsg, kept to reuse their storage
+     */
+    std::vector<struct iovec> iovs;
+    std::vector<struct mmsghdr> msgs;
+
+  public:
+    TxBatch(const TxBatch&) = delete;
+    TxBatch(TxBatch&&) = delete;
+    TxBatch& operator=(const TxBatch&) = delete;
+    TxBatch& operator=(TxBatch&&) = delete;
+    ~TxBatch() = default;
+
+    static TxBatch& GetInstance()
+    {
+        static TxBatch txBatch;
+        return txBatch;
+    }
+
+    /** @brief Start queueing the messages sent on a socket
+     *
+     *  @param[in] socketFd - fd of the MCTP communications socket
+     */
+    void open(int socketFd)
+    {
+        fd = socketFd;
+    }
+
+    /** @brief Check if the messages sent on a socket are to be queued
+     *
+     *  @param[in] socketFd - fd of the MCTP communications socket
+     *
+     *  @return true if a batch is open on the socket
+     */
+    bool isOpen(int socketFd) const
+    {
+        return fd >= 0 && fd == socketFd;
+    }
+
+    /** @brief Queue a PLDM message
+     *
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     *  @param[in] message - PLDM message
+     */
+    void add(mctp_eid_t eid, std::vector<uint8_t>&& message)
+    {
+        headers.push_back({eid, mctpMsgTypePldm});
+        messages.emplace_back(std::move(message));
+    }
+
+    /** @brief Number of messages queued */
+    size_t size() const
+    {
+        return messages.size();
+    }
+
+    /** @brief Send the queued messages and close the batch
+     *
+     *  @return number of messages sent, -errno if sending failed before any
+     *          message was sent
+     */
+    int flush()
+    {
+        auto socketFd = fd;
+        fd = -1;
+        if (messages.empty())
+        {
+            return 0;
+        }
+
+        iovs.resize(2 * messages.size());
+        msgs.resize(messages.size());
+        for (size_t i = 0; i < messages.size(); ++i)
+        {
+            iovs[2 * i].iov_base = headers[i].data();
+            iovs[2 * i].iov_len = headers[i].size();
+            iovs[2 * i + 1].iov_base = messages[i].data();
+            iovs[2 * i + 1].iov_len = messages[i].size();
+            msgs[i] = {};
+            msgs[i].msg_hdr.msg_iov = &iovs[2 * i];
+            msgs[i].msg_hdr.msg_iovlen = 2;
+        }
+
+        int sent = 0;
+        int rc = 0;
+        while (static_cast<size_t>(sent) < msgs.size())
+        {
+            rc = sendmmsg(socketFd, &msgs[sent], msgs.size() - sent, 0);
+            if (rc == -1)
+            {
+                rc = -errno;
+                std::cerr << "sendmmsg system call failed, RC= " << rc
+                          << ", messages dropped= " << msgs.size() - sent
+                          << "\n";
+                break;
+            }
+            if (rc == 0)
+            {
+                break;
+            }
+            sent += rc;
+        }
+
+        headers.clear();
+        messages.clear();
+        return sent ? sent : rc;
+    }
+};
+
+} // namespace txbatch
+} // namespace pldm
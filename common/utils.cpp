@@ -5,8 +5,11 @@
 #include "libpldm/pdr.h"
 #include "libpldm/pldm_types.h"
 
+#include "service_cache.hpp"
+
 #include <sys/time.h>
 
+#include <sdbusplus/bus/match.hpp>
 #include <xyz/openbmc_project/Common/error.hpp>
 
 #include <algorithm>
@@ -16,8 +19,10 @@
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <stdexcept>
 #include <string>
+#include <system_error>
 #include <vector>
 
 namespace pldm
@@ -217,9 +222,85 @@ std::optional<std::vector<set_effecter_state_field>>
     return std::make_optional(std::move(stateField));
 }
 
+namespace
+{
+
+/** @struct ServiceCacheState
+ *
+ *  The service name cache of DBusHandler::getService() and the matches
+ *  invalidating it, once it is enabled.
+ */
+struct ServiceCacheState
+{
+    bool enabled = false;
+    ServiceCache cache;
+    std::vector<std::unique_ptr<sdbusplus::bus::match::match>> matches;
+};
+
+ServiceCacheState& serviceCache()
+{
+    static ServiceCacheState state;
+    return state;
+}
+
+} // namespace
+
+void DBusHandler::enableServiceCache()
+{
+    using namespace sdbusplus::bus::match::rules;
+    auto& state = serviceCache();
+    if (state.enabled)
+    {
+        return;
+    }
+
+    auto& bus = DBusHandler::getBus();
+    state.matches.emplace_back(std::make_unique<sdbusplus::bus::match::match>(
+        bus, nameOwnerChanged(), [](sdbusplus::message::message& msg) {
+            std::string name;
+            std::string oldOwner;
+            std::string newOwner;
+            msg.read(name, oldOwner, newOwner);
+            // Unique names come and go with every client, the mapper resolves
+            // well-known names
+            if (!name.starts_with(':'))
+            {
+                serviceCache().cache.evictService(name);
+            }
+        }));
+    state.matches.emplace_back(std::make_unique<sdbusplus::bus::match::match>(
+        bus, interfacesAdded(), [](sdbusplus::message::message& msg) {
+            sdbusplus::message::object_path path;
+            msg.read(path);
+            serviceCache().cache.evictPath(path.str);
+        }));
+    state.matches.emplace_back(std::make_unique<sdbusplus::bus::match::match>(
+        bus, interfacesRemoved(), [](sdbusplus::message::message& msg) {
+            sdbusplus::message::object_path path;
+            msg.read(path);
+            serviceCache().cache.evictPath(path.str);
+        }));
+    state.enabled = true;
+}
+
+std::pair<uint64_t, uint64_t> DBusHandler::getServiceCacheStats()
+{
+    return serviceCache().cache.stats();
+}
+
 std::string DBusHandler::getService(const char* path,
                                     const char* interface) const
 {
+    auto& state = serviceCache();
+    if (state.enabled)
+    {
+        auto service = state.cache.find(path, interface ? interface : "");
+        if (service)
+        {
+            return *service;
+        }
+    }
+
     using DbusInterfaceList = std::vector<std::string>;
     std::map<std::string, std::vector<std::string>> mapperResponse;
     auto& bus = DBusHandler::getBus();
@@ -238,6 +319,11 @@ std::string DBusHandler::getService(const char* path,
 
     auto mapperResponseMsg = bus.call(mapper);
     mapperResponseMsg.read(mapperResponse);
+    if (state.enabled && !mapperResponse.empty())
+    {
+        state.cache.insert(path, interface ? interface : "",
+                           mapperResponse.begin()->first);
+    }
     return mapperResponse.begin()->first;
 }
 
@@ -288,10 +374,12 @@ void reportError(const char* errorMsg, const Severity& sev)
     }
 }
 
-void DBusHandler::setDbusProperty(const DBusMapping& dBusMap,
-                                  const PropertyValue& value) const
+sdbusplus::message::message
+    DBusHandler::newSetDbusPropertyCall(const DBusMapping& dBusMap,
+                                        const PropertyValue& value) const
 {
-    auto setDbusValue = [&dBusMap, this](const auto& variant) {
+    auto setDbusValue =
+        [&dBusMap, this](const auto& variant) -> sdbusplus::message::message {
         auto& bus = getBus();
         auto service =
             getService(dBusMap.objectPath.c_str(), dBusMap.interface.c_str());
@@ -313,7 +401,7 @@ void DBusHandler::setDbusProperty(const DBusMapping& dBusMap,
                 service.c_str(), "/xyz/openbmc_project/inventory",
                 "xyz.openbmc_project.Inventory.Manager", "Notify");
             method.append(std::move(objectValueTree));
-            bus.call_noreply(method);
+            return method;
         }
         else
         {
@@ -332,14 +420,14 @@ void DBusHandler::setDbusProperty(const DBusMapping& dBusMap,
             }
             method.append(dBusMap.interface.c_str(),
                           dBusMap.propertyName.c_str(), variant);
-            bus.call_noreply(method);
+            return method;
         }
     };
 
     if (dBusMap.propertyType == "uint8_t")
     {
         std::variant<uint8_t> v = std::get<uint8_t>(value);
-        setDbusValue(v);
+        return setDbusValue(v);
     }
     else if (dBusMap.propertyType == "bool")
     {
@@ -351,47 +439,47 @@ void DBusHandler::setDbusProperty(const DBusMapping& dBusMap,
         {
             std::cout << " value : " << std::get<bool>(value);
         }
-        setDbusValue(v);
+        return setDbusValue(v);
     }
     else if (dBusMap.propertyType == "int16_t")
     {
         std::variant<int16_t> v = std::get<int16_t>(value);
-        setDbusValue(v);
+        return setDbusValue(v);
     }
     else if (dBusMap.propertyType == "uint16_t")
     {
         std::variant<uint16_t> v = std::get<uint16_t>(value);
-        setDbusValue(v);
+        return setDbusValue(v);
     }
     else if (dBusMap.propertyType == "int32_t")
     {
         std::variant<int32_t> v = std::get<int32_t>(value);
-        setDbusValue(v);
+        return setDbusValue(v);
     }
     else if (dBusMap.propertyType == "uint32_t")
     {
         std::variant<uint32_t> v = std::get<uint32_t>(value);
-        setDbusValue(v);
+        return setDbusValue(v);
     }
     else if (dBusMap.propertyType == "int64_t")
     {
         std::variant<int64_t> v = std::get<int64_t>(value);
-        setDbusValue(v);
+        return setDbusValue(v);
     }
     else if (dBusMap.propertyType == "uint64_t")
     {
         std::variant<uint64_t> v = std::get<uint64_t>(value);
-        setDbusValue(v);
+        return setDbusValue(v);
     }
     else if (dBusMap.propertyType == "double")
     {
         std::variant<double> v = std::get<double>(value);
-        setDbusValue(v);
+        return setDbusValue(v);
     }
     else if (dBusMap.propertyType == "string")
     {
         std::variant<std::string> v = std::get<std::string>(value);
-        setDbusValue(v);
+        return setDbusValue(v);
     }
     else
     {
@@ -400,6 +488,24 @@ void DBusHandler::setDbusProperty(const DBusMapping& dBusMap,
     }
 }
 
+void DBusHandler::setDbusProperty(const DBusMapping& dBusMap,
+                                  const PropertyValue& value) const
+{
+    auto method = newSetDbusPropertyCall(dBusMap, value);
+    getBus().call_noreply(method);
+}
+
+void DBusHandler::setDbusPropertyAsync(
+    const DBusMapping& dBusMap, const PropertyValue& value,
+    std::function<void(bool)>&& callback) const
+{
+    auto method = newSetDbusPropertyCall(dBusMap, value);
+    callAsync(method, [callback = std::move(callback)](
+                          sdbusplus::message::message& reply) {
+        callback(!reply.is_method_error());
+    });
+}
+
 PropertyValue DBusHandler::getDbusPropertyVariant(
     const char* objPath, const char* dbusProp, const char* dbusInterface) const
 {
@@ -414,6 +520,129 @@ PropertyValue DBusHandler::getDbusPropertyVariant(
     return value;
 }
 
+void DBusHandler::getDbusPropertyVariantAsync(
+    const char* objPath, const char* dbusProp, const char* dbusInterface,
+    std::function<void(std::optional<PropertyValue>)>&& callback) const
+{
+    auto& bus = DBusHandler::getBus();
+    auto service = getService(objPath, dbusInterface);
+    auto method =
+        bus.new_method_call(service.c_str(), objPath, dbusProperties, "Get");
+    method.append(dbusInterface, dbusProp);
+    callAsync(method, [callback = std::move(callback)](
+                          sdbusplus::message::message& reply) {
+        if (reply.is_method_error())
+        {
+            callback(std::nullopt);
+            return;
+        }
+        try
+        {
+            PropertyValue value{};
+            reply.read(value);
+            callback(std::move(value));
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Failed to read the D-Bus property, ERROR="
+                      << e.what() << "\n";
+            callback(std::nullopt);
+        }
+    });
+}
+
+namespace
+{
+
+/** @brief sd-bus handler of the reply to a call made by callAsync() */
+int asyncCallReply(sd_bus_message* msg, void* userdata,
+                   sd_bus_error* /*error*/)
+{
+    std::unique_ptr<DBusHandler::AsyncCallback> callback(
+        static_cast<DBusHandler::AsyncCallback*>(userdata));
+    try
+    {
+        sdbusplus::message::message reply(msg);
+        (*callback)(reply);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Failed to handle a D-Bus reply, ERROR=" << e.what()
+                  << "\n";
+    }
+    return 0;
+}
+
+} // namespace
+
+void DBusHandler::callAsync(sdbusplus::message::message& method,
+                            AsyncCallback&& callback)
+{
+    auto userdata = std::make_unique<AsyncCallback>(std::move(callback));
+    // A floating slot, the callback frees the user data once the reply or
+    // the timeout error arrives
+    auto rc = sd_bus_call_async(getBus().get(), nullptr, method.get(),
+                                asyncCallReply, userdata.get(), 0);
+    if (rc < 0)
+    {
+        throw std::system_error(-rc, std::generic_category(),
+                                "sd_bus_call_async failed");
+    }
+    userdata.release();
+}
+
+namespace
+{
+
+using PropertiesToSet = std::vector<std::pair<DBusMapping, PropertyValue>>;
+
+/** @brief Set the properties from an index on, one after the other */
+void setPropertiesFrom(std::shared_ptr<const PropertiesToSet> properties,
+                       size_t index, std::function<void(bool)>&& callback)
+{
+    if (index == properties->size())
+    {
+        callback(true);
+        return;
+    }
+
+    const auto& [dBusMap, value] = (*properties)[index];
+    try
+    {
+        DBusHandler().setDbusPropertyAsync(
+            dBusMap, value, [properties, index, callback](bool set) mutable {
+                if (!set)
+                {
+                    const auto& dBusMap = (*properties)[index].first;
+                    std::cerr << "Error setting property, PROPERTY="
+                              << dBusMap.propertyName
+                              << " INTERFACE=" << dBusMap.interface
+                              << " PATH=" << dBusMap.objectPath << "\n";
+                    callback(false);
+                    return;
+                }
+                setPropertiesFrom(std::move(properties), index + 1,
+                                  std::move(callback));
+            });
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error setting property, ERROR=" << e.what()
+                  << " PROPERTY=" << dBusMap.propertyName
+                  << " INTERFACE=" << dBusMap.interface
+                  << " PATH=" << dBusMap.objectPath << "\n";
+        callback(false);
+    }
+}
+
+} // namespace
+
+void DBusPropertySetter::setAsync(std::function<void(bool)>&& callback) const
+{
+    setPropertiesFrom(std::make_shared<const PropertiesToSet>(properties), 0,
+                      std::move(callback));
+}
+
 ObjectValueTree DBusHandler::getManagedObj(const char* service,
                                            const char* rootPath)
 {
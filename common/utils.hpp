@@ -17,8 +17,11 @@
 
 #include <exception>
 #include <filesystem>
+#include <functional>
 #include <iostream>
+#include <optional>
 #include <string>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -206,6 +209,11 @@ class DBusHandlerInterface
 class DBusHandler : public DBusHandlerInterface
 {
   public:
+    /** @brief Callback of callAsync(), invoked with the method return or the
+     *         error reply
+     */
+    using AsyncCallback = std::function<void(sdbusplus::message::message&)>;
+
     /** @brief Get the bus connection. */
     static auto& getBus()
     {
@@ -226,6 +234,21 @@ class DBusHandler : public DBusHandlerInterface
     std::string getService(const char* path,
                            const char* interface) const override;
 
+    /** @brief Keep the service names resolved by getService() in a cache
+     *
+     *  The cache is invalidated by the NameOwnerChanged, InterfacesAdded and
+     *  InterfacesRemoved signals, so it must only be enabled by applications
+     *  processing the bus from their event loop.
+     */
+    static void enableServiceCache();
+
+    /** @brief Get the statistics of the service name cache
+     *
+     *  @return the number of getService() calls answered from the cache and
+     *          the number of them that queried the object mapper
+     */
+    static std::pair<uint64_t, uint64_t> getServiceCacheStats();
+
     MapperGetSubTreeResponse
         getSubtree(const char* path, int depth,
                    const std::vector<std::string>& ifacelist) const override;
@@ -279,6 +302,45 @@ class DBusHandler : public DBusHandlerInterface
     void setDbusProperty(const DBusMapping& dBusMap,
                          const PropertyValue& value) const override;
 
+    /** @brief Make a D-Bus method call without blocking, the reply is
+     *         processed by the event loop the bus is attached to
+     *
+     *  @param[in] method - method call to send
+     *  @param[in] callback - invoked with the reply
+     *
+     *  @throw std::system_error when the call cannot be sent
+     */
+    static void callAsync(sdbusplus::message::message& method,
+                          AsyncCallback&& callback);
+
+    /** @brief Get property(type: variant) from the requested dbus without
+     *         blocking
+     *
+     *  @param[in] objPath - The Dbus object path
+     *  @param[in] dbusProp - The property name to get
+     *  @param[in] dbusInterface - The Dbus interface
+     *  @param[in] callback - invoked with the value of the property, or
+     *                        std::nullopt when the call failed
+     *
+     *  @throw sdbusplus::exception::exception when the service lookup fails
+     */
+    void getDbusPropertyVariantAsync(
+        const char* objPath, const char* dbusProp, const char* dbusInterface,
+        std::function<void(std::optional<PropertyValue>)>&& callback) const;
+
+    /** @brief Set Dbus property without blocking
+     *
+     *  @param[in] dBusMap - Object path, property name, interface and property
+     *                       type for the D-Bus object
+     *  @param[in] value - The value to be set
+     *  @param[in] callback - invoked with true when the property was set
+     *
+     *  @throw sdbusplus::exception::exception when the service lookup fails
+     */
+    void setDbusPropertyAsync(const DBusMapping& dBusMap,
+                              const PropertyValue& value,
+                              std::function<void(bool)>&& callback) const;
+
     /** @brief This function will returns all the objectspaths under the service
      * root path, with their interfaces and the properties under those
      * interfaces     *
@@ -301,6 +363,60 @@ class DBusHandler : public DBusHandlerInterface
             getManagedObj(inventoryService, inventoryPath);
         return object;
     }
+
+  private:
+    /** @brief Create the method call setting a D-Bus property
+     *
+     *  @param[in] dBusMap - Object path, property name, interface and property
+     *                       type for the D-Bus object
+     *  @param[in] value - The value to be set
+     *
+     *  @return the method call
+     */
+    sdbusplus::message::message
+        newSetDbusPropertyCall(const DBusMapping& dBusMap,
+                               const PropertyValue& value) const;
+};
+
+/**
+ *  @class DBusPropertySetter
+ *
+ *  Stands in for DBusHandler in the handlers setting D-Bus properties, it
+ *  keeps the properties to set so that they are set afterwards without
+ *  blocking
+ */
+class DBusPropertySetter
+{
+  public:
+    /** @brief Keep a property to set
+     *
+     *  @param[in] dBusMap - Object path, property name, interface and property
+     *                       type for the D-Bus object
+     *  @param[in] value - The value to be set
+     */
+    void setDbusProperty(const DBusMapping& dBusMap,
+                         const PropertyValue& value) const
+    {
+        properties.emplace_back(dBusMap, value);
+    }
+
+    /** @brief Get the properties to set, in the order they were kept */
+    const std::vector<std::pair<DBusMapping, PropertyValue>>&
+        getProperties() const
+    {
+        return properties;
+    }
+
+    /** @brief Set the properties kept one after the other without blocking,
+     *         stopping at the first that fails to be set
+     *
+     *  @param[in] callback - invoked with true once all the properties are
+     *                        set, false if one failed
+     */
+    void setAsync(std::function<void(bool)>&& callback) const;
+
+  private:
+    mutable std::vector<std::pair<DBusMapping, PropertyValue>> properties;
 };
 
 /** @brief Fetch parent D-Bus object based on pathname
@@ -9,9 +9,14 @@
 #include <cereal/types/variant.hpp>
 #include <cereal/types/vector.hpp>
 
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <system_error>
 
 // Register class version with Cereal
 CEREAL_CLASS_VERSION(pldm::serialize::Serialize, 1)
@@ -23,6 +28,17 @@ namespace serialize
 
 namespace fs = std::filesystem;
 
+Serialize::Serialize(const fs::path& filePath) :
+    filePath(filePath),
+    flushTimer(
+        sdeventplus::Event::get_default(),
+        [this](sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>&) {
+            flush();
+        })
+{
+    deserialize();
+}
+
 void Serialize::serialize(const std::string& path, const std::string& intf,
                           const std::string& name, dbus::PropertyValue value)
 {
@@ -77,19 +93,77 @@ void Serialize::serialize(const std::string& path, const std::string& intf,
         return;
     }
 
-    auto dir = filePath.parent_path();
-    if (!fs::exists(dir))
+    markDirty();
+}
+
+void Serialize::markDirty()
+{
+    dirty = true;
+    if (!flushTimer.isEnabled())
+    {
+        flushTimer.restartOnce(flushDelay);
+    }
+}
+
+void Serialize::flush()
+{
+    if (!dirty)
     {
-        fs::create_directories(dir);
+        return;
     }
+    dirty = false;
+    flushTimer.setEnabled(false);
+
+    try
+    {
+        auto dir = filePath.parent_path();
+        if (!fs::exists(dir))
+        {
+            fs::create_directories(dir);
+        }
+
+        // Write to a temporary file and rename it over the persistent file,
+        // so that a crash mid-write never leaves a truncated cache behind
+        auto tmpFilePath = filePath;
+        tmpFilePath += ".tmp";
+        {
+            std::ofstream os(tmpFilePath.c_str(), std::ios::binary);
+            os.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+            cereal::BinaryOutputArchive oarchive(os);
+            oarchive(savedObjs);
+        }
 
-    std::ofstream os(filePath.c_str(), std::ios::binary);
-    cereal::BinaryOutputArchive oarchive(os);
-    oarchive(savedObjs);
+        // The data has to reach the disk before the rename does, or a power
+        // loss can leave an empty persistent file
+        auto fd = open(tmpFilePath.c_str(), O_RDONLY);
+        if (fd < 0 || fsync(fd) < 0)
+        {
+            auto rc = errno;
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+            throw std::system_error(rc, std::generic_category(),
+                                    "fsync failed");
+        }
+        close(fd);
+        fs::rename(tmpFilePath, filePath);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Failed to write the persistent cache, ERROR = "
+                  << e.what() << std::endl;
+    }
 }
 
 bool Serialize::deserialize()
 {
+    // A temporary file left behind by an interrupted flush is incomplete
+    auto tmpFilePath = filePath;
+    tmpFilePath += ".tmp";
+    std::error_code ec;
+    fs::remove(tmpFilePath, ec);
+
     if (!fs::exists(filePath))
     {
         std::cerr << "File does not exist, FILE_PATH = " << filePath
@@ -147,15 +221,7 @@ void Serialize::reSerialize(const std::vector<uint16_t> types)
         }
     }
 
-    auto dir = filePath.parent_path();
-    if (!fs::exists(dir))
-    {
-        fs::create_directories(dir);
-    }
-
-    std::ofstream os(filePath.c_str(), std::ios::binary);
-    cereal::BinaryOutputArchive oarchive(os);
-    oarchive(this->savedObjs);
+    markDirty();
 }
 
 } // namespace serialize
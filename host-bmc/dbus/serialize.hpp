@@ -7,6 +7,11 @@
 #include "license_entry.hpp"
 #include "type.hpp"
 
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/utility/timer.hpp>
+
+#include <chrono>
 #include <filesystem>
 #include <fstream>
 
@@ -25,17 +30,25 @@ using ObjectPathMaps = std::map<ObjectPath, pldm_entity_node*>;
 class Serialize
 {
   private:
-    Serialize()
-    {
-        deserialize();
-    }
+    Serialize() : Serialize(PERSISTENT_FILE)
+    {}
 
   public:
+    /** @brief Constructor
+     *
+     *  @param[in] filePath - persistent file, the saved objects are restored
+     *                        from it
+     */
+    explicit Serialize(const fs::path& filePath);
+
     Serialize(const Serialize&) = delete;
     Serialize(Serialize&&) = delete;
     Serialize& operator=(const Serialize&) = delete;
     Serialize& operator=(Serialize&&) = delete;
-    ~Serialize() = default;
+    ~Serialize()
+    {
+        flush();
+    }
 
     static Serialize& getSerialize()
     {
@@ -62,11 +75,33 @@ class Serialize
 
     void setEntityTypes(const std::set<uint16_t>& storeEntities);
 
+    /** @brief Write the saved objects to the persistent file now if there
+     *         are changes that have not been written yet
+     */
+    void flush();
+
   private:
+    /** @brief Mark the saved objects as changed and schedule a write of the
+     *         persistent file. All the changes made within flushDelay of the
+     *         first one are written together.
+     */
+    void markDirty();
+
+    /** @brief Delay before changes to the saved objects are written to the
+     *         persistent file
+     */
+    static constexpr auto flushDelay = std::chrono::milliseconds(200);
+
     dbus::SavedObjs savedObjs;
-    fs::path filePath{PERSISTENT_FILE};
+    fs::path filePath;
     std::set<uint16_t> storeEntityTypes;
     std::map<ObjectPath, pldm_entity> entityPathMaps;
+
+    /** @brief true if savedObjs has changes not written to filePath */
+    bool dirty = false;
+
+    /** @brief Timer to write the persistent file once flushDelay expires */
+    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> flushTimer;
 };
 
 } // namespace serialize
@@ -28,19 +28,19 @@ DbusToPLDMEvent::DbusToPLDMEvent(
 void DbusToPLDMEvent::sendEventMsg(uint8_t eventType,
                                    const std::vector<uint8_t>& eventDataVec)
 {
-    auto instanceId = requester.getInstanceId(mctp_eid);
     std::vector<uint8_t> requestMsg(sizeof(pldm_msg_hdr) +
                                     PLDM_PLATFORM_EVENT_MESSAGE_MIN_REQ_BYTES +
                                     eventDataVec.size());
     auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
 
+    // The instance ID is allocated by the handler when the event is sent, a
+    // burst of events is queued rather than running out of instance IDs
     auto rc = encode_platform_event_message_req(
-        instanceId, 1 /*formatVersion*/, 0 /*tId*/, eventType,
-        eventDataVec.data(), eventDataVec.size(), request,
+        0, 1 /*formatVersion*/, 0 /*tId*/, eventType, eventDataVec.data(),
+        eventDataVec.size(), request,
         eventDataVec.size() + PLDM_PLATFORM_EVENT_MESSAGE_MIN_REQ_BYTES);
     if (rc != PLDM_SUCCESS)
     {
-        requester.markFree(mctp_eid, instanceId);
         std::cerr << "Failed to encode_platform_event_message_req, rc = " << rc
                   << std::endl;
         return;
@@ -69,7 +69,7 @@ void DbusToPLDMEvent::sendEventMsg(uint8_t eventType,
     };
 
     rc = handler->registerRequest(
-        mctp_eid, instanceId, PLDM_PLATFORM, PLDM_PLATFORM_EVENT_MESSAGE,
+        mctp_eid, PLDM_PLATFORM, PLDM_PLATFORM_EVENT_MESSAGE,
         std::move(requestMsg), std::move(platformEventMessageResponseHandler));
     if (rc)
     {
@@ -174,31 +174,23 @@ void DbusToPLDMEvent::listenSensorEvent(const pdr_utils::Repo& repo,
              this->sendStateSensorEvent(sensorId, dbusMaps);
          }}};
 
-    pldm_state_sensor_pdr* pdr = nullptr;
-    std::unique_ptr<pldm_pdr, decltype(&pldm_pdr_destroy)> sensorPdrRepo(
-        pldm_pdr_init(), pldm_pdr_destroy);
-
     for (auto pdrType : pdrTypes)
     {
-        Repo sensorPDRs(sensorPdrRepo.get());
-        getRepoByType(repo, sensorPDRs, pdrType);
-        if (sensorPDRs.empty())
-        {
-            return;
-        }
-
-        PdrEntry pdrEntry{};
-        auto pdrRecord = sensorPDRs.getFirstRecord(pdrEntry);
+        uint8_t* pdrData = nullptr;
+        uint32_t pdrSize{};
+        auto pdrRecord = pldm_pdr_find_record_by_type(
+            repo.getPdr(), pdrType, NULL, &pdrData, &pdrSize);
         while (pdrRecord)
         {
-            pdr = reinterpret_cast<pldm_state_sensor_pdr*>(pdrEntry.data);
+            auto pdr = reinterpret_cast<pldm_state_sensor_pdr*>(pdrData);
             SensorId sensorId = LE16TOH(pdr->sensor_id);
             if (sensorHandlers.contains(pdrType))
             {
                 sensorHandlers.at(pdrType)(sensorId, dbusMaps);
             }
 
-            pdrRecord = sensorPDRs.getNextRecord(pdrRecord, pdrEntry);
+            pdrRecord = pldm_pdr_find_record_by_type(
+                repo.getPdr(), pdrType, pdrRecord, &pdrData, &pdrSize);
         }
     }
 }
@@ -252,22 +252,20 @@ int HostEffecterParser::sendSetStateEffecterStates(
     std::vector<set_effecter_state_field>& stateField,
     std::function<bool(bool)> callBack, bool value)
 {
-    auto instanceId = requester->getInstanceId(mctpEid);
-
     std::vector<uint8_t> requestMsg(
         sizeof(pldm_msg_hdr) + sizeof(effecterId) + sizeof(compEffCnt) +
             sizeof(set_effecter_state_field) * compEffCnt,
         0);
     auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    // The instance ID is allocated by the handler when the request is sent
     auto rc = encode_set_state_effecter_states_req(
-        instanceId, effecterId, compEffCnt, stateField.data(), request);
+        0, effecterId, compEffCnt, stateField.data(), request);
 
     if (rc != PLDM_SUCCESS)
     {
         std::cerr
             << "Message encode SetStateEffecterStates failure. PLDM error code = "
             << std::hex << std::showbase << rc << "\n";
-        requester->markFree(mctpEid, instanceId);
         return rc;
     }
 
@@ -309,7 +307,7 @@ int HostEffecterParser::sendSetStateEffecterStates(
         };
 
     rc = handler->registerRequest(
-        mctpEid, instanceId, PLDM_PLATFORM, PLDM_SET_STATE_EFFECTER_STATES,
+        mctpEid, PLDM_PLATFORM, PLDM_SET_STATE_EFFECTER_STATES,
         std::move(requestMsg), std::move(setStateEffecterStatesRespHandler));
     if (rc)
     {
@@ -5,6 +5,7 @@
 #include "libpldm/fru.h"
 #include "libpldm/requester/pldm.h"
 #include "libpldm/state_set.h"
+#include "libpldm/utils.h"
 #include "oem/ibm/libpldm/fru.h"
 
 #include "dbus/custom_dbus.hpp"
@@ -101,6 +102,17 @@ HostPDRHandler::HostPDRHandler(
     bmcEntityTree(bmcEntityTree), hostEffecterParser(hostEffecterParser),
     requester(requester), handler(handler),
     associationsParser(associationsParser),
+    pdrPrefetcher(
+        pdrFetchWindow,
+        [this](pldm::Request&& requestMsg,
+               pldm::requester::ResponseHandler&& responseHandler) {
+            return this->handler->registerRequest(
+                this->mctp_eid, PLDM_PLATFORM, PLDM_GET_PDR,
+                std::move(requestMsg), std::move(responseHandler));
+        },
+        [this](const pldm_msg* response, size_t respMsgLen) {
+            processHostPDRs(this->mctp_eid, response, respMsgLen);
+        }),
     oemPlatformHandler(oemPlatformHandler)
 {
     isHostOff = false;
@@ -292,6 +304,7 @@ std::string HostPDRHandler::getParentChassis(const std::string& frupath)
 
 void HostPDRHandler::fetchPDR(PDRRecordHandles&& recordHandles)
 {
+    resetPDRFetch();
     pdrRecordHandles.clear();
     modifiedPDRRecordHandles.clear();
     if (isHostPdrModified)
@@ -320,9 +333,6 @@ void HostPDRHandler::getHostPDR(uint32_t nextRecordHandle)
 {
     pdrFetchEvent.reset();
 
-    std::vector<uint8_t> requestMsg(sizeof(pldm_msg_hdr) +
-                                    PLDM_GET_PDR_REQ_BYTES);
-    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
     uint32_t recordHandle{};
     if (!nextRecordHandle && (!modifiedPDRRecordHandles.empty()) &&
         isHostPdrModified)
@@ -339,26 +349,68 @@ void HostPDRHandler::getHostPDR(uint32_t nextRecordHandle)
     {
         recordHandle = nextRecordHandle;
     }
-    auto instanceId = requester.getInstanceId(mctp_eid);
 
-    auto rc =
-        encode_get_pdr_req(instanceId, recordHandle, 0, PLDM_GET_FIRSTPART,
-                           UINT16_MAX, 0, request, PLDM_GET_PDR_REQ_BYTES);
-    if (rc != PLDM_SUCCESS)
+    if (isHostPdrModified)
     {
-        requester.markFree(mctp_eid, instanceId);
-        std::cerr << "Failed to encode_get_pdr_req, rc = " << rc << std::endl;
-        return;
+        pdrPrefetcher.fetch(recordHandle, modifiedPDRRecordHandles, false);
+    }
+    else
+    {
+        pdrPrefetcher.fetch(recordHandle, pdrRecordHandles, true);
     }
+}
 
-    rc = handler->registerRequest(
-        mctp_eid, instanceId, PLDM_PLATFORM, PLDM_GET_PDR,
-        std::move(requestMsg),
-        std::move(std::bind_front(&HostPDRHandler::processHostPDRs, this)));
-    if (rc)
+bool HostPDRHandler::mergePDRPart(uint8_t transferFlag,
+                                  uint32_t nextDataTransferHandle,
+                                  uint8_t transferCRC,
+                                  std::vector<uint8_t>& pdr)
+{
+    if (transferFlag == PLDM_START)
+    {
+        pdrParts.clear();
+    }
+    else if (pdrParts.empty() ||
+             (transferFlag != PLDM_MIDDLE && transferFlag != PLDM_END))
+    {
+        std::cerr << "Unexpected GetPDR transfer flag = "
+                  << static_cast<unsigned>(transferFlag) << std::endl;
+        pdrParts.clear();
+        return false;
+    }
+    pdrParts.insert(pdrParts.end(), pdr.begin(), pdr.end());
+
+    if (transferFlag == PLDM_END)
+    {
+        pdr = std::move(pdrParts);
+        pdrParts.clear();
+        if (crc8(pdr.data(), pdr.size()) != transferCRC)
+        {
+            std::cerr << "GetPDR transfer CRC mismatch" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    if (pdrParts.size() < sizeof(pldm_pdr_hdr))
+    {
+        std::cerr << "Failed to get the record handle of a PDR sent in parts"
+                  << std::endl;
+        pdrParts.clear();
+        return false;
+    }
+    auto pdrHdr = reinterpret_cast<const pldm_pdr_hdr*>(pdrParts.data());
+    if (!pdrPrefetcher.fetchNextPart(pdrHdr->record_handle,
+                                     nextDataTransferHandle))
     {
-        std::cerr << "Failed to send the GetPDR request to Host \n";
+        pdrParts.clear();
     }
+    return false;
+}
+
+void HostPDRHandler::resetPDRFetch()
+{
+    pdrPrefetcher.reset();
+    pdrParts.clear();
 }
 std::string HostPDRHandler::updateLedGroupPath(const std::string& path)
 {
@@ -689,8 +741,16 @@ void HostPDRHandler::processHostPDRs(mctp_eid_t /*eid*/,
                       << std::endl;
             return;
         }
+        else if (transferFlag != PLDM_START_AND_END &&
+                 !mergePDRPart(transferFlag, nextDataTransferHandle,
+                               transferCRC, pdr))
+        {
+            // More parts of the PDR to come, or the transfer failed
+            return;
+        }
         else
         {
+            respCount = pdr.size();
             // when nextRecordHandle is 0, we need the recordHandle of the last
             // PDR and not 0-1.
             if (!nextRecordHandle)
@@ -861,6 +921,8 @@ void HostPDRHandler::processHostPDRs(mctp_eid_t /*eid*/,
     }
     if (!nextRecordHandle)
     {
+        resetPDRFetch();
+
         pldm_pdr_record* firstRecord = repo->first;
         pldm_pdr_record* lastRecord = repo->last;
         std::cerr << "First Record in the repo after PDR exchange is: "
@@ -907,6 +969,7 @@ void HostPDRHandler::processHostPDRs(mctp_eid_t /*eid*/,
         if (modifiedPDRRecordHandles.empty() && isHostPdrModified)
         {
             isHostPdrModified = false;
+            resetPDRFetch();
         }
         else
         {
@@ -11,6 +11,7 @@
 #include "libpldmresponder/event_parser.hpp"
 #include "libpldmresponder/oem_handler.hpp"
 #include "libpldmresponder/pdr_utils.hpp"
+#include "pdr_prefetcher.hpp"
 #include "requester/handler.hpp"
 #include "utils.hpp"
 
@@ -21,6 +22,8 @@
 #include <filesystem>
 #include <map>
 #include <memory>
+#include <optional>
+#include <set>
 #include <vector>
 
 namespace pldm
@@ -233,6 +236,21 @@ class HostPDRHandler
     void processHostPDRs(mctp_eid_t eid, const pldm_msg* response,
                          size_t respMsgLen);
 
+    /** @brief collect a part of a PDR the Host sends in parts, and request
+     *  the next part unless this is the last one
+     *  @param[in] transferFlag - transfer flag of the part
+     *  @param[in] nextDataTransferHandle - handle of the next part
+     *  @param[in] transferCRC - CRC of the PDR, sent with the last part
+     *  @param[in,out] pdr - the part, replaced by the whole PDR once the last
+     *                       part is collected
+     *  @return true if the whole PDR is collected and its CRC matches
+     */
+    bool mergePDRPart(uint8_t transferFlag, uint32_t nextDataTransferHandle,
+                      uint8_t transferCRC, std::vector<uint8_t>& pdr);
+
+    /** @brief drop the GetPDR requests in flight and the responses held */
+    void resetPDRFetch();
+
     /** @brief send PDR Repo change after merging Host's PDR to BMC PDR repo
      *  @param[in] source - sdeventplus event source
      */
@@ -376,6 +394,17 @@ class HostPDRHandler
     /** @brief list of PDR record handles modified pointing to host's PDRs */
     PDRRecordHandles modifiedPDRRecordHandles;
 
+    /** @brief maximum number of GetPDR requests in flight to the Host */
+    static constexpr size_t pdrFetchWindow = 4;
+
+    /** @brief GetPDR requests in flight and responses received ahead of
+     *  their turn, reset when a PDR exchange starts or ends
+     */
+    PDRPrefetcher pdrPrefetcher;
+
+    /** @brief parts received so far of a PDR the Host sends in parts */
+    std::vector<uint8_t> pdrParts;
+
     /** @brief maps an entity type to parent pldm_entity from the BMC's entity
      *  association tree
      */
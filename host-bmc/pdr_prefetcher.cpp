@@ -0,0 +1,160 @@
+#include "pdr_prefetcher.hpp"
+
+#include <iostream>
+
+namespace pldm
+{
+
+void PDRPrefetcher::fetch(uint32_t recordHandle,
+                          const std::deque<uint32_t>& listed, bool guessNext)
+{
+    // The response may have arrived already, requested ahead of its turn
+    auto prefetched = prefetchedPDRs.find(recordHandle);
+    if (prefetched != prefetchedPDRs.end())
+    {
+        auto responseMsg = std::move(prefetched->second);
+        prefetchedPDRs.erase(prefetched);
+        prefetch(recordHandle, listed, guessNext);
+        processResponse(reinterpret_cast<const pldm_msg*>(responseMsg.data()),
+                        responseMsg.size() - sizeof(pldm_msg_hdr));
+        return;
+    }
+
+    awaitedPDRHandle = recordHandle;
+    if (!pendingPDRHandles.contains(recordHandle))
+    {
+        // The responses held were requested for records that did not come
+        // next, they are not going to be used
+        prefetchedPDRs.clear();
+        if (!sendGetPDRRequest(recordHandle, 0, PLDM_GET_FIRSTPART))
+        {
+            if (awaitedPDRHandle == recordHandle)
+            {
+                awaitedPDRHandle.reset();
+            }
+            return;
+        }
+    }
+    prefetch(recordHandle, listed, guessNext);
+}
+
+bool PDRPrefetcher::fetchNextPart(uint32_t recordHandle,
+                                  uint32_t dataTransferHandle)
+{
+    awaitedPDRHandle = recordHandle;
+    if (!sendGetPDRRequest(recordHandle, dataTransferHandle,
+                           PLDM_GET_NEXTPART))
+    {
+        if (awaitedPDRHandle == recordHandle)
+        {
+            awaitedPDRHandle.reset();
+        }
+        return false;
+    }
+    return true;
+}
+
+void PDRPrefetcher::reset()
+{
+    ++fetchGeneration;
+    pendingPDRHandles.clear();
+    prefetchedPDRs.clear();
+    awaitedPDRHandle.reset();
+}
+
+bool PDRPrefetcher::sendGetPDRRequest(uint32_t recordHandle,
+                                      uint32_t dataTransferHandle,
+                                      uint8_t transferOpFlag)
+{
+    std::vector<uint8_t> requestMsg(sizeof(pldm_msg_hdr) +
+                                    PLDM_GET_PDR_REQ_BYTES);
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+
+    // The instance ID is allocated by the handler when the request is sent
+    auto rc = encode_get_pdr_req(0, recordHandle, dataTransferHandle,
+                                 transferOpFlag, UINT16_MAX, 0, request,
+                                 PLDM_GET_PDR_REQ_BYTES);
+    if (rc != PLDM_SUCCESS)
+    {
+        std::cerr << "Failed to encode_get_pdr_req, rc = " << rc << std::endl;
+        return false;
+    }
+
+    // Pending before it is sent, the response handler is invoked right away
+    // if the request fails to be sent
+    pendingPDRHandles.insert(recordHandle);
+    rc = sendRequest(std::move(requestMsg),
+                     std::bind_front(&PDRPrefetcher::receive, this,
+                                     fetchGeneration, recordHandle));
+    if (rc)
+    {
+        std::cerr << "Failed to send the GetPDR request to Host \n";
+        pendingPDRHandles.erase(recordHandle);
+        return false;
+    }
+    return pendingPDRHandles.contains(recordHandle);
+}
+
+void PDRPrefetcher::prefetch(uint32_t recordHandle,
+                             const std::deque<uint32_t>& listed, bool guessNext)
+{
+    std::vector<uint32_t> recordHandles(listed.begin(), listed.end());
+    if (recordHandles.empty() && guessNext && recordHandle)
+    {
+        // Host record handles are usually consecutive, the guess costs an
+        // error response when they are not
+        for (size_t i = 1; i < window; ++i)
+        {
+            recordHandles.push_back(recordHandle + i);
+        }
+    }
+
+    for (const auto& handle : recordHandles)
+    {
+        if (pendingPDRHandles.size() + prefetchedPDRs.size() >= window)
+        {
+            break;
+        }
+        if (pendingPDRHandles.contains(handle) ||
+            prefetchedPDRs.contains(handle))
+        {
+            continue;
+        }
+
+        if (!sendGetPDRRequest(handle, 0, PLDM_GET_FIRSTPART))
+        {
+            break;
+        }
+    }
+}
+
+void PDRPrefetcher::receive(uint32_t generation, uint32_t recordHandle,
+                            mctp_eid_t /*eid*/, const pldm_msg* response,
+                            size_t respMsgLen)
+{
+    if (generation != fetchGeneration)
+    {
+        return;
+    }
+    pendingPDRHandles.erase(recordHandle);
+
+    if (awaitedPDRHandle == recordHandle)
+    {
+        awaitedPDRHandle.reset();
+        processResponse(response, respMsgLen);
+        return;
+    }
+
+    // A failed prefetch is requested again when its turn comes, so is one
+    // the Host rejected, such as a guessed record handle it does not have
+    if (response != nullptr && respMsgLen &&
+        response->payload[0] == PLDM_SUCCESS)
+    {
+        auto msg = reinterpret_cast<const uint8_t*>(response);
+        prefetchedPDRs.insert_or_assign(
+            recordHandle,
+            std::vector<uint8_t>(msg, msg + sizeof(pldm_msg_hdr) + respMsgLen));
+    }
+}
+
+} // namespace pldm
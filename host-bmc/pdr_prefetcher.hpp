@@ -0,0 +1,154 @@
+#pragma once
+
+#include "libpldm/base.h"
+#include "libpldm/platform.h"
+
+#include "common/types.hpp"
+#include "requester/handler.hpp"
+
+#include <deque>
+#include <functional>
+#include <map>
+#include <optional>
+#include <set>
+#include <vector>
+
+namespace pldm
+{
+
+/** @class PDRPrefetcher
+ *  @brief Fetches the PDRs of the Host one after the other, keeping GetPDR
+ *  requests in flight for the records expected after the one being fetched
+ *  @details The responses received ahead of their turn are held until the
+ *  record is fetched. Responses to the requests sent before a reset are
+ *  dropped.
+ */
+class PDRPrefetcher
+{
+  public:
+    /** @brief send a GetPDR request to the Host, the instance ID is allocated
+     *  when the request is sent. The response handler may be invoked with an
+     *  empty response before this returns if sending the request fails.
+     */
+    using SendRequest = std::function<int(
+        pldm::Request&& requestMsg,
+        pldm::requester::ResponseHandler&& responseHandler)>;
+
+    /** @brief process the GetPDR response for the record being fetched, the
+     *  response is empty if none was received
+     */
+    using ProcessResponse =
+        std::function<void(const pldm_msg* response, size_t respMsgLen)>;
+
+    PDRPrefetcher() = delete;
+    PDRPrefetcher(const PDRPrefetcher&) = delete;
+    PDRPrefetcher(PDRPrefetcher&&) = delete;
+    PDRPrefetcher& operator=(const PDRPrefetcher&) = delete;
+    PDRPrefetcher& operator=(PDRPrefetcher&&) = delete;
+    ~PDRPrefetcher() = default;
+
+    /** @brief Constructor
+     *  @param[in] window - maximum number of GetPDR requests in flight and
+     *                      responses held
+     *  @param[in] sendRequest - sends a GetPDR request to the Host
+     *  @param[in] processResponse - processes the response for the record
+     *                               being fetched
+     */
+    PDRPrefetcher(size_t window, SendRequest&& sendRequest,
+                  ProcessResponse&& processResponse) :
+        window(window),
+        sendRequest(std::move(sendRequest)),
+        processResponse(std::move(processResponse))
+    {}
+
+    /** @brief fetch a PDR, and prefetch the ones expected after it. These are
+     *  the record handles the Host listed when it did, the following record
+     *  handles otherwise.
+     *  @param[in] recordHandle - record handle of the PDR
+     *  @param[in] listed - record handles the Host listed to come next
+     *  @param[in] guessNext - prefetch the following record handles when the
+     *                         Host listed none
+     */
+    void fetch(uint32_t recordHandle, const std::deque<uint32_t>& listed,
+               bool guessNext);
+
+    /** @brief fetch the next part of a PDR the Host sends in parts
+     *  @param[in] recordHandle - record handle of the PDR
+     *  @param[in] dataTransferHandle - handle of the part
+     *  @return true if the request is in flight
+     */
+    bool fetchNextPart(uint32_t recordHandle, uint32_t dataTransferHandle);
+
+    /** @brief drop the GetPDR requests in flight and the responses held */
+    void reset();
+
+    /** @brief get the number of GetPDR requests in flight */
+    size_t inFlight() const
+    {
+        return pendingPDRHandles.size();
+    }
+
+    /** @brief get the number of GetPDR responses held */
+    size_t held() const
+    {
+        return prefetchedPDRs.size();
+    }
+
+  private:
+    /** @brief send a GetPDR request for a record
+     *  @param[in] recordHandle - record handle of the PDR
+     *  @param[in] dataTransferHandle - handle of the part of the PDR to get
+     *  @param[in] transferOpFlag - PLDM_GET_FIRSTPART or PLDM_GET_NEXTPART
+     *  @return true if the request is in flight, false if it was not sent or
+     *          it failed already
+     */
+    bool sendGetPDRRequest(uint32_t recordHandle, uint32_t dataTransferHandle,
+                           uint8_t transferOpFlag);
+
+    /** @brief keep up to window GetPDR requests in flight for the records
+     *  expected after the one being fetched
+     *  @param[in] recordHandle - record handle of the PDR being fetched
+     *  @param[in] listed - record handles the Host listed to come next
+     *  @param[in] guessNext - prefetch the following record handles when the
+     *                         Host listed none
+     */
+    void prefetch(uint32_t recordHandle, const std::deque<uint32_t>& listed,
+                  bool guessNext);
+
+    /** @brief handle a GetPDR response, either passing it on to
+     *  processResponse if it is the record being fetched or holding it
+     *  until its turn comes
+     *  @param[in] generation - fetchGeneration when the request was sent
+     *  @param[in] recordHandle - record handle the request asked for
+     *  @param[in] eid - MCTP id of Host
+     *  @param[in] response - response from Host for GetPDR
+     *  @param[in] respMsgLen - response message length
+     */
+    void receive(uint32_t generation, uint32_t recordHandle, mctp_eid_t eid,
+                 const pldm_msg* response, size_t respMsgLen);
+
+    /** @brief maximum number of GetPDR requests in flight and responses held
+     */
+    size_t window;
+
+    SendRequest sendRequest;
+    ProcessResponse processResponse;
+
+    /** @brief record handles of the GetPDR requests in flight */
+    std::set<uint32_t> pendingPDRHandles;
+
+    /** @brief GetPDR responses received ahead of their turn, by the record
+     *  handle requested
+     */
+    std::map<uint32_t, std::vector<uint8_t>> prefetchedPDRs;
+
+    /** @brief record handle whose response processResponse is waiting for */
+    std::optional<uint32_t> awaitedPDRHandle;
+
+    /** @brief bumped on reset, so that responses to requests sent earlier
+     *  are dropped
+     */
+    uint32_t fetchGeneration = 0;
+};
+
+} // namespace pldm
@@ -0,0 +1,312 @@
+#include "libpldm/platform.h"
+
+#include "common/utils.hpp"
+#include "host-bmc/pdr_prefetcher.hpp"
+#include "pldmd/dbus_impl_requester.hpp"
+#include "requester/handler.hpp"
+#include "requester/test/mock_request.hpp"
+
+#include <cstring>
+#include <deque>
+#include <map>
+#include <set>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace pldm;
+using namespace pldm::requester;
+using namespace std::chrono;
+
+using ::testing::NiceMock;
+
+class PDRPrefetcherTest : public testing::Test
+{
+  protected:
+    PDRPrefetcherTest() :
+        prefetcher(
+            window,
+            [this](pldm::Request&& requestMsg,
+                   ResponseHandler&& responseHandler) {
+                return sendRequest(std::move(requestMsg),
+                                   std::move(responseHandler));
+            },
+            [this](const pldm_msg* response, size_t respMsgLen) {
+                processed.push_back(recordOf(response, respMsgLen));
+            })
+    {}
+
+    /** @brief Requester standing in for the request handler, it keeps the
+     *         response handlers till the test responds
+     */
+    int sendRequest(pldm::Request&& requestMsg,
+                    ResponseHandler&& responseHandler)
+    {
+        uint32_t recordHandle{};
+        uint32_t dataTransferHandle{};
+        uint8_t transferOpFlag{};
+        uint16_t requestCnt{};
+        uint16_t recordChgNum{};
+        auto rc = decode_get_pdr_req(
+            reinterpret_cast<const pldm_msg*>(requestMsg.data()),
+            PLDM_GET_PDR_REQ_BYTES, &recordHandle, &dataTransferHandle,
+            &transferOpFlag, &requestCnt, &recordChgNum);
+        EXPECT_EQ(rc, PLDM_SUCCESS);
+        requested.push_back(recordHandle);
+
+        // As the request handler does when the request is queued and fails
+        // to be sent
+        if (failing.contains(recordHandle))
+        {
+            responseHandler(eid, nullptr, 0);
+            return PLDM_SUCCESS;
+        }
+        inFlight.emplace(recordHandle, std::move(responseHandler));
+        return PLDM_SUCCESS;
+    }
+
+    /** @brief Respond to the earliest request in flight for a record, the
+     *         record data is its record handle
+     */
+    void respond(uint32_t recordHandle, uint32_t nextRecordHandle,
+                 uint8_t completionCode = PLDM_SUCCESS)
+    {
+        auto it = inFlight.lower_bound(recordHandle);
+        ASSERT_TRUE(it != inFlight.end() && it->first == recordHandle);
+        auto responseHandler = std::move(it->second);
+        inFlight.erase(it);
+
+        std::vector<uint8_t> response(sizeof(pldm_msg_hdr) +
+                                      PLDM_GET_PDR_MIN_RESP_BYTES +
+                                      sizeof(recordHandle));
+        auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+        auto rc = encode_get_pdr_resp(
+            0, completionCode, nextRecordHandle, 0, PLDM_START_AND_END,
+            sizeof(recordHandle),
+            reinterpret_cast<const uint8_t*>(&recordHandle), 0, responsePtr);
+        ASSERT_EQ(rc, PLDM_SUCCESS);
+        if (completionCode != PLDM_SUCCESS)
+        {
+            response.resize(sizeof(pldm_msg_hdr) + sizeof(completionCode));
+        }
+        responseHandler(eid, responsePtr,
+                        response.size() - sizeof(pldm_msg_hdr));
+    }
+
+    /** @brief Get the record handle a response carries, 0 if it is empty or
+     *         an error
+     */
+    static uint32_t recordOf(const pldm_msg* response, size_t respMsgLen)
+    {
+        if (response == nullptr || !respMsgLen)
+        {
+            return 0;
+        }
+        uint8_t completionCode{};
+        uint32_t nextRecordHandle{};
+        uint32_t nextDataTransferHandle{};
+        uint8_t transferFlag{};
+        uint16_t respCnt{};
+        uint8_t transferCRC{};
+        uint8_t recordData[sizeof(uint32_t)]{};
+        auto rc = decode_get_pdr_resp(
+            response, respMsgLen, &completionCode, &nextRecordHandle,
+            &nextDataTransferHandle, &transferFlag, &respCnt, recordData,
+            sizeof(recordData), &transferCRC);
+        if (rc != PLDM_SUCCESS || completionCode != PLDM_SUCCESS)
+        {
+            return 0;
+        }
+        uint32_t recordHandle{};
+        memcpy(&recordHandle, recordData, sizeof(recordHandle));
+        return recordHandle;
+    }
+
+    /** @brief Fetch the next record the Host listed, as HostPDRHandler does
+     */
+    void fetchListed()
+    {
+        auto recordHandle = listed.front();
+        listed.pop_front();
+        prefetcher.fetch(recordHandle, listed, true);
+    }
+
+    static constexpr size_t window = 4;
+    mctp_eid_t eid = 0;
+    std::deque<uint32_t> listed;
+    std::vector<uint32_t> requested;
+    std::vector<uint32_t> processed;
+    std::set<uint32_t> failing;
+    std::multimap<uint32_t, ResponseHandler> inFlight;
+    PDRPrefetcher prefetcher;
+};
+
+TEST_F(PDRPrefetcherTest, prefetchWindow)
+{
+    // Without a list from the Host the following record handles are guessed
+    prefetcher.fetch(1, listed, true);
+    EXPECT_EQ(requested, (std::vector<uint32_t>{1, 2, 3, 4}));
+    EXPECT_EQ(prefetcher.inFlight(), window);
+
+    respond(1, 2);
+    EXPECT_EQ(processed, std::vector<uint32_t>{1});
+
+    // Record 2 is already requested, the window moves on by one
+    prefetcher.fetch(2, listed, true);
+    EXPECT_EQ(requested, (std::vector<uint32_t>{1, 2, 3, 4, 5}));
+    EXPECT_EQ(prefetcher.inFlight(), window);
+}
+
+TEST_F(PDRPrefetcherTest, prefetchListed)
+{
+    listed = {5, 10, 20, 30, 40};
+    fetchListed();
+    EXPECT_EQ(requested, (std::vector<uint32_t>{5, 10, 20, 30}));
+
+    // Responses held count against the window too
+    respond(20, 30);
+    respond(30, 40);
+    respond(5, 10);
+    EXPECT_EQ(processed, std::vector<uint32_t>{5});
+    EXPECT_EQ(prefetcher.inFlight(), 1);
+    EXPECT_EQ(prefetcher.held(), 2);
+
+    fetchListed();
+    EXPECT_EQ(requested, (std::vector<uint32_t>{5, 10, 20, 30, 40}));
+}
+
+TEST_F(PDRPrefetcherTest, outOfOrderCompletion)
+{
+    listed = {1, 2, 3, 4};
+    fetchListed();
+    EXPECT_EQ(requested, (std::vector<uint32_t>{1, 2, 3, 4}));
+
+    respond(3, 4);
+    respond(4, 0);
+    respond(2, 3);
+    EXPECT_TRUE(processed.empty());
+    EXPECT_EQ(prefetcher.held(), 3);
+
+    respond(1, 2);
+    EXPECT_EQ(processed, std::vector<uint32_t>{1});
+
+    // The responses held are processed in turn, without requesting again
+    fetchListed();
+    fetchListed();
+    EXPECT_EQ(processed, (std::vector<uint32_t>{1, 2, 3}));
+    EXPECT_EQ(requested.size(), 4);
+    EXPECT_EQ(prefetcher.inFlight(), 0);
+    EXPECT_EQ(prefetcher.held(), 1);
+
+    // Past the end of the list the following record handles are guessed
+    fetchListed();
+    EXPECT_EQ(processed, (std::vector<uint32_t>{1, 2, 3, 4}));
+    EXPECT_EQ(requested, (std::vector<uint32_t>{1, 2, 3, 4, 5, 6, 7}));
+    EXPECT_EQ(prefetcher.held(), 0);
+}
+
+TEST_F(PDRPrefetcherTest, failedGuesses)
+{
+    // The Host has records 1, 10 and 11
+    prefetcher.fetch(1, listed, true);
+    EXPECT_EQ(requested, (std::vector<uint32_t>{1, 2, 3, 4}));
+
+    // The Host rejects the guesses, they are not held
+    respond(2, 0, PLDM_PLATFORM_INVALID_RECORD_HANDLE);
+    respond(3, 0, PLDM_PLATFORM_INVALID_RECORD_HANDLE);
+    EXPECT_EQ(prefetcher.held(), 0);
+
+    respond(1, 10);
+    EXPECT_EQ(processed, std::vector<uint32_t>{1});
+
+    // The guess for 4 is still in flight, it takes a slot of the window
+    prefetcher.fetch(10, listed, true);
+    EXPECT_EQ(requested, (std::vector<uint32_t>{1, 2, 3, 4, 10, 11, 12}));
+    respond(4, 0, PLDM_PLATFORM_INVALID_RECORD_HANDLE);
+    respond(12, 0, PLDM_PLATFORM_INVALID_RECORD_HANDLE);
+    respond(11, 0);
+    respond(10, 11);
+    prefetcher.fetch(11, listed, true);
+    EXPECT_EQ(processed, (std::vector<uint32_t>{1, 10, 11}));
+    EXPECT_EQ(prefetcher.held(), 0);
+}
+
+TEST_F(PDRPrefetcherTest, resetDropsResponses)
+{
+    prefetcher.fetch(1, listed, true);
+    EXPECT_EQ(prefetcher.inFlight(), window);
+
+    // The Host modified its PDRs, the exchange starts over
+    prefetcher.reset();
+    EXPECT_EQ(prefetcher.inFlight(), 0);
+    prefetcher.fetch(1, listed, true);
+    EXPECT_EQ(requested, (std::vector<uint32_t>{1, 2, 3, 4, 1, 2, 3, 4}));
+
+    // The responses to the requests sent before are neither processed nor
+    // held
+    respond(2, 3);
+    respond(1, 2);
+    EXPECT_TRUE(processed.empty());
+    EXPECT_EQ(prefetcher.held(), 0);
+    EXPECT_EQ(prefetcher.inFlight(), window);
+
+    respond(1, 2);
+    EXPECT_EQ(processed, std::vector<uint32_t>{1});
+}
+
+TEST_F(PDRPrefetcherTest, prefetchSendFailure)
+{
+    listed = {1, 2, 3, 4};
+    failing = {3};
+    fetchListed();
+
+    // The failure stops the prefetch, record 3 is not left pending
+    EXPECT_EQ(requested, (std::vector<uint32_t>{1, 2, 3}));
+    EXPECT_EQ(prefetcher.inFlight(), 2);
+    failing.clear();
+
+    respond(2, 3);
+    respond(1, 2);
+    fetchListed();
+    EXPECT_EQ(requested, (std::vector<uint32_t>{1, 2, 3, 3, 4}));
+
+    fetchListed();
+    respond(3, 4);
+    EXPECT_EQ(processed, (std::vector<uint32_t>{1, 2, 3}));
+}
+
+TEST_F(PDRPrefetcherTest, fetchSendFailure)
+{
+    auto event = sdeventplus::Event::get_default();
+    pldm::dbus_api::Requester dbusImplReq(pldm::utils::DBusHandler::getBus(),
+                                          "/xyz/openbmc_project/pldm");
+    Handler<NiceMock<MockRequest>> reqHandler(
+        0, event, dbusImplReq, false, 90000, seconds(1), 2, milliseconds(100));
+    PDRPrefetcher handlerPrefetcher(
+        window,
+        [&](pldm::Request&& requestMsg, ResponseHandler&& responseHandler) {
+            return reqHandler.registerRequest(eid, PLDM_PLATFORM, PLDM_GET_PDR,
+                                              std::move(requestMsg),
+                                              std::move(responseHandler));
+        },
+        [this](const pldm_msg* response, size_t respMsgLen) {
+            processed.push_back(recordOf(response, respMsgLen));
+        });
+
+    // MockRequest::send fails, the handler invokes the response handler
+    // from within registerRequest
+    ::testing::DefaultValue<int>::Set(PLDM_ERROR);
+    handlerPrefetcher.fetch(1, listed, true);
+    ::testing::DefaultValue<int>::Clear();
+
+    // The failure is passed on for the record being fetched, nothing is left
+    // pending and nothing is prefetched after it
+    EXPECT_EQ(processed, std::vector<uint32_t>{0});
+    EXPECT_EQ(handlerPrefetcher.inFlight(), 0);
+    EXPECT_EQ(reqHandler.queuedRequests(eid), 0);
+
+    // The record is requested again when it is fetched again
+    handlerPrefetcher.fetch(1, listed, true);
+    EXPECT_EQ(handlerPrefetcher.inFlight(), window);
+}
@@ -0,0 +1,103 @@
+#include "libpldm/pdr.h"
+
+#include "../dbus/serialize.hpp"
+
+#include <stdlib.h>
+
+#include <sdeventplus/event.hpp>
+
+#include <filesystem>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+using namespace pldm;
+using namespace pldm::serialize;
+
+class SerializeTest : public testing::Test
+{
+  protected:
+    SerializeTest() : event(sdeventplus::Event::get_default())
+    {
+        char dir[] = "/tmp/pldm_serialize.XXXXXX";
+        tmpDir = mkdtemp(dir);
+        file = tmpDir / "persist";
+
+        pldm_entity entity{};
+        entity.entity_type = 45;
+        tree = pldm_entity_association_tree_init();
+        node = pldm_entity_association_tree_add(
+            tree, &entity, 1, nullptr, PLDM_ENTITY_ASSOCIAION_PHYSICAL, false,
+            true, 0xFFFF);
+    }
+
+    ~SerializeTest()
+    {
+        pldm_entity_association_tree_destroy(tree);
+        fs::remove_all(tmpDir);
+    }
+
+    void setUp(Serialize& serialize)
+    {
+        serialize.setObjectPathMaps({{objPath, node}});
+        serialize.setEntityTypes({45});
+    }
+
+    /** @brief Get a property saved in the persistent file */
+    dbus::PropertyValue restore(const std::string& name)
+    {
+        Serialize restored(file);
+        auto savedObjs = restored.getSavedObjs();
+        const auto& [num, cid, objs] = savedObjs.at(45).at(objPath);
+        return objs.at(intf).at(name);
+    }
+
+    const std::string objPath = "/xyz/openbmc_project/inventory/system";
+    const std::string intf = "xyz.openbmc_project.Inventory.Item";
+    sdeventplus::Event event;
+    pldm_entity_association_tree* tree;
+    pldm_entity_node* node;
+    fs::path tmpDir;
+    fs::path file;
+};
+
+TEST_F(SerializeTest, coalescedWrites)
+{
+    Serialize serialize(file);
+    setUp(serialize);
+
+    serialize.serialize(objPath, intf, "Present", true);
+    serialize.serialize(objPath, intf, "PrettyName", std::string("system"));
+    serialize.serialize(objPath, intf, "Present", false);
+
+    // Nothing is written till the delay expires, however many times the
+    // event loop runs meanwhile
+    for (int i = 0; i < 5; ++i)
+    {
+        sd_event_run(event.get(), 0);
+    }
+    EXPECT_FALSE(fs::exists(file));
+
+    for (int i = 0; i < 10 && !fs::exists(file); ++i)
+    {
+        sd_event_run(event.get(), 100000);
+    }
+    ASSERT_TRUE(fs::exists(file));
+    EXPECT_FALSE(fs::exists(fs::path(file) += ".tmp"));
+    EXPECT_EQ(restore("Present"), dbus::PropertyValue(false));
+    EXPECT_EQ(restore("PrettyName"),
+              dbus::PropertyValue(std::string("system")));
+}
+
+TEST_F(SerializeTest, flushOnDestruction)
+{
+    {
+        Serialize serialize(file);
+        setUp(serialize);
+        serialize.serialize(objPath, intf, "Present", true);
+        EXPECT_FALSE(fs::exists(file));
+    }
+
+    ASSERT_TRUE(fs::exists(file));
+    EXPECT_EQ(restore("Present"), dbus::PropertyValue(true));
+}
@@ -25,6 +25,9 @@ extern "C" {
 #define PLDM_GET_BIOS_ATTR_CURR_VAL_BY_HANDLE_MIN_RESP_BYTES 6
 
 enum pldm_bios_completion_codes {
+	PLDM_INVALID_BIOS_DATA_TRANSFER_HANDLE = 0x80,
+	PLDM_INVALID_BIOS_TRANSFER_OPERATION_FLAG = 0x81,
+	PLDM_INVALID_BIOS_TRANSFER_FLAG = 0x82,
 	PLDM_BIOS_TABLE_UNAVAILABLE = 0x83,
 	PLDM_INVALID_BIOS_TABLE_DATA_INTEGRITY_CHECK = 0x84,
 	PLDM_INVALID_BIOS_TABLE_TYPE = 0x85,
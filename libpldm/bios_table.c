@@ -1109,6 +1109,42 @@ out:
 	return rc;
 }
 
+int pldm_bios_table_attr_value_update_in_place(void *table, size_t length,
+					       size_t offset, const void *entry,
+					       size_t entry_length)
+{
+	POINTER_CHECK(table);
+	POINTER_CHECK(entry);
+
+	const size_t header_length =
+	    sizeof(struct pldm_bios_attr_val_table_entry) - 1;
+	if (length < sizeof(uint32_t) || entry_length < header_length ||
+	    entry_length > length - sizeof(uint32_t) ||
+	    offset > length - sizeof(uint32_t) - entry_length)
+		return PLDM_ERROR_INVALID_LENGTH;
+
+	uint8_t *dest = (uint8_t *)table + offset;
+	const struct pldm_bios_attr_val_table_entry *old_entry =
+	    (const struct pldm_bios_attr_val_table_entry *)dest;
+	const struct pldm_bios_attr_val_table_entry *new_entry = entry;
+	if (old_entry->attr_handle != new_entry->attr_handle ||
+	    old_entry->attr_type != new_entry->attr_type)
+		return PLDM_ERROR_INVALID_DATA;
+	if (attr_value_table_entry_length(old_entry) != entry_length ||
+	    attr_value_table_entry_length(new_entry) != entry_length)
+		return PLDM_ERROR_INVALID_LENGTH;
+
+	uint8_t *checksum = (uint8_t *)table + length - sizeof(uint32_t);
+	uint32_t crc;
+	memcpy(&crc, checksum, sizeof(crc));
+	crc = crc32_update(le32toh(crc), dest, entry, entry_length,
+			   checksum - (dest + entry_length));
+	memcpy(dest, entry, entry_length);
+	checksum_append(checksum, crc);
+
+	return PLDM_SUCCESS;
+}
+
 bool pldm_bios_table_checksum(const uint8_t *table, size_t size)
 {
 	if (table == NULL)
@@ -714,6 +714,23 @@ int pldm_bios_table_attr_value_copy_and_update(
     const void *src_table, size_t src_length, void *dest_table,
     size_t *dest_length, const void *entry, size_t entry_length);
 
+/** @brief Overwrite an entry of the attribute value table in place
+ *
+ *  The new entry must have the same attribute handle, attribute type and
+ *  length as the entry it replaces, so the layout of the table is unchanged.
+ *  The checksum of the table is updated incrementally.
+ *
+ *  @param[in,out] table - Pointer to the attribute value table
+ *  @param[in] length - Size of the table, including pad and checksum
+ *  @param[in] offset - Offset of the entry to overwrite in the table
+ *  @param[in] entry - Pointer to the new entry
+ *  @param[in] entry_length - Size of the new entry
+ *  @return pldm_completion_codes
+ */
+int pldm_bios_table_attr_value_update_in_place(void *table, size_t length,
+					       size_t offset, const void *entry,
+					       size_t entry_length);
+
 /** @brief Verify the crc value of the complete table
  *  @param[in] table - Pointer to a buffer of a bios table
  *  @param[in] size - Size of the buffer of a bios table
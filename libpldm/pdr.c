@@ -10,69 +10,197 @@
 #include "oem/ibm/libpldm/pdr_oem_ibm.h"
 #endif
 
-static inline uint32_t get_next_record_handle(const pldm_pdr *repo,
-					      const pldm_pdr_record *record)
+#define PDR_INDEX_MIN_SIZE 64
+
+static inline uint32_t index_bucket(uint32_t index_size, uint32_t record_handle)
+{
+	/* Fibonacci hashing; index_size is always a power of two */
+	return (record_handle * 2654435761u) & (index_size - 1);
+}
+
+/* Chain record at the tail of its bucket */
+static void index_append(pldm_pdr *repo, pldm_pdr_record *record)
+{
+	pldm_pdr_record **slot =
+	    &repo->index[index_bucket(repo->index_size, record->record_handle)];
+	while (*slot != NULL) {
+		slot = &(*slot)->hash_next;
+	}
+	record->hash_next = NULL;
+	*slot = record;
+}
+
+/*
+ * Chain record into its bucket, keeping records with the same handle in list
+ * order so that lookups return the first of them, as walking the list does.
+ * The list is only walked when the handle is already indexed.
+ */
+static void index_insert(pldm_pdr *repo, pldm_pdr_record *record)
+{
+	pldm_pdr_record **slot =
+	    &repo->index[index_bucket(repo->index_size, record->record_handle)];
+	pldm_pdr_record *later = NULL;
+	bool later_found = false;
+	while (*slot != NULL) {
+		if ((*slot)->record_handle == record->record_handle) {
+			if (!later_found) {
+				/* First record with the same handle after it */
+				later = record->next;
+				while (later != NULL &&
+				       later->record_handle !=
+					   record->record_handle) {
+					later = later->next;
+				}
+				later_found = true;
+			}
+			if (*slot == later) {
+				break;
+			}
+		}
+		slot = &(*slot)->hash_next;
+	}
+	record->hash_next = *slot;
+	*slot = record;
+}
+
+static void index_remove(pldm_pdr *repo, pldm_pdr_record *record)
 {
-	assert(repo != NULL);
-	assert(record != NULL);
+	pldm_pdr_record **slot =
+	    &repo->index[index_bucket(repo->index_size, record->record_handle)];
+	while (*slot != NULL) {
+		if (*slot == record) {
+			*slot = record->hash_next;
+			break;
+		}
+		slot = &(*slot)->hash_next;
+	}
+	record->hash_next = NULL;
+}
 
-	if (record == repo->last) {
-		return 0;
+/* Rebuild the index from the record list, resizing it to fit */
+static void index_rebuild(pldm_pdr *repo, uint32_t index_size)
+{
+	if (index_size != repo->index_size) {
+		pldm_pdr_record **index =
+		    realloc(repo->index, index_size * sizeof(*index));
+		assert(index != NULL);
+		repo->index = index;
+		repo->index_size = index_size;
+	}
+	memset(repo->index, 0, repo->index_size * sizeof(*repo->index));
+
+	/* Chains keep the records with the same handle in list order */
+	pldm_pdr_record *record = repo->first;
+	while (record != NULL) {
+		index_append(repo, record);
+		record = record->next;
 	}
-	return record->next->record_handle;
 }
 
-static void add_record(pldm_pdr *repo, pldm_pdr_record *record)
+static pldm_pdr_record *index_find(const pldm_pdr *repo,
+				   uint32_t record_handle)
+{
+	pldm_pdr_record *record =
+	    repo->index[index_bucket(repo->index_size, record_handle)];
+	while (record != NULL && record->record_handle != record_handle) {
+		record = record->hash_next;
+	}
+	return record;
+}
+
+/* Insert record after prev, or at the head of the repo if prev is NULL */
+static void link_record(pldm_pdr *repo, pldm_pdr_record *prev,
+			pldm_pdr_record *record)
 {
 	assert(repo != NULL);
 	assert(record != NULL);
 
-	if (repo->first == NULL) {
-		assert(repo->last == NULL);
+	record->prev = prev;
+	if (prev == NULL) {
+		record->next = repo->first;
 		repo->first = record;
-		repo->last = record;
 	} else {
-		repo->last->next = record;
+		record->next = prev->next;
+		prev->next = record;
+	}
+	if (record->next == NULL) {
 		repo->last = record;
+	} else {
+		record->next->prev = record;
 	}
 	repo->size += record->size;
 	++repo->record_count;
+	++repo->generation;
+
+	if (repo->record_count > repo->index_size) {
+		index_rebuild(repo, repo->index_size * 2);
+	} else {
+		index_insert(repo, record);
+	}
 }
 
-static void add_hotplug_record(pldm_pdr *repo, pldm_pdr_record *record,
-			       uint32_t prev_record_handle)
+/* Remove record from the repo without freeing it */
+static void unlink_record(pldm_pdr *repo, pldm_pdr_record *record)
 {
-	// the new record
-	// needs to be added after prev_record_handle
 	assert(repo != NULL);
 	assert(record != NULL);
-	record->next = NULL;
-	if (repo->first == NULL) {
-		assert(repo->last == NULL);
-		repo->first = record;
-		repo->last = record;
+
+	index_remove(repo, record);
+	if (record->prev == NULL) {
+		repo->first = record->next;
 	} else {
-		pldm_pdr_record *curr = repo->first;
-		while (curr != NULL) {
-			if (curr->record_handle == prev_record_handle) {
-				break;
-			}
-			curr = curr->next;
-		}
-		// printf("\nadding the fru hotplug here
-		// curr->record_handle=%d",curr->record_handle);
-		// printf("repo-last=%x, curr=%x, curr-next=%x",(unsigned
-		// int)repo->last, (unsigned int)curr, (unsigned
-		// int)curr->next);
-		record->next = curr->next;
-		curr->next = record;
-		if (record->next == NULL) {
-			repo->last->next = record;
-			repo->last = record;
-		}
+		record->prev->next = record->next;
 	}
-	repo->size += record->size;
-	++repo->record_count;
+	if (record->next == NULL) {
+		repo->last = record->prev;
+	} else {
+		record->next->prev = record->prev;
+	}
+	record->next = NULL;
+	record->prev = NULL;
+	repo->size -= record->size;
+	--repo->record_count;
+	++repo->generation;
+}
+
+static void free_record(pldm_pdr_record *record)
+{
+	if (record->data) {
+		free(record->data);
+	}
+	free(record);
+}
+
+static void delete_record(pldm_pdr *repo, pldm_pdr_record *record)
+{
+	unlink_record(repo, record);
+	free_record(record);
+}
+
+/* Swap old_record for new_record at the same position and free old_record */
+static void replace_record(pldm_pdr *repo, pldm_pdr_record *old_record,
+			   pldm_pdr_record *new_record)
+{
+	pldm_pdr_record *prev = old_record->prev;
+	delete_record(repo, old_record);
+	link_record(repo, prev, new_record);
+}
+
+static inline uint32_t get_next_record_handle(const pldm_pdr *repo,
+					      const pldm_pdr_record *record)
+{
+	assert(repo != NULL);
+	assert(record != NULL);
+
+	if (record == repo->last) {
+		return 0;
+	}
+	return record->next->record_handle;
+}
+
+static void add_record(pldm_pdr *repo, pldm_pdr_record *record)
+{
+	link_record(repo, repo->last, record);
 }
 
 static void add_record_after_record_handle(pldm_pdr *repo,
@@ -81,26 +209,13 @@ static void add_record_after_record_handle(pldm_pdr *repo,
 {
 	assert(repo != NULL);
 	assert(record != NULL);
-	if (repo->first == NULL) {
-		assert(repo->last == NULL);
-		repo->first = record;
-		repo->last = record;
-	} else {
-		pldm_pdr_record *curr = repo->first;
-		while (curr != NULL) {
-			if (curr->record_handle == prev_record_handle) {
-				break;
-			}
-			curr = curr->next;
-		}
-		record->next = curr->next;
-		curr->next = record;
-		if (record->next == NULL) {
-			repo->last = record;
-		}
+
+	/* Fall back to appending if the previous record is unknown */
+	pldm_pdr_record *prev = index_find(repo, prev_record_handle);
+	if (prev == NULL) {
+		prev = repo->last;
 	}
-	repo->size += record->size;
-	++repo->record_count;
+	link_record(repo, prev, record);
 }
 
 static inline uint32_t get_new_record_handle(const pldm_pdr *repo)
@@ -155,6 +270,8 @@ static pldm_pdr_record *make_new_record(const pldm_pdr *repo,
 		hdr->record_handle = htole32(record->record_handle);
 	}
 	record->next = NULL;
+	record->prev = NULL;
+	record->hash_next = NULL;
 
 	return record;
 }
@@ -184,7 +301,7 @@ uint32_t pldm_pdr_add_hotplug_record(pldm_pdr *repo, const uint8_t *data,
 
 	pldm_pdr_record *record = make_new_record(
 	    repo, data, size, record_handle, is_remote, terminus_handle);
-	add_hotplug_record(repo, record, prev_record_handle);
+	add_record_after_record_handle(repo, record, prev_record_handle);
 	return record->record_handle;
 }
 
@@ -212,6 +329,10 @@ pldm_pdr *pldm_pdr_init()
 	repo->size = 0;
 	repo->first = NULL;
 	repo->last = NULL;
+	repo->generation = 0;
+	repo->index_size = PDR_INDEX_MIN_SIZE;
+	repo->index = calloc(repo->index_size, sizeof(*repo->index));
+	assert(repo->index != NULL);
 
 	return repo;
 }
@@ -223,13 +344,10 @@ void pldm_pdr_destroy(pldm_pdr *repo)
 	pldm_pdr_record *record = repo->first;
 	while (record != NULL) {
 		pldm_pdr_record *next = record->next;
-		if (record->data) {
-			free(record->data);
-			record->data = NULL;
-		}
-		free(record);
+		free_record(record);
 		record = next;
 	}
+	free(repo->index);
 	free(repo);
 }
 
@@ -243,19 +361,14 @@ const pldm_pdr_record *pldm_pdr_find_record(const pldm_pdr *repo,
 	assert(size != NULL);
 	assert(next_record_handle != NULL);
 
-	if (!record_handle && (repo->first != NULL)) {
-		record_handle = repo->first->record_handle;
-	}
-	pldm_pdr_record *record = repo->first;
-	while (record != NULL) {
-		if (record->record_handle == record_handle) {
-			*size = record->size;
-			*data = record->data;
-			*next_record_handle =
-			    get_next_record_handle(repo, record);
-			return record;
-		}
-		record = record->next;
+	pldm_pdr_record *record = record_handle
+				      ? index_find(repo, record_handle)
+				      : repo->first;
+	if (record != NULL) {
+		*size = record->size;
+		*data = record->data;
+		*next_record_handle = get_next_record_handle(repo, record);
+		return record;
 	}
 
 	*size = 0;
@@ -268,17 +381,14 @@ bool pldm_pdr_find_prev_record_handle(pldm_pdr *repo, uint32_t record_handle,
 {
 
 	assert(repo != NULL);
-	pldm_pdr_record *curr = repo->first;
-	pldm_pdr_record *prev = repo->first;
-	while (curr != NULL) {
-		if (curr->record_handle == record_handle) {
-			*prev_record_handle = prev->record_handle;
-			return true;
-		}
-		prev = curr;
-		curr = curr->next;
+	pldm_pdr_record *curr = index_find(repo, record_handle);
+	if (curr == NULL) {
+		return false;
 	}
-	return false;
+	/* The first record is reported as its own predecessor */
+	*prev_record_handle = curr->prev != NULL ? curr->prev->record_handle
+						 : curr->record_handle;
+	return true;
 }
 
 const pldm_pdr_record *
@@ -348,6 +458,13 @@ uint32_t pldm_pdr_get_repo_size(const pldm_pdr *repo)
 	return repo->size;
 }
 
+uint32_t pldm_pdr_get_generation(const pldm_pdr *repo)
+{
+	assert(repo != NULL);
+
+	return repo->generation;
+}
+
 uint32_t pldm_pdr_get_record_handle(const pldm_pdr *repo,
 				    const pldm_pdr_record *record)
 {
@@ -447,7 +564,6 @@ uint32_t pldm_pdr_remove_fru_record_set_by_rsi(pldm_pdr *repo, uint16_t fru_rsi,
 
 	uint32_t delete_hdl = 0;
 	pldm_pdr_record *record = repo->first;
-	pldm_pdr_record *prev = NULL;
 	while (record != NULL) {
 		pldm_pdr_record *next = record->next;
 		struct pldm_pdr_hdr *hdr = (struct pldm_pdr_hdr *)record->data;
@@ -459,27 +575,9 @@ uint32_t pldm_pdr_remove_fru_record_set_by_rsi(pldm_pdr *repo, uint16_t fru_rsi,
 				    sizeof(struct pldm_pdr_hdr));
 			if (fru->fru_rsi == fru_rsi) {
 				delete_hdl = hdr->record_handle;
-				if (repo->first == record) {
-					repo->first = next;
-				} else {
-					prev->next = next;
-				}
-				if (repo->last == record) {
-					repo->last = prev;
-					prev->next = NULL; // sm00
-				}
-				--repo->record_count;
-				repo->size -= record->size;
-				if (record->data) {
-					free(record->data);
-				}
-				free(record);
+				delete_record(repo, record);
 				break;
-			} else {
-				prev = record;
 			}
-		} else {
-			prev = record;
 		}
 		record = next;
 	}
@@ -518,32 +616,14 @@ void pldm_delete_by_record_handle(pldm_pdr *repo, uint32_t record_handle,
 {
 	assert(repo != NULL);
 
-	pldm_pdr_record *record = repo->first;
-	pldm_pdr_record *prev = NULL;
+	pldm_pdr_record *record = index_find(repo, record_handle);
 	while (record != NULL) {
-		pldm_pdr_record *next = record->next;
-		struct pldm_pdr_hdr *hdr = (struct pldm_pdr_hdr *)record->data;
-		if ((record->is_remote == is_remote) &&
-		    (hdr->record_handle == record_handle)) {
-			if (repo->first == record) {
-				repo->first = next;
-			} else {
-				prev->next = next;
-			}
-			if (repo->last == record) {
-				repo->last = prev;
-			}
-			if (record->data) {
-				free(record->data);
-			}
-			--repo->record_count;
-			repo->size -= record->size;
-			free(record);
+		if ((record->record_handle == record_handle) &&
+		    (record->is_remote == is_remote)) {
+			delete_record(repo, record);
 			break;
-		} else {
-			prev = record;
 		}
-		record = next;
+		record = record->hash_next;
 	}
 }
 
@@ -553,11 +633,11 @@ pldm_entity pldm_get_entity_from_record_handle(const pldm_pdr *repo,
 	assert(repo != NULL);
 	pldm_entity element = {0, 0, 0};
 
-	pldm_pdr_record *record = repo->first;
+	pldm_pdr_record *record = index_find(repo, record_handle);
 
 	while (record != NULL) {
 		struct pldm_pdr_hdr *hdr = (struct pldm_pdr_hdr *)record->data;
-		if (hdr->record_handle == record_handle) {
+		if (record->record_handle == record_handle) {
 			switch (hdr->type) {
 			case (PLDM_PDR_FRU_RECORD_SET): {
 				struct pldm_pdr_fru_record_set *pdr =
@@ -604,7 +684,7 @@ pldm_entity pldm_get_entity_from_record_handle(const pldm_pdr *repo,
 				break;
 			}
 		}
-		record = record->next;
+		record = record->hash_next;
 	}
 	return element;
 }
@@ -746,7 +826,6 @@ uint16_t pldm_delete_by_effecter_id(pldm_pdr *repo, uint16_t effecter_id,
 
 	uint32_t delete_handle = 0;
 	pldm_pdr_record *record = repo->first;
-	pldm_pdr_record *prev = NULL;
 	while (record != NULL) {
 		pldm_pdr_record *next = record->next;
 		struct pldm_pdr_hdr *hdr = (struct pldm_pdr_hdr *)record->data;
@@ -757,27 +836,9 @@ uint16_t pldm_delete_by_effecter_id(pldm_pdr *repo, uint16_t effecter_id,
 								   ->data);
 			if (pdr->effecter_id == effecter_id) {
 				delete_handle = hdr->record_handle;
-				if (repo->first == record) {
-					repo->first = next;
-				} else {
-					prev->next = next;
-				}
-				if (repo->last == record) {
-					repo->last = prev;
-					prev->next = NULL;
-				}
-				--repo->record_count;
-				repo->size -= record->size;
-				if (record->data) {
-					free(record->data);
-				}
-				free(record);
+				delete_record(repo, record);
 				break;
-			} else {
-				prev = record;
 			}
-		} else {
-			prev = record;
 		}
 		record = next;
 	}
@@ -791,7 +852,6 @@ uint16_t pldm_delete_by_sensor_id(pldm_pdr *repo, uint16_t sensor_id,
 
 	uint32_t delete_handle = 0;
 	pldm_pdr_record *record = repo->first;
-	pldm_pdr_record *prev = NULL;
 	while (record != NULL) {
 		pldm_pdr_record *next = record->next;
 		struct pldm_pdr_hdr *hdr = (struct pldm_pdr_hdr *)record->data;
@@ -802,27 +862,9 @@ uint16_t pldm_delete_by_sensor_id(pldm_pdr *repo, uint16_t sensor_id,
 								 record->data);
 			if (pdr->sensor_id == sensor_id) {
 				delete_handle = hdr->record_handle;
-				if (repo->first == record) {
-					repo->first = next;
-				} else {
-					prev->next = next;
-				}
-				if (repo->last == record) {
-					repo->last = prev;
-					prev->next = NULL;
-				}
-				--repo->record_count;
-				repo->size -= record->size;
-				if (record->data) {
-					free(record->data);
-				}
-				free(record);
+				delete_record(repo, record);
 				break;
-			} else {
-				prev = record;
 			}
-		} else {
-			prev = record;
 		}
 		record = next;
 	}
@@ -1416,15 +1458,14 @@ uint32_t pldm_entity_association_pdr_remove_contained_entity(
 	/*	printf("\npldm_entity_association_pdr_remove_contained_entity
 	   found " "the record handle to delete %d", updated_hdl);*/
 
-	pldm_pdr_record *record = repo->first;
-	pldm_pdr_record *prev = repo->first;
+	pldm_pdr_record *record = index_find(repo, updated_hdl);
 	pldm_pdr_record *new_record = malloc(sizeof(pldm_pdr_record));
 	new_record->data = NULL; // sm00
 	// new_record->data = malloc(record->size - sizeof(pldm_entity)); //sm00
 	// new_record->next = NULL; //sm00
 	// uint8_t *new_data = new_record->data; //sm00
 	while (record != NULL) {
-		pldm_pdr_record *next = record->next;
+		pldm_pdr_record *next = record->hash_next;
 		struct pldm_pdr_hdr *hdr = (struct pldm_pdr_hdr *)record->data;
 		if (record->record_handle ==
 		    updated_hdl) /*(record->is_remote == is_remote) &&*/
@@ -1437,6 +1478,7 @@ uint32_t pldm_entity_association_pdr_remove_contained_entity(
 			new_record->size =
 			    htole32(record->size - sizeof(pldm_entity)); // sm00
 			new_record->is_remote = record->is_remote;
+			new_record->terminus_handle = record->terminus_handle;
 			uint8_t *new_start = new_record->data; // sm00 new_data;
 			struct pldm_pdr_hdr *new_hdr =
 			    (struct pldm_pdr_hdr *)
@@ -1508,47 +1550,13 @@ uint32_t pldm_entity_association_pdr_remove_contained_entity(
 			{
 				removed = false;
 				*event_data_op = PLDM_RECORDS_DELETED;
-				if (repo->first == record) {
-					repo->first = record->next;
-					record->next = NULL;
-				} else if (repo->last == record) {
-					repo->last = prev;
-					prev->next = NULL;
-				} else {
-					prev->next = record->next;
-					record->next = NULL;
-				}
-				repo->size -= record->size;
-				repo->record_count--;
-				if (record->data) {
-					free(record->data);
-				}
-				free(record);
+				delete_record(repo, record);
 				break;
 			} else if (removed) {
-				if (repo->first == record) {
-					repo->first = new_record;
-					new_record->next = record->next;
-				} else {
-					prev->next = new_record;
-					new_record->next = record->next;
-					record->next = NULL; // sm00
-				}
-				if (repo->last == record) {
-					repo->last = new_record;
-					new_record->next = NULL; // sm00
-				}
-				repo->size -= record->size;
-				repo->size += new_record->size;
-
-				if (record->data) {
-					free(record->data);
-				}
-				free(record);
+				replace_record(repo, record, new_record);
 				break;
 			}
 		}
-		prev = record;
 		record = next;
 	}
 	if (!removed) {
@@ -1583,7 +1591,6 @@ uint32_t pldm_entity_association_pdr_add_contained_entity(
 	bool added = false;
 	*event_data_op = PLDM_RECORDS_MODIFIED;
 	pldm_pdr_record *record = repo->first;
-	pldm_pdr_record *prev = repo->first;
 	pldm_pdr_record *new_record = malloc(sizeof(pldm_pdr_record));
 	new_record->data = NULL; // sm00
 	// new_record->data = malloc(record->size + sizeof(pldm_entity)); //sm00
@@ -1615,6 +1622,8 @@ uint32_t pldm_entity_association_pdr_add_contained_entity(
 				new_record->size =
 				    htole32(record->size + sizeof(pldm_entity));
 				new_record->is_remote = record->is_remote;
+				new_record->terminus_handle =
+				    record->terminus_handle;
 				uint8_t *new_start = new_data;
 				struct pldm_pdr_hdr *new_hdr =
 				    (struct pldm_pdr_hdr *)new_data;
@@ -1667,28 +1676,11 @@ uint32_t pldm_entity_association_pdr_add_contained_entity(
 				    entity.entity_container_id;
 
 				added = true;
-				if (repo->first == record) {
-					repo->first = new_record;
-					new_record->next = record->next;
-				} else {
-					prev->next = new_record;
-					new_record->next = record->next;
-				}
-				if (repo->last == record) {
-					repo->last = new_record;
-				}
-				repo->size -= record->size;
-				repo->size += new_record->size;
-
-				if (record->data) {
-					free(record->data);
-				}
-				free(record);
+				replace_record(repo, record, new_record);
 				break;
 			}
 		}
 
-		prev = record;
 		record = next;
 	}
 	if (!found && !is_remote) // need to create a new entity assoc pdr
@@ -1697,15 +1689,9 @@ uint32_t pldm_entity_association_pdr_add_contained_entity(
 		uint8_t num_children = 1;
 		added = true;
 		*event_data_op = PLDM_RECORDS_ADDED;
-		prev = repo->first;
-		pldm_pdr_record *curr = repo->first;
-		while (curr != NULL) {
-			if (curr->record_handle == bmc_record_handle) {
-				// printf("\nfound the place \n");
-				break;
-			}
-			prev = curr;
-			curr = curr->next;
+		pldm_pdr_record *curr = index_find(repo, bmc_record_handle);
+		if (curr == NULL) {
+			curr = repo->last;
 		}
 
 		uint16_t new_pdr_size = sizeof(struct pldm_pdr_hdr) +
@@ -1716,13 +1702,9 @@ uint32_t pldm_entity_association_pdr_add_contained_entity(
 		new_record->record_handle = bmc_record_handle + 1;
 		new_record->size = new_pdr_size;
 		new_record->is_remote = false;
-		new_record->next = curr->next;
-		curr->next = new_record;
-		if (repo->last == prev) {
-			repo->last = new_record;
-		}
-		repo->size += new_record->size;
-		++repo->record_count;
+		new_record->terminus_handle =
+		    curr != NULL ? curr->terminus_handle : 0;
+		link_record(repo, curr, new_record);
 
 		updated_hdl = new_record->record_handle;
 
@@ -1801,26 +1783,10 @@ void pldm_pdr_remove_pdrs_by_terminus_handle(uint32_t terminus_handle,
 	assert(repo != NULL);
 
 	pldm_pdr_record *record = repo->first;
-	pldm_pdr_record *prev = NULL;
 	while (record != NULL) {
 		pldm_pdr_record *next = record->next;
 		if (record->terminus_handle == terminus_handle) {
-			if (repo->first == record) {
-				repo->first = next;
-			} else {
-				prev->next = next;
-			}
-			if (repo->last == record) {
-				repo->last = prev;
-			}
-			if (record->data) {
-				free(record->data);
-			}
-			--repo->record_count;
-			repo->size -= record->size;
-			free(record);
-		} else {
-			prev = record;
+			delete_record(repo, record);
 		}
 		record = next;
 	}
@@ -1832,27 +1798,11 @@ void pldm_pdr_remove_remote_pdrs(pldm_pdr *repo)
 	bool removed = false;
 
 	pldm_pdr_record *record = repo->first;
-	pldm_pdr_record *prev = NULL;
 	while (record != NULL) {
 		pldm_pdr_record *next = record->next;
 		if (record->is_remote == true) {
-			if (repo->first == record) {
-				repo->first = next;
-			} else {
-				prev->next = next;
-			}
-			if (repo->last == record) {
-				repo->last = prev;
-			}
-			if (record->data) {
-				free(record->data);
-			}
-			--repo->record_count;
-			repo->size -= record->size;
-			free(record);
+			delete_record(repo, record);
 			removed = true;
-		} else {
-			prev = record;
 		}
 		record = next;
 	}
@@ -1870,6 +1820,9 @@ void pldm_pdr_remove_remote_pdrs(pldm_pdr *repo)
 			}
 			record = record->next;
 		}
+		/* Every handle changed, so the index has to be rebuilt */
+		index_rebuild(repo, repo->index_size);
+		++repo->generation;
 	}
 }
 
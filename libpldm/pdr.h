@@ -44,6 +44,18 @@ uint32_t pldm_pdr_get_record_count(const pldm_pdr *repo);
  */
 uint32_t pldm_pdr_get_repo_size(const pldm_pdr *repo);
 
+/** @brief Get the generation of a PDR repository
+ *
+ *  The generation changes every time records are added to, removed from or
+ *  renumbered in the repository, so that callers can tell whether anything
+ *  they derived from the repository is still current.
+ *
+ *  @param[in] repo - opaque pointer acting as a PDR repo handle
+ *
+ *  @return uint32_t - generation of the repository
+ */
+uint32_t pldm_pdr_get_generation(const pldm_pdr *repo);
+
 /** @brief Add a PDR record to a PDR repository
  *
  *  @param[in/out] repo - opaque pointer acting as a PDR repo handle
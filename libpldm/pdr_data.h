@@ -14,6 +14,8 @@ typedef struct pldm_pdr_record {
 	uint32_t size;
 	uint8_t *data;
 	struct pldm_pdr_record *next;
+	struct pldm_pdr_record *prev;
+	struct pldm_pdr_record *hash_next;
 	bool is_remote;
 	uint16_t terminus_handle;
 } pldm_pdr_record;
@@ -23,6 +25,11 @@ typedef struct pldm_pdr {
 	uint32_t size;
 	pldm_pdr_record *first;
 	pldm_pdr_record *last;
+	/* record handle index: buckets of records chained via hash_next */
+	pldm_pdr_record **index;
+	uint32_t index_size;
+	/* bumped whenever records are added, removed or renumbered */
+	uint32_t generation;
 } pldm_pdr;
 
 /** @struct pldm_pdr
@@ -942,6 +942,89 @@ TEST(AttrValTable, CopyAndUpdateTest)
     EXPECT_EQ(rc, PLDM_ERROR_INVALID_LENGTH);
 }
 
+TEST(AttrValTable, UpdateInPlaceTest)
+{
+    std::vector<uint8_t> enumEntry{
+        0, 0, /* attr handle */
+        0,    /* attr type */
+        1,    /* number of current value */
+        0,    /* current value string handle index */
+    };
+    std::vector<uint8_t> stringEntry{
+        1,   0,        /* attr handle */
+        1,             /* attr type */
+        3,   0,        /* current string length */
+        'a', 'b', 'c', /* defaut value string handle index */
+    };
+    std::vector<uint8_t> integerEntry{
+        2,  0,                   /* attr handle */
+        3,                       /* attr type */
+        10, 0, 0, 0, 0, 0, 0, 0, /* current value */
+    };
+
+    Table table;
+    buildTable(table, enumEntry, stringEntry, integerEntry);
+    auto integerOffset = enumEntry.size() + stringEntry.size();
+
+    std::vector<uint8_t> integerEntry1{
+        2,  0,                   /* attr handle */
+        3,                       /* attr type */
+        42, 1, 0, 0, 0, 0, 0, 0, /* current value */
+    };
+    auto rc = pldm_bios_table_attr_value_update_in_place(
+        table.data(), table.size(), integerOffset, integerEntry1.data(),
+        integerEntry1.size());
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+
+    Table expectTable;
+    buildTable(expectTable, enumEntry, stringEntry, integerEntry1);
+    EXPECT_THAT(table, ElementsAreArray(expectTable));
+    EXPECT_TRUE(pldm_bios_table_checksum(table.data(), table.size()));
+
+    std::vector<uint8_t> enumEntry1{
+        0, 0, /* attr handle */
+        0,    /* attr type */
+        1,    /* number of current value */
+        3,    /* current value string handle index */
+    };
+    rc = pldm_bios_table_attr_value_update_in_place(
+        table.data(), table.size(), 0, enumEntry1.data(), enumEntry1.size());
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+    expectTable.resize(0);
+    buildTable(expectTable, enumEntry1, stringEntry, integerEntry1);
+    EXPECT_THAT(table, ElementsAreArray(expectTable));
+
+    // A string of another length changes the layout of the table
+    std::vector<uint8_t> stringEntry1{
+        1,   0,   /* attr handle */
+        1,        /* attr type */
+        2,   0,   /* current string length */
+        'd', 'e', /* defaut value string handle index */
+    };
+    rc = pldm_bios_table_attr_value_update_in_place(
+        table.data(), table.size(), enumEntry.size(), stringEntry1.data(),
+        stringEntry1.size());
+    EXPECT_EQ(rc, PLDM_ERROR_INVALID_LENGTH);
+
+    // The entry at the offset must be the one being updated
+    rc = pldm_bios_table_attr_value_update_in_place(
+        table.data(), table.size(), 0, integerEntry.data(),
+        integerEntry.size());
+    EXPECT_EQ(rc, PLDM_ERROR_INVALID_DATA);
+
+    rc = pldm_bios_table_attr_value_update_in_place(
+        table.data(), table.size(), table.size() - 4, enumEntry.data(),
+        enumEntry.size());
+    EXPECT_EQ(rc, PLDM_ERROR_INVALID_LENGTH);
+
+    // An entry longer than the table is rejected whatever the offset
+    std::vector<uint8_t> longEntry(table.size(), 0);
+    rc = pldm_bios_table_attr_value_update_in_place(
+        table.data(), table.size(), 0, longEntry.data(), longEntry.size());
+    EXPECT_EQ(rc, PLDM_ERROR_INVALID_LENGTH);
+    EXPECT_THAT(table, ElementsAreArray(expectTable));
+}
+
 TEST(StringTable, EntryEncodeTest)
 {
     std::vector<uint8_t> stringEntry{
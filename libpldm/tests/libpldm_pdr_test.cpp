@@ -329,6 +329,174 @@ TEST(PDRAccess, testGet)
     pldm_pdr_destroy(repo);
 }
 
+TEST(PDRAccess, testGetLargeRepoWalk)
+{
+    // Walk a large repo the way GetPDR does: start at handle 0 and follow
+    // next record handles until the end of the repo.
+    constexpr uint32_t numRecords = 10000;
+    std::array<uint8_t, sizeof(pldm_pdr_hdr) + 4> data{};
+    auto repo = pldm_pdr_init();
+    for (uint32_t i = 0; i < numRecords; ++i)
+    {
+        pldm_pdr_add(repo, data.data(), data.size(), 0, i % 2, 1);
+    }
+    EXPECT_EQ(pldm_pdr_get_record_count(repo), numRecords);
+
+    uint32_t size{};
+    uint32_t recordHandle = 0;
+    uint32_t nextRecHdl{};
+    uint8_t* outData = nullptr;
+    uint32_t count = 0;
+    do
+    {
+        auto record = pldm_pdr_find_record(repo, recordHandle, &outData,
+                                           &size, &nextRecHdl);
+        ASSERT_NE(record, nullptr);
+        EXPECT_EQ(pldm_pdr_get_record_handle(repo, record), count + 1);
+        EXPECT_EQ(size, data.size());
+        recordHandle = nextRecHdl;
+        ++count;
+    } while (recordHandle);
+    EXPECT_EQ(count, numRecords);
+
+    pldm_pdr_remove_remote_pdrs(repo);
+    EXPECT_EQ(pldm_pdr_get_record_count(repo), numRecords / 2);
+    auto record = pldm_pdr_find_record(repo, numRecords / 2, &outData, &size,
+                                       &nextRecHdl);
+    ASSERT_NE(record, nullptr);
+    EXPECT_EQ(nextRecHdl, 0u);
+    record = pldm_pdr_find_record(repo, numRecords / 2 + 1, &outData, &size,
+                                  &nextRecHdl);
+    EXPECT_EQ(record, nullptr);
+
+    pldm_pdr_destroy(repo);
+}
+
+TEST(PDRUpdate, testIndexedInsertDelete)
+{
+    std::array<uint8_t, sizeof(pldm_pdr_hdr) + 4> data{};
+    auto repo = pldm_pdr_init();
+    pldm_pdr_add(repo, data.data(), data.size(), 1, false, 1);
+    pldm_pdr_add(repo, data.data(), data.size(), 2, false, 1);
+    pldm_pdr_add(repo, data.data(), data.size(), 10, true, 2);
+
+    pldm_pdr_add_hotplug_record(repo, data.data(), data.size(), 3, false, 2,
+                                1);
+    pldm_pdr_add_after_prev_record(repo, data.data(), data.size(), 4, false,
+                                   10, 1);
+    EXPECT_EQ(pldm_pdr_get_record_count(repo), 5u);
+
+    uint32_t size{};
+    uint32_t nextRecHdl{};
+    uint8_t* outData = nullptr;
+    pldm_pdr_find_record(repo, 2, &outData, &size, &nextRecHdl);
+    EXPECT_EQ(nextRecHdl, 3u);
+    pldm_pdr_find_record(repo, 3, &outData, &size, &nextRecHdl);
+    EXPECT_EQ(nextRecHdl, 10u);
+    pldm_pdr_find_record(repo, 10, &outData, &size, &nextRecHdl);
+    EXPECT_EQ(nextRecHdl, 4u);
+
+    uint32_t prevRecHdl{};
+    EXPECT_TRUE(pldm_pdr_find_prev_record_handle(repo, 10, &prevRecHdl));
+    EXPECT_EQ(prevRecHdl, 3u);
+    EXPECT_TRUE(pldm_pdr_find_prev_record_handle(repo, 1, &prevRecHdl));
+    EXPECT_EQ(prevRecHdl, 1u);
+    EXPECT_FALSE(pldm_pdr_find_prev_record_handle(repo, 5, &prevRecHdl));
+
+    // Deleting requires the locality to match
+    pldm_delete_by_record_handle(repo, 10, false);
+    EXPECT_EQ(pldm_pdr_get_record_count(repo), 5u);
+    pldm_delete_by_record_handle(repo, 10, true);
+    EXPECT_EQ(pldm_pdr_get_record_count(repo), 4u);
+    EXPECT_EQ(pldm_pdr_find_record(repo, 10, &outData, &size, &nextRecHdl),
+              nullptr);
+    pldm_pdr_find_record(repo, 3, &outData, &size, &nextRecHdl);
+    EXPECT_EQ(nextRecHdl, 4u);
+
+    pldm_delete_by_record_handle(repo, 4, false);
+    EXPECT_EQ(pldm_pdr_add(repo, data.data(), data.size(), 0, false, 1), 4u);
+
+    pldm_pdr_remove_pdrs_by_terminus_handle(1, repo);
+    EXPECT_EQ(pldm_pdr_get_record_count(repo), 0u);
+    EXPECT_EQ(pldm_pdr_find_record(repo, 0, &outData, &size, &nextRecHdl),
+              nullptr);
+    EXPECT_EQ(pldm_pdr_add(repo, data.data(), data.size(), 0, false, 1), 1u);
+
+    pldm_pdr_destroy(repo);
+}
+
+TEST(PDRAccess, testDuplicateHandle)
+{
+    // Records sharing a handle are found in list order, whether or not the
+    // index was rebuilt since they were added
+    std::array<uint8_t, sizeof(pldm_pdr_hdr) + 4> data{};
+    auto repo = pldm_pdr_init();
+    pldm_pdr_add(repo, data.data(), data.size(), 1, false, 1);
+    data.back() = 1;
+    pldm_pdr_add(repo, data.data(), data.size(), 5, false, 1);
+    data.back() = 2;
+    pldm_pdr_add(repo, data.data(), data.size(), 5, true, 2);
+
+    uint32_t size{};
+    uint32_t nextRecHdl{};
+    uint8_t* outData = nullptr;
+    ASSERT_NE(pldm_pdr_find_record(repo, 5, &outData, &size, &nextRecHdl),
+              nullptr);
+    EXPECT_EQ(outData[size - 1], 1);
+
+    // Inserted ahead of both
+    data.back() = 3;
+    pldm_pdr_add_after_prev_record(repo, data.data(), data.size(), 5, false,
+                                   1, 1);
+    ASSERT_NE(pldm_pdr_find_record(repo, 5, &outData, &size, &nextRecHdl),
+              nullptr);
+    EXPECT_EQ(outData[size - 1], 3);
+    EXPECT_EQ(nextRecHdl, 5u);
+
+    // Growing the index rebuilds it
+    data.back() = 0;
+    for (int i = 0; i < 100; ++i)
+    {
+        pldm_pdr_add(repo, data.data(), data.size(), 0, false, 1);
+    }
+    ASSERT_NE(pldm_pdr_find_record(repo, 5, &outData, &size, &nextRecHdl),
+              nullptr);
+    EXPECT_EQ(outData[size - 1], 3);
+
+    pldm_delete_by_record_handle(repo, 5, false);
+    ASSERT_NE(pldm_pdr_find_record(repo, 5, &outData, &size, &nextRecHdl),
+              nullptr);
+    EXPECT_EQ(outData[size - 1], 1);
+
+    pldm_pdr_destroy(repo);
+}
+
+TEST(PDRAccess, testGeneration)
+{
+    std::array<uint8_t, 10> data{};
+    auto repo = pldm_pdr_init();
+    auto generation = pldm_pdr_get_generation(repo);
+
+    pldm_pdr_add(repo, data.data(), data.size(), 0, false, 1);
+    EXPECT_NE(pldm_pdr_get_generation(repo), generation);
+    generation = pldm_pdr_get_generation(repo);
+
+    pldm_pdr_add(repo, data.data(), data.size(), 0, true, 1);
+    EXPECT_NE(pldm_pdr_get_generation(repo), generation);
+    generation = pldm_pdr_get_generation(repo);
+
+    uint32_t size{};
+    uint32_t nextRecHdl{};
+    uint8_t* outData = nullptr;
+    pldm_pdr_find_record(repo, 1, &outData, &size, &nextRecHdl);
+    EXPECT_EQ(pldm_pdr_get_generation(repo), generation);
+
+    pldm_pdr_remove_remote_pdrs(repo);
+    EXPECT_NE(pldm_pdr_get_generation(repo), generation);
+
+    pldm_pdr_destroy(repo);
+}
+
 TEST(PDRAccess, testGetNext)
 {
     auto repo = pldm_pdr_init();
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cstring>
 #include <vector>
 
@@ -12,6 +13,27 @@ TEST(Crc32, CheckSumTest)
     EXPECT_EQ(checksum, 0xcbf43926);
 }
 
+TEST(Crc32, UpdateTest)
+{
+    std::vector<uint8_t> data(1000);
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = i * 7;
+    }
+    auto checksum = crc32(data.data(), data.size());
+
+    for (size_t offset : {0, 1, 500, 990})
+    {
+        std::vector<uint8_t> region{0xde, 0xad, 0xbe, 0xef, 0x00,
+                                    0x11, 0x22, 0x33, 0x44, 0x55};
+        auto tail = data.size() - offset - region.size();
+        checksum = crc32_update(checksum, data.data() + offset, region.data(),
+                                region.size(), tail);
+        std::copy(region.begin(), region.end(), data.begin() + offset);
+        EXPECT_EQ(checksum, crc32(data.data(), data.size()));
+    }
+}
+
 TEST(Crc8, CheckSumTest)
 {
     const char* data = "123456789";
@@ -89,6 +89,80 @@ uint32_t crc32(const void *data, size_t size)
 	return crc ^ ~0U;
 }
 
+/* Multiply the 32x32 GF(2) matrix mat by the vector vec */
+static uint32_t gf2_matrix_times(const uint32_t *mat, uint32_t vec)
+{
+	uint32_t sum = 0;
+	while (vec) {
+		if (vec & 1)
+			sum ^= *mat;
+		vec >>= 1;
+		mat++;
+	}
+	return sum;
+}
+
+static void gf2_matrix_square(uint32_t *square, const uint32_t *mat)
+{
+	int n;
+	for (n = 0; n < 32; n++)
+		square[n] = gf2_matrix_times(mat, mat[n]);
+}
+
+/* Feed len zero bytes through a raw (no pre/post inversion) CRC32 register,
+ * in O(log(len)) rather than O(len) */
+static uint32_t crc32_shift_zeros(uint32_t crc, size_t len)
+{
+	uint32_t even[32]; /* even-power-of-two zeros operator */
+	uint32_t odd[32];  /* odd-power-of-two zeros operator */
+	uint32_t row = 1;
+	int n;
+
+	if (crc == 0 || len == 0)
+		return crc;
+
+	/* operator for one zero bit */
+	odd[0] = 0xedb88320;
+	for (n = 1; n < 32; n++) {
+		odd[n] = row;
+		row <<= 1;
+	}
+	gf2_matrix_square(even, odd); /* two zero bits */
+	gf2_matrix_square(odd, even); /* four zero bits */
+
+	do {
+		gf2_matrix_square(even, odd);
+		if (len & 1)
+			crc = gf2_matrix_times(even, crc);
+		len >>= 1;
+		if (len == 0)
+			break;
+		gf2_matrix_square(odd, even);
+		if (len & 1)
+			crc = gf2_matrix_times(odd, crc);
+		len >>= 1;
+	} while (len != 0);
+
+	return crc;
+}
+
+uint32_t crc32_update(uint32_t crc, const void *old_data, const void *new_data,
+		      size_t size, size_t tail_size)
+{
+	const uint8_t *o = old_data;
+	const uint8_t *n = new_data;
+	uint32_t delta = 0;
+
+	/* CRC32 is affine, so for two messages of the same length the
+	 * difference of their CRCs is the raw CRC of the XOR of the messages.
+	 * Leading zeros leave a zero register untouched, so only the modified
+	 * region and the zeros that follow it need to be processed. */
+	while (size--)
+		delta = crc32_tab[(delta ^ *o++ ^ *n++) & 0xff] ^ (delta >> 8);
+
+	return crc ^ crc32_shift_zeros(delta, tail_size);
+}
+
 uint8_t crc8(const void *data, size_t size)
 {
 	const uint8_t *p = data;
@@ -35,6 +35,18 @@ uint8_t crc8(const void *data, size_t size);
  */
 uint32_t crc32(const void *data, size_t size);
 
+/** @brief Update a Crc32 after a region of the data is modified in place
+ *
+ *  @param[in] crc - Crc32 of the data before the modification
+ *  @param[in] old_data - Pointer to the region before the modification
+ *  @param[in] new_data - Pointer to the region after the modification
+ *  @param[in] size - Size of the modified region
+ *  @param[in] tail_size - Number of bytes following the modified region
+ *  @return The checksum of the modified data
+ */
+uint32_t crc32_update(uint32_t crc, const void *old_data, const void *new_data,
+		      size_t size, size_t tail_size);
+
 /** @brief Convert ver32_t to string
  *  @param[in] version - Pointer to ver32_t
  *  @param[out] buffer - Pointer to the buffer
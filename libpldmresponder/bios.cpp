@@ -1,5 +1,6 @@
 #include "bios.hpp"
 
+#include "common/deferred_response.hpp"
 #include "common/utils.hpp"
 
 #include <time.h>
@@ -71,8 +72,15 @@ DBusHandler dbusHandler;
 
 Handler::Handler(int fd, uint8_t eid, dbus_api::Requester* requester,
                  pldm::requester::Handler<pldm::requester::Request>* handler) :
-    biosConfig(BIOS_JSONS_DIR, BIOS_TABLES_DIR, &dbusHandler, fd, eid,
-               requester, handler)
+    Handler(BIOS_JSONS_DIR, BIOS_TABLES_DIR, &dbusHandler, fd, eid, requester,
+            handler)
+{}
+
+Handler::Handler(const char* jsonDir, const char* tableDir,
+                 pldm::utils::DBusHandler* dbusHandler, int fd, uint8_t eid,
+                 dbus_api::Requester* requester,
+                 pldm::requester::Handler<pldm::requester::Request>* handler) :
+    biosConfig(jsonDir, tableDir, dbusHandler, fd, eid, requester, handler)
 {
     biosConfig.removeTables();
     biosConfig.buildTables();
@@ -209,20 +217,49 @@ Response Handler::getBIOSTable(const pldm_msg* request, size_t payloadLength)
         return ccOnlyResponse(request, rc);
     }
 
-    auto table =
-        biosConfig.getBIOSTable(static_cast<pldm_bios_table_types>(tableType));
-    if (!table)
+    if (transferOpFlag != PLDM_GET_FIRSTPART &&
+        transferOpFlag != PLDM_GET_NEXTPART)
     {
-        return ccOnlyResponse(request, PLDM_BIOS_TABLE_UNAVAILABLE);
+        return ccOnlyResponse(request,
+                              PLDM_INVALID_BIOS_TRANSFER_OPERATION_FLAG);
+    }
+
+    auto type = static_cast<pldm_bios_table_types>(tableType);
+    auto& transfer = getTableTransfer(type);
+    // A GetNextPart with handle 0 starts a transfer too, as requesters have
+    // been getting the whole table that way
+    if (transferOpFlag == PLDM_GET_FIRSTPART || transferHandle == 0)
+    {
+        auto table = biosConfig.getBIOSTable(type);
+        if (!table)
+        {
+            return ccOnlyResponse(request, PLDM_BIOS_TABLE_UNAVAILABLE);
+        }
+        transfer.startGet(std::move(*table));
+        transferHandle = 0;
+    }
+    else if (!transfer.isGetInProgress())
+    {
+        return ccOnlyResponse(request, PLDM_INVALID_BIOS_DATA_TRANSFER_HANDLE);
+    }
+
+    Table part;
+    uint32_t nextTransferHandle{};
+    uint8_t transferFlag{};
+    rc = transfer.getPart(transferHandle, BIOS_TABLE_MAX_PART_SIZE, part,
+                          nextTransferHandle, transferFlag);
+    if (rc != PLDM_SUCCESS)
+    {
+        return ccOnlyResponse(request, rc);
     }
 
     Response response(sizeof(pldm_msg_hdr) +
-                      PLDM_GET_BIOS_TABLE_MIN_RESP_BYTES + table->size());
+                      PLDM_GET_BIOS_TABLE_MIN_RESP_BYTES + part.size());
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     rc = encode_get_bios_table_resp(
-        request->hdr.instance_id, PLDM_SUCCESS, 0 /* nxtTransferHandle */,
-        PLDM_START_AND_END, table->data(), response.size(), responsePtr);
+        request->hdr.instance_id, PLDM_SUCCESS, nextTransferHandle,
+        transferFlag, part.data(), response.size(), responsePtr);
     if (rc != PLDM_SUCCESS)
     {
         return ccOnlyResponse(request, rc);
@@ -231,6 +268,16 @@ Response Handler::getBIOSTable(const pldm_msg* request, size_t payloadLength)
     return response;
 }
 
+BIOSTableTransfer& Handler::getTableTransfer(pldm_bios_table_types tableType)
+{
+    // Requests handled outside of the daemon's receive loop have no requester
+    auto eid =
+        pldm::deferred::DeferredResponse::GetInstance().requester().value_or(0);
+    return tableTransfers
+        .try_emplace(std::make_pair(eid, tableType), BIOS_TABLE_MAX_SIZE)
+        .first->second;
+}
+
 Response Handler::setBIOSTable(const pldm_msg* request, size_t payloadLength)
 {
     uint32_t transferHandle{};
@@ -245,18 +292,36 @@ Response Handler::setBIOSTable(const pldm_msg* request, size_t payloadLength)
         return ccOnlyResponse(request, rc);
     }
 
-    Table table(field.ptr, field.ptr + field.length);
-    rc = biosConfig.setBIOSTable(tableType, table);
+    if (tableType > PLDM_BIOS_ATTR_VAL_TABLE)
+    {
+        return ccOnlyResponse(request, PLDM_INVALID_BIOS_TABLE_TYPE);
+    }
+
+    auto& transfer =
+        getTableTransfer(static_cast<pldm_bios_table_types>(tableType));
+    uint32_t nextTransferHandle{};
+    std::optional<Table> table;
+    rc = transfer.setPart(transferHandle, transferOpFlag, field,
+                          nextTransferHandle, table);
     if (rc != PLDM_SUCCESS)
     {
         return ccOnlyResponse(request, rc);
     }
 
+    if (table)
+    {
+        rc = biosConfig.setBIOSTable(tableType, *table);
+        if (rc != PLDM_SUCCESS)
+        {
+            return ccOnlyResponse(request, rc);
+        }
+    }
+
     Response response(sizeof(pldm_msg_hdr) + PLDM_SET_BIOS_TABLE_RESP_BYTES);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     rc = encode_set_bios_table_resp(request->hdr.instance_id, PLDM_SUCCESS,
-                                    0 /* nxtTransferHandle */, responsePtr);
+                                    nextTransferHandle, responsePtr);
     if (rc != PLDM_SUCCESS)
     {
         return ccOnlyResponse(request, rc);
@@ -280,14 +345,12 @@ Response Handler::getBIOSAttributeCurrentValueByHandle(const pldm_msg* request,
         return ccOnlyResponse(request, rc);
     }
 
-    auto table = biosConfig.getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE);
-    if (!table)
+    if (!biosConfig.hasBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE))
     {
         return ccOnlyResponse(request, PLDM_BIOS_TABLE_UNAVAILABLE);
     }
 
-    auto entry = pldm_bios_table_attr_value_find_by_handle(
-        table->data(), table->size(), attributeHandle);
+    auto entry = biosConfig.findAttrValueEntry(attributeHandle);
     if (entry == nullptr)
     {
         return ccOnlyResponse(request, PLDM_INVALID_BIOS_ATTR_HANDLE);
@@ -40,6 +40,21 @@ class Handler : public CmdHandler
     Handler(int fd, uint8_t eid, dbus_api::Requester* requester,
             pldm::requester::Handler<pldm::requester::Request>* handler);
 
+    /** @brief Constructor
+     *
+     *  @param[in] jsonDir - directory of the BIOS attribute JSONs
+     *  @param[in] tableDir - directory of the persistent BIOS tables
+     *  @param[in] dbusHandler - D-Bus handler
+     *  @param[in] fd - socket descriptor to communicate to host
+     *  @param[in] eid - MCTP EID of host firmware
+     *  @param[in] requester - pointer to Requester object
+     *  @param[in] handler - PLDM request handler
+     */
+    Handler(const char* jsonDir, const char* tableDir,
+            pldm::utils::DBusHandler* dbusHandler, int fd, uint8_t eid,
+            dbus_api::Requester* requester,
+            pldm::requester::Handler<pldm::requester::Request>* handler);
+
     /** @brief Handler for GetDateTime
      *
      *  @param[in] request - Request message payload
@@ -89,8 +104,32 @@ class Handler : public CmdHandler
     Response setBIOSAttributeCurrentValue(const pldm_msg* request,
                                           size_t payloadLength);
 
+    /** @brief Persist the attribute value table now if it has changes not
+     *         written yet, as on shutdown
+     */
+    void flushAttrValueTable()
+    {
+        biosConfig.flushAttrValueTable();
+    }
+
   private:
     BIOSConfig biosConfig;
+
+    /** @brief Multipart GetBIOSTable/SetBIOSTable transfers per requester
+     *         EID and table type, so that concurrent transfers of the same
+     *         table do not move each other's offset
+     */
+    std::map<std::pair<mctp_eid_t, pldm_bios_table_types>, BIOSTableTransfer>
+        tableTransfers;
+
+    /** @brief Get the transfer of a table with the requester of the request
+     *         being handled
+     *
+     *  @param[in] tableType - BIOS table type
+     *
+     *  @return the transfer
+     */
+    BIOSTableTransfer& getTableTransfer(pldm_bios_table_types tableType);
 };
 
 } // namespace bios
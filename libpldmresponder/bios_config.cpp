@@ -38,6 +38,41 @@ constexpr auto stringTableFile = "stringTable";
 constexpr auto attrTableFile = "attributeTable";
 constexpr auto attrValueTableFile = "attributeValueTable";
 
+/** @class ResidentStringTable
+ *  @brief BIOSStringTable that resolves strings through the indexed string
+ *         table kept by BIOSConfig, instead of copying the table.
+ */
+class ResidentStringTable : public BIOSStringTable
+{
+  public:
+    explicit ResidentStringTable(BIOSConfig& biosConfig) :
+        BIOSStringTable(Table{}), biosConfig(biosConfig)
+    {}
+
+    std::string findString(uint16_t handle) const override
+    {
+        auto stringEntry = biosConfig.findStringEntry(handle);
+        if (stringEntry == nullptr)
+        {
+            throw std::invalid_argument("Invalid String Handle");
+        }
+        return table::string::decodeString(stringEntry);
+    }
+
+    uint16_t findHandle(const std::string& name) const override
+    {
+        auto handle = biosConfig.findStringHandle(name);
+        if (!handle)
+        {
+            throw std::invalid_argument("Invalid String Name");
+        }
+        return *handle;
+    }
+
+  private:
+    BIOSConfig& biosConfig;
+};
+
 } // namespace
 
 BIOSConfig::BIOSConfig(
@@ -46,7 +81,12 @@ BIOSConfig::BIOSConfig(
     pldm::requester::Handler<pldm::requester::Request>* handler) :
     jsonDir(jsonDir),
     tableDir(tableDir), dbusHandler(dbusHandler), fd(fd), eid(eid),
-    requester(requester), handler(handler)
+    requester(requester), handler(handler),
+    attrValueTablePersistTimer(
+        sdeventplus::Event::get_default(),
+        [this](sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>&) {
+            flushAttrValueTable();
+        })
 
 {
     fs::create_directories(tableDir);
@@ -54,6 +94,11 @@ BIOSConfig::BIOSConfig(
     listenPendingAttributes();
 }
 
+BIOSConfig::~BIOSConfig()
+{
+    flushAttrValueTable();
+}
+
 void BIOSConfig::buildTables()
 {
     auto stringTable = buildAndStoreStringTable();
@@ -65,29 +110,22 @@ void BIOSConfig::buildTables()
 
 std::optional<Table> BIOSConfig::getBIOSTable(pldm_bios_table_types tableType)
 {
-    fs::path tablePath;
-    switch (tableType)
+    auto table = getCachedTable(tableType);
+    if (!table)
     {
-        case PLDM_BIOS_STRING_TABLE:
-            tablePath = tableDir / stringTableFile;
-            break;
-        case PLDM_BIOS_ATTR_TABLE:
-            tablePath = tableDir / attrTableFile;
-            break;
-        case PLDM_BIOS_ATTR_VAL_TABLE:
-            tablePath = tableDir / attrValueTableFile;
-            break;
+        return std::nullopt;
     }
-    return loadTable(tablePath);
+    return *table;
+}
+
+bool BIOSConfig::hasBIOSTable(pldm_bios_table_types tableType)
+{
+    return getCachedTable(tableType) != nullptr;
 }
 
 int BIOSConfig::setBIOSTable(uint8_t tableType, const Table& table,
                              bool updateBaseBIOSTable)
 {
-    fs::path stringTablePath(tableDir / stringTableFile);
-    fs::path attrTablePath(tableDir / attrTableFile);
-    fs::path attrValueTablePath(tableDir / attrValueTableFile);
-
     if (!pldm_bios_table_checksum(table.data(), table.size()))
     {
         return PLDM_INVALID_BIOS_TABLE_DATA_INTEGRITY_CHECK;
@@ -95,12 +133,11 @@ int BIOSConfig::setBIOSTable(uint8_t tableType, const Table& table,
 
     if (tableType == PLDM_BIOS_STRING_TABLE)
     {
-        storeTable(stringTablePath, table);
+        storeTable(PLDM_BIOS_STRING_TABLE, table);
     }
     else if (tableType == PLDM_BIOS_ATTR_TABLE)
     {
-        BIOSTable biosStringTable(stringTablePath.c_str());
-        if (biosStringTable.isEmpty())
+        if (!getCachedTable(PLDM_BIOS_STRING_TABLE))
         {
             return PLDM_INVALID_BIOS_TABLE_TYPE;
         }
@@ -111,13 +148,12 @@ int BIOSConfig::setBIOSTable(uint8_t tableType, const Table& table,
             return rc;
         }
 
-        storeTable(attrTablePath, table);
+        storeTable(PLDM_BIOS_ATTR_TABLE, table);
     }
     else if (tableType == PLDM_BIOS_ATTR_VAL_TABLE)
     {
-        BIOSTable biosStringTable(stringTablePath.c_str());
-        BIOSTable biosStringValueTable(attrTablePath.c_str());
-        if (biosStringTable.isEmpty() || biosStringValueTable.isEmpty())
+        if (!getCachedTable(PLDM_BIOS_STRING_TABLE) ||
+            !getCachedTable(PLDM_BIOS_ATTR_TABLE))
         {
             return PLDM_INVALID_BIOS_TABLE_TYPE;
         }
@@ -128,7 +164,7 @@ int BIOSConfig::setBIOSTable(uint8_t tableType, const Table& table,
             return rc;
         }
 
-        storeTable(attrValueTablePath, table);
+        storeTable(PLDM_BIOS_ATTR_VAL_TABLE, table);
     }
     else
     {
@@ -146,15 +182,13 @@ int BIOSConfig::setBIOSTable(uint8_t tableType, const Table& table,
 int BIOSConfig::checkAttributeTable(const Table& table)
 {
     using namespace pldm::bios::utils;
-    auto stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
     for (auto entry :
          BIOSTableIter<PLDM_BIOS_ATTR_TABLE>(table.data(), table.size()))
     {
         auto attrNameHandle =
             pldm_bios_table_attr_entry_decode_string_handle(entry);
 
-        auto stringEnty = pldm_bios_table_string_find_by_handle(
-            stringTable->data(), stringTable->size(), attrNameHandle);
+        auto stringEnty = findStringEntry(attrNameHandle);
         if (stringEnty == nullptr)
         {
             return PLDM_INVALID_BIOS_ATTR_HANDLE;
@@ -181,8 +215,7 @@ int BIOSConfig::checkAttributeTable(const Table& table)
 
                 for (size_t i = 0; i < pvHandls.size(); i++)
                 {
-                    auto stringEntry = pldm_bios_table_string_find_by_handle(
-                        stringTable->data(), stringTable->size(), pvHandls[i]);
+                    auto stringEntry = findStringEntry(pvHandls[i]);
                     if (stringEntry == nullptr)
                     {
                         return PLDM_INVALID_BIOS_ATTR_HANDLE;
@@ -191,9 +224,8 @@ int BIOSConfig::checkAttributeTable(const Table& table)
 
                 for (size_t i = 0; i < defIndices.size(); i++)
                 {
-                    auto stringEntry = pldm_bios_table_string_find_by_handle(
-                        stringTable->data(), stringTable->size(),
-                        pvHandls[defIndices[i]]);
+                    auto stringEntry =
+                        findStringEntry(pvHandls[defIndices[i]]);
                     if (stringEntry == nullptr)
                     {
                         return PLDM_INVALID_BIOS_ATTR_HANDLE;
@@ -219,207 +251,200 @@ int BIOSConfig::checkAttributeTable(const Table& table)
 int BIOSConfig::checkAttributeValueTable(const Table& table)
 {
     using namespace pldm::bios::utils;
-    auto stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
-    auto attrTable = getBIOSTable(PLDM_BIOS_ATTR_TABLE);
 
     baseBIOSTableMaps.clear();
 
     for (auto tableEntry :
          BIOSTableIter<PLDM_BIOS_ATTR_VAL_TABLE>(table.data(), table.size()))
     {
-        AttributeName attributeName{};
-        AttributeType attributeType{};
-        ReadonlyStatus readonlyStatus{};
-        DisplayName displayName{};
-        Description description{};
-        MenuPath menuPath{};
-        CurrentValue currentValue{};
-        DefaultValue defaultValue{};
-        Option options{};
-
-        auto attrValueHandle =
-            pldm_bios_table_attr_value_entry_decode_attribute_handle(
-                tableEntry);
-        auto attrType = static_cast<pldm_bios_attribute_type>(
-            pldm_bios_table_attr_value_entry_decode_attribute_type(tableEntry));
-
-        auto attrEntry = pldm_bios_table_attr_find_by_handle(
-            attrTable->data(), attrTable->size(), attrValueHandle);
-        if (attrEntry == nullptr)
-        {
-            return PLDM_INVALID_BIOS_ATTR_HANDLE;
-        }
-        auto attrHandle =
-            pldm_bios_table_attr_entry_decode_attribute_handle(attrEntry);
-        auto attrNameHandle =
-            pldm_bios_table_attr_entry_decode_string_handle(attrEntry);
-
-        auto stringEntry = pldm_bios_table_string_find_by_handle(
-            stringTable->data(), stringTable->size(), attrNameHandle);
-        if (stringEntry == nullptr)
-        {
-            return PLDM_INVALID_BIOS_ATTR_HANDLE;
-        }
-        auto strLength =
-            pldm_bios_table_string_entry_decode_string_length(stringEntry);
-        std::vector<char> buffer(strLength + 1 /* sizeof '\0' */);
-        pldm_bios_table_string_entry_decode_string(stringEntry, buffer.data(),
-                                                   buffer.size());
-        attributeName = std::string(buffer.data(), buffer.data() + strLength);
-
-        if (!biosAttributes.empty())
+        auto rc = updateBaseBIOSTableEntry(tableEntry);
+        if (rc != PLDM_SUCCESS)
         {
-            readonlyStatus =
-                biosAttributes[attrHandle % biosAttributes.size()]->readOnly;
-            description =
-                biosAttributes[attrHandle % biosAttributes.size()]->helpText;
-            displayName =
-                biosAttributes[attrHandle % biosAttributes.size()]->displayName;
+            return rc;
         }
+    }
 
-        switch (attrType)
-        {
-            case PLDM_BIOS_ENUMERATION:
-            case PLDM_BIOS_ENUMERATION_READ_ONLY:
-            {
-                auto getValue = [](uint16_t handle,
-                                   const Table& table) -> std::string {
-                    auto stringEntry = pldm_bios_table_string_find_by_handle(
-                        table.data(), table.size(), handle);
-
-                    auto strLength =
-                        pldm_bios_table_string_entry_decode_string_length(
-                            stringEntry);
-                    std::vector<char> buffer(strLength + 1 /* sizeof '\0' */);
-                    pldm_bios_table_string_entry_decode_string(
-                        stringEntry, buffer.data(), buffer.size());
-
-                    return std::string(buffer.data(),
-                                       buffer.data() + strLength);
-                };
-
-                attributeType = "xyz.openbmc_project.BIOSConfig.Manager."
-                                "AttributeType.Enumeration";
+    return PLDM_SUCCESS;
+}
 
-                auto pvNum =
-                    pldm_bios_table_attr_entry_enum_decode_pv_num(attrEntry);
-                std::vector<uint16_t> pvHandls(pvNum);
-                pldm_bios_table_attr_entry_enum_decode_pv_hdls(
-                    attrEntry, pvHandls.data(), pvHandls.size());
+int BIOSConfig::updateBaseBIOSTableEntry(
+    const pldm_bios_attr_val_table_entry* tableEntry)
+{
+    AttributeName attributeName{};
+    AttributeType attributeType{};
+    ReadonlyStatus readonlyStatus{};
+    DisplayName displayName{};
+    Description description{};
+    MenuPath menuPath{};
+    CurrentValue currentValue{};
+    DefaultValue defaultValue{};
+    Option options{};
+
+    auto attrValueHandle =
+        pldm_bios_table_attr_value_entry_decode_attribute_handle(tableEntry);
+    auto attrType = static_cast<pldm_bios_attribute_type>(
+        pldm_bios_table_attr_value_entry_decode_attribute_type(tableEntry));
+
+    auto attrEntry = findAttrEntry(attrValueHandle);
+    if (attrEntry == nullptr)
+    {
+        return PLDM_INVALID_BIOS_ATTR_HANDLE;
+    }
+    auto attrHandle =
+        pldm_bios_table_attr_entry_decode_attribute_handle(attrEntry);
+    auto attrNameHandle =
+        pldm_bios_table_attr_entry_decode_string_handle(attrEntry);
 
-                // get possible_value
-                for (size_t i = 0; i < pvHandls.size(); i++)
-                {
-                    options.push_back(
-                        std::make_tuple("xyz.openbmc_project.BIOSConfig."
-                                        "Manager.BoundType.OneOf",
-                                        getValue(pvHandls[i], *stringTable)));
-                }
+    auto stringEntry = findStringEntry(attrNameHandle);
+    if (stringEntry == nullptr)
+    {
+        return PLDM_INVALID_BIOS_ATTR_HANDLE;
+    }
+    attributeName = table::string::decodeString(stringEntry);
 
-                auto count =
-                    pldm_bios_table_attr_value_entry_enum_decode_number(
-                        tableEntry);
-                std::vector<uint8_t> handles(count);
-                pldm_bios_table_attr_value_entry_enum_decode_handles(
-                    tableEntry, handles.data(), handles.size());
+    if (!biosAttributes.empty())
+    {
+        readonlyStatus =
+            biosAttributes[attrHandle % biosAttributes.size()]->readOnly;
+        description =
+            biosAttributes[attrHandle % biosAttributes.size()]->helpText;
+        displayName =
+            biosAttributes[attrHandle % biosAttributes.size()]->displayName;
+    }
 
-                // get current_value
-                for (size_t i = 0; i < handles.size(); i++)
+    switch (attrType)
+    {
+        case PLDM_BIOS_ENUMERATION:
+        case PLDM_BIOS_ENUMERATION_READ_ONLY:
+        {
+            auto getValue = [this](uint16_t handle) -> std::string {
+                auto stringEntry = findStringEntry(handle);
+                if (stringEntry == nullptr)
                 {
-                    currentValue = getValue(pvHandls[handles[i]], *stringTable);
+                    return {};
                 }
+                return table::string::decodeString(stringEntry);
+            };
 
-                auto defNum =
-                    pldm_bios_table_attr_entry_enum_decode_def_num(attrEntry);
-                std::vector<uint8_t> defIndices(defNum);
-                pldm_bios_table_attr_entry_enum_decode_def_indices(
-                    attrEntry, defIndices.data(), defIndices.size());
+            attributeType = "xyz.openbmc_project.BIOSConfig.Manager."
+                            "AttributeType.Enumeration";
 
-                // get default_value
-                for (size_t i = 0; i < defIndices.size(); i++)
-                {
-                    defaultValue =
-                        getValue(pvHandls[defIndices[i]], *stringTable);
-                }
+            auto pvNum =
+                pldm_bios_table_attr_entry_enum_decode_pv_num(attrEntry);
+            std::vector<uint16_t> pvHandls(pvNum);
+            pldm_bios_table_attr_entry_enum_decode_pv_hdls(
+                attrEntry, pvHandls.data(), pvHandls.size());
 
-                break;
-            }
-            case PLDM_BIOS_INTEGER:
-            case PLDM_BIOS_INTEGER_READ_ONLY:
+            // get possible_value
+            for (size_t i = 0; i < pvHandls.size(); i++)
             {
-                attributeType = "xyz.openbmc_project.BIOSConfig.Manager."
-                                "AttributeType.Integer";
-                currentValue = static_cast<int64_t>(
-                    pldm_bios_table_attr_value_entry_integer_decode_cv(
-                        tableEntry));
-
-                uint64_t lower, upper, def;
-                uint32_t scalar;
-                pldm_bios_table_attr_entry_integer_decode(
-                    attrEntry, &lower, &upper, &scalar, &def);
-                options.push_back(
-                    std::make_tuple("xyz.openbmc_project.BIOSConfig.Manager."
-                                    "BoundType.LowerBound",
-                                    static_cast<int64_t>(lower)));
                 options.push_back(
-                    std::make_tuple("xyz.openbmc_project.BIOSConfig.Manager."
-                                    "BoundType.UpperBound",
-                                    static_cast<int64_t>(upper)));
-                options.push_back(
-                    std::make_tuple("xyz.openbmc_project.BIOSConfig.Manager."
-                                    "BoundType.ScalarIncrement",
-                                    static_cast<int64_t>(scalar)));
-                defaultValue = static_cast<int64_t>(def);
-                break;
+                    std::make_tuple("xyz.openbmc_project.BIOSConfig."
+                                    "Manager.BoundType.OneOf",
+                                    getValue(pvHandls[i])));
             }
-            case PLDM_BIOS_STRING:
-            case PLDM_BIOS_STRING_READ_ONLY:
+
+            auto count =
+                pldm_bios_table_attr_value_entry_enum_decode_number(tableEntry);
+            std::vector<uint8_t> handles(count);
+            pldm_bios_table_attr_value_entry_enum_decode_handles(
+                tableEntry, handles.data(), handles.size());
+
+            // get current_value
+            for (size_t i = 0; i < handles.size(); i++)
             {
-                attributeType = "xyz.openbmc_project.BIOSConfig.Manager."
-                                "AttributeType.String";
-                variable_field currentString;
-                pldm_bios_table_attr_value_entry_string_decode_string(
-                    tableEntry, &currentString);
-                currentValue = std::string(
-                    reinterpret_cast<const char*>(currentString.ptr),
-                    currentString.length);
-                auto min = pldm_bios_table_attr_entry_string_decode_min_length(
-                    attrEntry);
-                auto max = pldm_bios_table_attr_entry_string_decode_max_length(
-                    attrEntry);
-                auto def =
-                    pldm_bios_table_attr_entry_string_decode_def_string_length(
-                        attrEntry);
-                std::vector<char> defString(def + 1);
-                pldm_bios_table_attr_entry_string_decode_def_string(
-                    attrEntry, defString.data(), defString.size());
-                options.push_back(
-                    std::make_tuple("xyz.openbmc_project.BIOSConfig.Manager."
-                                    "BoundType.MinStringLength",
-                                    static_cast<int64_t>(min)));
-                options.push_back(
-                    std::make_tuple("xyz.openbmc_project.BIOSConfig.Manager."
-                                    "BoundType.MaxStringLength",
-                                    static_cast<int64_t>(max)));
-                defaultValue = defString.data();
-                break;
+                currentValue = getValue(pvHandls[handles[i]]);
             }
-            case PLDM_BIOS_PASSWORD:
-            case PLDM_BIOS_PASSWORD_READ_ONLY:
+
+            auto defNum =
+                pldm_bios_table_attr_entry_enum_decode_def_num(attrEntry);
+            std::vector<uint8_t> defIndices(defNum);
+            pldm_bios_table_attr_entry_enum_decode_def_indices(
+                attrEntry, defIndices.data(), defIndices.size());
+
+            // get default_value
+            for (size_t i = 0; i < defIndices.size(); i++)
             {
-                attributeType = "xyz.openbmc_project.BIOSConfig.Manager."
-                                "AttributeType.Password";
-                break;
+                defaultValue = getValue(pvHandls[defIndices[i]]);
             }
-            default:
-                return PLDM_INVALID_BIOS_ATTR_HANDLE;
+
+            break;
+        }
+        case PLDM_BIOS_INTEGER:
+        case PLDM_BIOS_INTEGER_READ_ONLY:
+        {
+            attributeType = "xyz.openbmc_project.BIOSConfig.Manager."
+                            "AttributeType.Integer";
+            currentValue = static_cast<int64_t>(
+                pldm_bios_table_attr_value_entry_integer_decode_cv(
+                    tableEntry));
+
+            uint64_t lower, upper, def;
+            uint32_t scalar;
+            pldm_bios_table_attr_entry_integer_decode(
+                attrEntry, &lower, &upper, &scalar, &def);
+            options.push_back(
+                std::make_tuple("xyz.openbmc_project.BIOSConfig.Manager."
+                                "BoundType.LowerBound",
+                                static_cast<int64_t>(lower)));
+            options.push_back(
+                std::make_tuple("xyz.openbmc_project.BIOSConfig.Manager."
+                                "BoundType.UpperBound",
+                                static_cast<int64_t>(upper)));
+            options.push_back(
+                std::make_tuple("xyz.openbmc_project.BIOSConfig.Manager."
+                                "BoundType.ScalarIncrement",
+                                static_cast<int64_t>(scalar)));
+            defaultValue = static_cast<int64_t>(def);
+            break;
         }
-        baseBIOSTableMaps.emplace(
-            std::move(attributeName),
-            std::make_tuple(attributeType, readonlyStatus, displayName,
-                            description, menuPath, currentValue, defaultValue,
-                            std::move(options)));
+        case PLDM_BIOS_STRING:
+        case PLDM_BIOS_STRING_READ_ONLY:
+        {
+            attributeType = "xyz.openbmc_project.BIOSConfig.Manager."
+                            "AttributeType.String";
+            variable_field currentString;
+            pldm_bios_table_attr_value_entry_string_decode_string(
+                tableEntry, &currentString);
+            currentValue = std::string(
+                reinterpret_cast<const char*>(currentString.ptr),
+                currentString.length);
+            auto min = pldm_bios_table_attr_entry_string_decode_min_length(
+                attrEntry);
+            auto max = pldm_bios_table_attr_entry_string_decode_max_length(
+                attrEntry);
+            auto def =
+                pldm_bios_table_attr_entry_string_decode_def_string_length(
+                    attrEntry);
+            std::vector<char> defString(def + 1);
+            pldm_bios_table_attr_entry_string_decode_def_string(
+                attrEntry, defString.data(), defString.size());
+            options.push_back(
+                std::make_tuple("xyz.openbmc_project.BIOSConfig.Manager."
+                                "BoundType.MinStringLength",
+                                static_cast<int64_t>(min)));
+            options.push_back(
+                std::make_tuple("xyz.openbmc_project.BIOSConfig.Manager."
+                                "BoundType.MaxStringLength",
+                                static_cast<int64_t>(max)));
+            defaultValue = defString.data();
+            break;
+        }
+        case PLDM_BIOS_PASSWORD:
+        case PLDM_BIOS_PASSWORD_READ_ONLY:
+        {
+            attributeType = "xyz.openbmc_project.BIOSConfig.Manager."
+                            "AttributeType.Password";
+            break;
+        }
+        default:
+            return PLDM_INVALID_BIOS_ATTR_HANDLE;
     }
+    baseBIOSTableMaps.insert_or_assign(
+        std::move(attributeName),
+        std::make_tuple(attributeType, readonlyStatus, displayName,
+                        description, menuPath, currentValue, defaultValue,
+                        std::move(options)));
 
     return PLDM_SUCCESS;
 }
@@ -593,10 +618,141 @@ std::optional<Table> BIOSConfig::buildAndStoreStringTable()
     return table;
 }
 
-void BIOSConfig::storeTable(const fs::path& path, const Table& table)
+fs::path BIOSConfig::getTablePath(pldm_bios_table_types tableType) const
 {
-    BIOSTable biosTable(path.c_str());
+    switch (tableType)
+    {
+        case PLDM_BIOS_STRING_TABLE:
+            return tableDir / stringTableFile;
+        case PLDM_BIOS_ATTR_TABLE:
+            return tableDir / attrTableFile;
+        case PLDM_BIOS_ATTR_VAL_TABLE:
+            return tableDir / attrValueTableFile;
+    }
+    return {};
+}
+
+void BIOSConfig::storeTable(pldm_bios_table_types tableType,
+                            const Table& table)
+{
+    BIOSTable biosTable(getTablePath(tableType).c_str());
     biosTable.store(table);
+    cacheTable(tableType, table);
+
+    if (tableType == PLDM_BIOS_ATTR_VAL_TABLE)
+    {
+        attrValueTableDirty = false;
+        attrValueTablePersistTimer.setEnabled(false);
+    }
+}
+
+void BIOSConfig::flushAttrValueTable()
+{
+    if (!attrValueTableDirty)
+    {
+        return;
+    }
+    attrValueTableDirty = false;
+    attrValueTablePersistTimer.setEnabled(false);
+
+    auto it = tableCache.find(PLDM_BIOS_ATTR_VAL_TABLE);
+    if (it == tableCache.end())
+    {
+        return;
+    }
+    BIOSTable biosTable(getTablePath(PLDM_BIOS_ATTR_VAL_TABLE).c_str());
+    biosTable.store(it->second);
+}
+
+bool BIOSConfig::canUpdateAttrValueInPlace(
+    const pldm_bios_attr_val_table_entry* entry, size_t size)
+{
+    auto header = table::attribute_value::decodeHeader(entry);
+    auto currentEntry = findAttrValueEntry(header.attrHandle);
+    if (currentEntry == nullptr)
+    {
+        return false;
+    }
+    auto currentHeader = table::attribute_value::decodeHeader(currentEntry);
+    return currentHeader.attrType == header.attrType &&
+           pldm_bios_table_attr_value_entry_length(currentEntry) == size;
+}
+
+int BIOSConfig::updateAttrValueInPlace(
+    const pldm_bios_attr_val_table_entry* entry, size_t size,
+    bool updateBaseBIOSTable)
+{
+    auto it = tableCache.find(PLDM_BIOS_ATTR_VAL_TABLE);
+    auto header = table::attribute_value::decodeHeader(entry);
+    auto offset = tableIndex.findAttrValue(header.attrHandle);
+    if (it == tableCache.end() || !offset)
+    {
+        return PLDM_ERROR;
+    }
+
+    auto& table = it->second;
+    // Keep the current entry, a value the checks below reject is rolled back
+    // rather than left in the resident table
+    Table oldEntry;
+    if (*offset < table.size() && size <= table.size() - *offset)
+    {
+        oldEntry.assign(table.begin() + *offset,
+                        table.begin() + *offset + size);
+    }
+    auto rc = pldm_bios_table_attr_value_update_in_place(
+        table.data(), table.size(), *offset, entry, size);
+    if (rc != PLDM_SUCCESS)
+    {
+        return rc;
+    }
+
+    bool rebuildMaps = baseBIOSTableMaps.empty();
+    if (rebuildMaps)
+    {
+        rc = checkAttributeValueTable(table);
+    }
+    else
+    {
+        rc = updateBaseBIOSTableEntry(entry);
+    }
+
+    if (rc != PLDM_SUCCESS)
+    {
+        pldm_bios_table_attr_value_update_in_place(
+            table.data(), table.size(), *offset, oldEntry.data(), size);
+        if (rebuildMaps)
+        {
+            baseBIOSTableMaps.clear();
+        }
+        return rc;
+    }
+
+    if (!attrValueTableDirty)
+    {
+        attrValueTableDirty = true;
+        attrValueTablePersistTimer.restartOnce(attrValueTablePersistDelay);
+    }
+    if (updateBaseBIOSTable)
+    {
+        updateBaseBIOSTableProperty();
+    }
+    return PLDM_SUCCESS;
+}
+
+const Table* BIOSConfig::cacheTable(pldm_bios_table_types tableType,
+                                    Table table)
+{
+    if (table.empty())
+    {
+        tableCache.erase(tableType);
+        tableIndex.update(tableType, {});
+        return nullptr;
+    }
+
+    auto& cached = tableCache[tableType];
+    cached = std::move(table);
+    tableIndex.update(tableType, cached);
+    return &cached;
 }
 
 std::optional<Table> BIOSConfig::loadTable(const fs::path& path)
@@ -612,6 +768,103 @@ std::optional<Table> BIOSConfig::loadTable(const fs::path& path)
     return table;
 }
 
+const Table* BIOSConfig::getCachedTable(pldm_bios_table_types tableType)
+{
+    auto it = tableCache.find(tableType);
+    if (it != tableCache.end())
+    {
+        return &it->second;
+    }
+
+    auto tablePath = getTablePath(tableType);
+    if (tablePath.empty())
+    {
+        return nullptr;
+    }
+
+    auto table = loadTable(tablePath);
+    if (!table)
+    {
+        return nullptr;
+    }
+    return cacheTable(tableType, std::move(*table));
+}
+
+const pldm_bios_string_table_entry*
+    BIOSConfig::findStringEntry(uint16_t handle)
+{
+    auto table = getCachedTable(PLDM_BIOS_STRING_TABLE);
+    auto offset = tableIndex.findString(handle);
+    if (!table || !offset)
+    {
+        return nullptr;
+    }
+    return reinterpret_cast<const pldm_bios_string_table_entry*>(
+        table->data() + *offset);
+}
+
+std::optional<uint16_t>
+    BIOSConfig::findStringHandle(const std::string& name)
+{
+    if (!getCachedTable(PLDM_BIOS_STRING_TABLE))
+    {
+        return std::nullopt;
+    }
+    return tableIndex.findStringHandle(name);
+}
+
+const pldm_bios_attr_table_entry*
+    BIOSConfig::findAttrEntry(uint16_t attrHandle)
+{
+    auto table = getCachedTable(PLDM_BIOS_ATTR_TABLE);
+    auto offset = tableIndex.findAttr(attrHandle);
+    if (!table || !offset)
+    {
+        return nullptr;
+    }
+    return reinterpret_cast<const pldm_bios_attr_table_entry*>(table->data() +
+                                                               *offset);
+}
+
+const pldm_bios_attr_table_entry*
+    BIOSConfig::findAttrEntryByStringHandle(uint16_t stringHandle)
+{
+    if (!getCachedTable(PLDM_BIOS_ATTR_TABLE))
+    {
+        return nullptr;
+    }
+    auto attrHandle = tableIndex.findAttrHandle(stringHandle);
+    if (!attrHandle)
+    {
+        return nullptr;
+    }
+    return findAttrEntry(*attrHandle);
+}
+
+const pldm_bios_attr_val_table_entry*
+    BIOSConfig::findAttrValueEntry(uint16_t attrHandle)
+{
+    auto table = getCachedTable(PLDM_BIOS_ATTR_VAL_TABLE);
+    auto offset = tableIndex.findAttrValue(attrHandle);
+    if (!table || !offset)
+    {
+        return nullptr;
+    }
+    return reinterpret_cast<const pldm_bios_attr_val_table_entry*>(
+        table->data() + *offset);
+}
+
+std::optional<size_t>
+    BIOSConfig::findBIOSAttribute(const std::string& attrName) const
+{
+    auto it = biosAttrIndexes.find(attrName);
+    if (it == biosAttrIndexes.end())
+    {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
 void BIOSConfig::load(const fs::path& filePath, ParseHandler handler)
 {
     std::ifstream file;
@@ -647,7 +900,7 @@ void BIOSConfig::load(const fs::path& filePath, ParseHandler handler)
 
 int BIOSConfig::checkAttrValueToUpdate(
     const pldm_bios_attr_val_table_entry* attrValueEntry,
-    const pldm_bios_attr_table_entry* attrEntry, Table&)
+    const pldm_bios_attr_table_entry* attrEntry, const Table&)
 
 {
     auto [attrHandle, attrType] =
@@ -716,9 +969,9 @@ int BIOSConfig::checkAttrValueToUpdate(
 int BIOSConfig::setAttrValue(const void* entry, size_t size, bool updateDBus,
                              bool updateBaseBIOSTable)
 {
-    auto attrValueTable = getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE);
-    auto attrTable = getBIOSTable(PLDM_BIOS_ATTR_TABLE);
-    auto stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
+    auto attrValueTable = getCachedTable(PLDM_BIOS_ATTR_VAL_TABLE);
+    auto attrTable = getCachedTable(PLDM_BIOS_ATTR_TABLE);
+    auto stringTable = getCachedTable(PLDM_BIOS_STRING_TABLE);
     if (!attrValueTable || !attrTable || !stringTable)
     {
         return PLDM_BIOS_TABLE_UNAVAILABLE;
@@ -729,8 +982,7 @@ int BIOSConfig::setAttrValue(const void* entry, size_t size, bool updateDBus,
 
     auto attrValHeader = table::attribute_value::decodeHeader(attrValueEntry);
 
-    auto attrEntry =
-        table::attribute::findByHandle(*attrTable, attrValHeader.attrHandle);
+    auto attrEntry = findAttrEntry(attrValHeader.attrHandle);
     if (!attrEntry)
     {
         return PLDM_ERROR;
@@ -742,33 +994,36 @@ int BIOSConfig::setAttrValue(const void* entry, size_t size, bool updateDBus,
         return rc;
     }
 
-    auto destTable =
-        table::attribute_value::updateTable(*attrValueTable, entry, size);
-
-    if (!destTable)
+    // Enum and integer values have a fixed size, so they are normally
+    // patched into the resident table instead of rebuilding it
+    auto updateInPlace = canUpdateAttrValueInPlace(attrValueEntry, size);
+    std::optional<Table> destTable;
+    if (!updateInPlace)
     {
-        return PLDM_ERROR;
+        destTable =
+            table::attribute_value::updateTable(*attrValueTable, entry, size);
+        if (!destTable)
+        {
+            return PLDM_ERROR;
+        }
     }
 
     try
     {
         auto attrHeader = table::attribute::decodeHeader(attrEntry);
 
-        BIOSStringTable biosStringTable(*stringTable);
+        ResidentStringTable biosStringTable(*this);
         auto attrName = biosStringTable.findString(attrHeader.stringHandle);
 
-        auto iter = std::find_if(
-            biosAttributes.begin(), biosAttributes.end(),
-            [&attrName](const auto& attr) { return attr->name == attrName; });
-
-        if (iter == biosAttributes.end())
+        auto biosAttrIndex = findBIOSAttribute(attrName);
+        if (!biosAttrIndex)
         {
             return PLDM_ERROR;
         }
         if (updateDBus)
         {
-            (*iter)->setAttrValueOnDbus(attrValueEntry, attrEntry,
-                                        biosStringTable);
+            biosAttributes[*biosAttrIndex]->setAttrValueOnDbus(
+                attrValueEntry, attrEntry, biosStringTable);
         }
     }
     catch (const std::exception& e)
@@ -777,6 +1032,12 @@ int BIOSConfig::setAttrValue(const void* entry, size_t size, bool updateDBus,
         return PLDM_ERROR;
     }
 
+    if (updateInPlace)
+    {
+        return updateAttrValueInPlace(attrValueEntry, size,
+                                      updateBaseBIOSTable);
+    }
+
     setBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE, *destTable, updateBaseBIOSTable);
 
     return PLDM_SUCCESS;
@@ -784,6 +1045,10 @@ int BIOSConfig::setAttrValue(const void* entry, size_t size, bool updateDBus,
 
 void BIOSConfig::removeTables()
 {
+    attrValueTableDirty = false;
+    attrValueTablePersistTimer.setEnabled(false);
+    tableCache.clear();
+    tableIndex.clear();
     try
     {
         fs::remove(tableDir / stringTableFile);
@@ -810,33 +1075,27 @@ void BIOSConfig::processBiosAttrChangeNotification(
     }
 
     PropertyValue newPropVal = it->second;
-    auto stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
-    if (!stringTable.has_value())
+    if (!getCachedTable(PLDM_BIOS_STRING_TABLE))
     {
         std::cerr << "BIOS string table unavailable\n";
         return;
     }
-    BIOSStringTable biosStringTable(*stringTable);
-    uint16_t attrNameHdl{};
-    try
-    {
-        attrNameHdl = biosStringTable.findHandle(attrName);
-    }
-    catch (const std::invalid_argument& e)
+    auto stringHandle = findStringHandle(attrName);
+    if (!stringHandle)
     {
         std::cerr << "Could not find handle for BIOS string, ATTRIBUTE="
                   << attrName.c_str() << "\n";
         return;
     }
+    uint16_t attrNameHdl = *stringHandle;
 
-    auto attrTable = getBIOSTable(PLDM_BIOS_ATTR_TABLE);
-    if (!attrTable.has_value())
+    if (!getCachedTable(PLDM_BIOS_ATTR_TABLE))
     {
         std::cerr << "Attribute table not present\n";
         return;
     }
     const struct pldm_bios_attr_table_entry* tableEntry =
-        table::attribute::findByStringHandle(*attrTable, attrNameHdl);
+        findAttrEntryByStringHandle(attrNameHdl);
     if (tableEntry == nullptr)
     {
         std::cerr << "Attribute not found in attribute table, name= "
@@ -847,9 +1106,9 @@ void BIOSConfig::processBiosAttrChangeNotification(
     auto [attrHdl, attrType, stringHdl] =
         table::attribute::decodeHeader(tableEntry);
 
-    auto attrValueSrcTable = getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE);
+    auto attrValueSrcTable = getCachedTable(PLDM_BIOS_ATTR_VAL_TABLE);
 
-    if (!attrValueSrcTable.has_value())
+    if (!attrValueSrcTable)
     {
         std::cerr << "Attribute value table not present\n";
         return;
@@ -865,11 +1124,20 @@ void BIOSConfig::processBiosAttrChangeNotification(
                   << attrHdl << " and type=" << (uint32_t)attrType << "\n";
         return;
     }
-    auto destTable = table::attribute_value::updateTable(
-        *attrValueSrcTable, newValue.data(), newValue.size());
-    if (destTable.has_value())
+    auto newEntry = reinterpret_cast<const pldm_bios_attr_val_table_entry*>(
+        newValue.data());
+    if (canUpdateAttrValueInPlace(newEntry, newValue.size()))
+    {
+        updateAttrValueInPlace(newEntry, newValue.size(), false);
+    }
+    else
     {
-        storeTable(tableDir / attrValueTableFile, *destTable);
+        auto destTable = table::attribute_value::updateTable(
+            *attrValueSrcTable, newValue.data(), newValue.size());
+        if (destTable.has_value())
+        {
+            storeTable(PLDM_BIOS_ATTR_VAL_TABLE, *destTable);
+        }
     }
 
     rc = setAttrValue(newValue.data(), newValue.size(), false);
@@ -882,25 +1150,18 @@ void BIOSConfig::processBiosAttrChangeNotification(
 
 uint16_t BIOSConfig::findAttrHandle(const std::string& attrName)
 {
-    auto stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
-    auto attrTable = getBIOSTable(PLDM_BIOS_ATTR_TABLE);
-
-    BIOSStringTable biosStringTable(*stringTable);
-    pldm::bios::utils::BIOSTableIter<PLDM_BIOS_ATTR_TABLE> attrTableIter(
-        attrTable->data(), attrTable->size());
-    auto stringHandle = biosStringTable.findHandle(attrName);
-
-    for (auto entry : pldm::bios::utils::BIOSTableIter<PLDM_BIOS_ATTR_TABLE>(
-             attrTable->data(), attrTable->size()))
+    auto stringHandle = findStringHandle(attrName);
+    if (!stringHandle)
     {
-        auto header = table::attribute::decodeHeader(entry);
-        if (header.stringHandle == stringHandle)
-        {
-            return header.attrHandle;
-        }
+        throw std::invalid_argument("Invalid String Name");
     }
 
-    throw std::invalid_argument("Unknow attribute Name");
+    auto attrEntry = findAttrEntryByStringHandle(*stringHandle);
+    if (attrEntry == nullptr)
+    {
+        throw std::invalid_argument("Unknow attribute Name");
+    }
+    return table::attribute::decodeHeader(attrEntry).attrHandle;
 }
 
 void BIOSConfig::constructPendingAttribute(
@@ -913,12 +1174,8 @@ void BIOSConfig::constructPendingAttribute(
         std::string attributeName = attribute.first;
         auto& [attributeType, attributevalue] = attribute.second;
 
-        auto iter = std::find_if(biosAttributes.begin(), biosAttributes.end(),
-                                 [&attributeName](const auto& attr) {
-                                     return attr->name == attributeName;
-                                 });
-
-        if (iter == biosAttributes.end())
+        auto biosAttrIndex = findBIOSAttribute(attributeName);
+        if (!biosAttrIndex)
         {
             std::cerr << "Wrong attribute name, attributeName = "
                       << attributeName << std::endl;
@@ -945,7 +1202,8 @@ void BIOSConfig::constructPendingAttribute(
         entry->attr_handle = htole16(handler);
         listOfHandles.emplace_back(htole16(handler));
 
-        (*iter)->generateAttributeEntry(attributevalue, attrValueEntry);
+        biosAttributes[*biosAttrIndex]->generateAttributeEntry(attributevalue,
+                                                               attrValueEntry);
 
         setAttrValue(attrValueEntry.data(), attrValueEntry.size());
     }
@@ -8,13 +8,18 @@
 #include "requester/handler.hpp"
 
 #include <nlohmann/json.hpp>
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/utility/timer.hpp>
 
+#include <chrono>
 #include <functional>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <optional>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace pldm
@@ -64,7 +69,7 @@ class BIOSConfig
     BIOSConfig(BIOSConfig&&) = delete;
     BIOSConfig& operator=(const BIOSConfig&) = delete;
     BIOSConfig& operator=(BIOSConfig&&) = delete;
-    ~BIOSConfig() = default;
+    ~BIOSConfig();
 
     /** @brief Construct BIOSConfig
      *  @param[in] jsonDir - The directory where json file exists
@@ -105,6 +110,12 @@ class BIOSConfig
      */
     std::optional<Table> getBIOSTable(pldm_bios_table_types tableType);
 
+    /** @brief Check whether a BIOS table is available
+     *  @param[in] tableType - The table type
+     *  @return true if the table is available, false otherwise
+     */
+    bool hasBIOSTable(pldm_bios_table_types tableType);
+
     /** @brief set BIOS table
      *  @param[in] tableType - Indicates what table is being transferred
      *             {BIOSStringTable=0x0, BIOSAttributeTable=0x1,
@@ -117,6 +128,45 @@ class BIOSConfig
     int setBIOSTable(uint8_t tableType, const Table& table,
                      bool updateBaseBIOSTable = true);
 
+    /** @brief Find a string table entry by string handle
+     *  @param[in] handle - string handle
+     *  @return Pointer to the entry, nullptr if not found. The pointer is
+     *          valid until the string table is next stored.
+     */
+    const pldm_bios_string_table_entry* findStringEntry(uint16_t handle);
+
+    /** @brief Find the string handle of a string in the string table
+     *  @param[in] name - the string
+     *  @return The string handle, std::nullopt if not found
+     */
+    std::optional<uint16_t> findStringHandle(const std::string& name);
+
+    /** @brief Find an attribute table entry by attribute handle
+     *  @param[in] attrHandle - attribute handle
+     *  @return Pointer to the entry, nullptr if not found. The pointer is
+     *          valid until the attribute table is next stored.
+     */
+    const pldm_bios_attr_table_entry* findAttrEntry(uint16_t attrHandle);
+
+    /** @brief Find an attribute table entry by the handle of its name
+     *  @param[in] stringHandle - string handle of the attribute name
+     *  @return Pointer to the entry, nullptr if not found. The pointer is
+     *          valid until the attribute table is next stored.
+     */
+    const pldm_bios_attr_table_entry*
+        findAttrEntryByStringHandle(uint16_t stringHandle);
+
+    /** @brief Find an attribute value table entry by attribute handle
+     *  @param[in] attrHandle - attribute handle
+     *  @return Pointer to the entry, nullptr if not found. The pointer is
+     *          valid until the attribute value table is next stored.
+     */
+    const pldm_bios_attr_val_table_entry*
+        findAttrValueEntry(uint16_t attrHandle);
+
+    /** @brief Persist the attribute value table if it has pending changes */
+    void flushAttrValueTable();
+
   private:
     /** @enum Index into the fields in the BaseBIOSTable
      */
@@ -151,10 +201,40 @@ class BIOSConfig
     /** @brief PLDM request handler */
     pldm::requester::Handler<pldm::requester::Request>* handler;
 
+    /** @brief Resident copies of the persisted string, attribute and attribute
+     *         value tables. Every store writes through to tableDir, so the
+     *         files are only read the first time a table is needed.
+     */
+    std::map<pldm_bios_table_types, Table> tableCache;
+
+    /** @brief Handle and name indexes over the tables in tableCache */
+    BIOSTableIndex tableIndex;
+
+    /** @brief Delay before an attribute value table patched in place is
+     *         written back to tableDir, so a burst of updates costs a single
+     *         write
+     */
+    static constexpr auto attrValueTablePersistDelay =
+        std::chrono::milliseconds(500);
+
+    /** @brief True if the resident attribute value table has changes that
+     *         have not been persisted yet
+     */
+    bool attrValueTableDirty = false;
+
+    /** @brief Timer to persist the attribute value table once the delay
+     *         expires
+     */
+    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>
+        attrValueTablePersistTimer;
+
     // vector persists all attributes
     using BIOSAttributes = std::vector<std::unique_ptr<BIOSAttribute>>;
     BIOSAttributes biosAttributes;
 
+    /** @brief Attribute name to index in biosAttributes */
+    std::unordered_map<std::string, size_t> biosAttrIndexes;
+
     using propName = std::string;
     using DbusChObjProperties = std::map<propName, pldm::utils::PropertyValue>;
 
@@ -182,6 +262,8 @@ class BIOSConfig
         {
             biosAttributes.push_back(std::make_unique<T>(entry, dbusHandler));
             auto biosAttrIndex = biosAttributes.size() - 1;
+            biosAttrIndexes.emplace(biosAttributes[biosAttrIndex]->name,
+                                    biosAttrIndex);
             auto dBusMap = biosAttributes[biosAttrIndex]->getDBusMap();
 
             if (dBusMap.has_value())
@@ -233,11 +315,17 @@ class BIOSConfig
      */
     void buildAndStoreAttrTables(const Table& stringTable);
 
-    /** @brief Persist the table
-     *  @param[in] path - Path to persist the table
+    /** @brief Get the path where a table is persisted
+     *  @param[in] tableType - The table type
+     *  @return Path of the table, empty for an unknown table type
+     */
+    fs::path getTablePath(pldm_bios_table_types tableType) const;
+
+    /** @brief Persist the table and keep it resident
+     *  @param[in] tableType - The table type
      *  @param[in] table - The table
      */
-    void storeTable(const fs::path& path, const Table& table);
+    void storeTable(pldm_bios_table_types tableType, const Table& table);
 
     /** @brief Load bios table to ram
      *  @param[in] path - Path of the table
@@ -245,6 +333,27 @@ class BIOSConfig
      */
     std::optional<Table> loadTable(const fs::path& path);
 
+    /** @brief Keep a table resident and index it
+     *  @param[in] tableType - The table type
+     *  @param[in] table - The table, an empty table is dropped
+     *  @return Pointer to the resident table, nullptr if the table is empty
+     */
+    const Table* cacheTable(pldm_bios_table_types tableType, Table table);
+
+    /** @brief Find an attribute by name
+     *  @param[in] attrName - attribute name
+     *  @return Index of the attribute in biosAttributes, std::nullopt if not
+     *          found
+     */
+    std::optional<size_t> findBIOSAttribute(const std::string& attrName) const;
+
+    /** @brief Get the resident copy of a table, loading it on first use
+     *  @param[in] tableType - The table type
+     *  @return Pointer to the table, nullptr if the table is unavailable. The
+     *          pointer stays valid until the table is removed.
+     */
+    const Table* getCachedTable(pldm_bios_table_types tableType);
+
     /** @brief Check the attribute value to update
      *  @param[in] attrValueEntry - The attribute value entry to update
      *  @param[in] attrEntry - The attribute table entry
@@ -253,7 +362,7 @@ class BIOSConfig
      */
     int checkAttrValueToUpdate(
         const pldm_bios_attr_val_table_entry* attrValueEntry,
-        const pldm_bios_attr_table_entry* attrEntry, Table& stringTable);
+        const pldm_bios_attr_table_entry* attrEntry, const Table& stringTable);
 
     /** @brief Check the attribute table
      *  @param[in] table - The table
@@ -267,6 +376,34 @@ class BIOSConfig
      */
     int checkAttributeValueTable(const Table& table);
 
+    /** @brief Update the BaseBIOSTable entry of an attribute value entry
+     *  @param[in] tableEntry - The attribute value entry
+     *  @return pldm_completion_codes
+     */
+    int updateBaseBIOSTableEntry(
+        const pldm_bios_attr_val_table_entry* tableEntry);
+
+    /** @brief Check whether an attribute value entry can be patched into the
+     *         resident attribute value table in place, i.e. the current entry
+     *         exists and has the same type and size
+     *  @param[in] entry - The new attribute value entry
+     *  @param[in] size - Size of the new attribute value entry
+     *  @return true if the entry can be patched in place
+     */
+    bool canUpdateAttrValueInPlace(const pldm_bios_attr_val_table_entry* entry,
+                                   size_t size);
+
+    /** @brief Patch an attribute value entry into the resident attribute
+     *         value table in place and schedule the table to be persisted
+     *  @param[in] entry - The new attribute value entry
+     *  @param[in] size - Size of the new attribute value entry
+     *  @param[in] updateBaseBIOSTable - update BaseBIOSTable D-Bus property
+     *                                   if this is set to true
+     *  @return pldm_completion_codes
+     */
+    int updateAttrValueInPlace(const pldm_bios_attr_val_table_entry* entry,
+                               size_t size, bool updateBaseBIOSTable);
+
     /** @brief Update the BaseBIOSTable property of the D-Bus interface
      */
     void updateBaseBIOSTableProperty();
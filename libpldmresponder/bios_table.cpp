@@ -2,6 +2,9 @@
 
 #include "bios_table.h"
 
+#include "common/bios_utils.hpp"
+
+#include <algorithm>
 #include <fstream>
 
 namespace pldm
@@ -45,36 +48,218 @@ void BIOSTable::load(Response& response) const
     stream.read(reinterpret_cast<char*>(response.data() + currSize), fileSize);
 }
 
+void BIOSTableIndex::update(pldm_bios_table_types tableType,
+                            const Table& table)
+{
+    using namespace pldm::bios::utils;
+    auto offsetOf = [&table](const void* entry) {
+        return static_cast<size_t>(reinterpret_cast<const uint8_t*>(entry) -
+                                   table.data());
+    };
+
+    switch (tableType)
+    {
+        case PLDM_BIOS_STRING_TABLE:
+            stringOffsets.clear();
+            stringHandles.clear();
+            for (auto entry : BIOSTableIter<PLDM_BIOS_STRING_TABLE>(
+                     table.data(), table.size()))
+            {
+                auto handle = table::string::decodeHandle(entry);
+                stringOffsets.emplace(handle, offsetOf(entry));
+                stringHandles.emplace(table::string::decodeString(entry),
+                                      handle);
+            }
+            break;
+        case PLDM_BIOS_ATTR_TABLE:
+            attrOffsets.clear();
+            attrHandles.clear();
+            for (auto entry : BIOSTableIter<PLDM_BIOS_ATTR_TABLE>(
+                     table.data(), table.size()))
+            {
+                auto header = table::attribute::decodeHeader(entry);
+                attrOffsets.emplace(header.attrHandle, offsetOf(entry));
+                attrHandles.emplace(header.stringHandle, header.attrHandle);
+            }
+            break;
+        case PLDM_BIOS_ATTR_VAL_TABLE:
+            attrValueOffsets.clear();
+            for (auto entry : BIOSTableIter<PLDM_BIOS_ATTR_VAL_TABLE>(
+                     table.data(), table.size()))
+            {
+                auto header = table::attribute_value::decodeHeader(entry);
+                attrValueOffsets.emplace(header.attrHandle, offsetOf(entry));
+            }
+            break;
+    }
+}
+
+void BIOSTableIndex::clear()
+{
+    stringOffsets.clear();
+    stringHandles.clear();
+    attrOffsets.clear();
+    attrHandles.clear();
+    attrValueOffsets.clear();
+}
+
+template <typename Map>
+static std::optional<typename Map::mapped_type>
+    findIn(const Map& map, const typename Map::key_type& key)
+{
+    auto it = map.find(key);
+    if (it == map.end())
+    {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+std::optional<size_t> BIOSTableIndex::findString(uint16_t handle) const
+{
+    return findIn(stringOffsets, handle);
+}
+
+std::optional<uint16_t>
+    BIOSTableIndex::findStringHandle(const std::string& name) const
+{
+    return findIn(stringHandles, name);
+}
+
+std::optional<size_t> BIOSTableIndex::findAttr(uint16_t attrHandle) const
+{
+    return findIn(attrOffsets, attrHandle);
+}
+
+std::optional<uint16_t>
+    BIOSTableIndex::findAttrHandle(uint16_t stringHandle) const
+{
+    return findIn(attrHandles, stringHandle);
+}
+
+std::optional<size_t> BIOSTableIndex::findAttrValue(uint16_t attrHandle) const
+{
+    return findIn(attrValueOffsets, attrHandle);
+}
+
+void BIOSTableTransfer::startGet(Table table)
+{
+    getTable = std::move(table);
+}
+
+bool BIOSTableTransfer::isGetInProgress() const
+{
+    return getTable.has_value();
+}
+
+int BIOSTableTransfer::getPart(uint32_t transferHandle, size_t maxPartSize,
+                               Table& part, uint32_t& nextTransferHandle,
+                               uint8_t& transferFlag)
+{
+    if (!getTable || maxPartSize == 0 || transferHandle >= getTable->size())
+    {
+        return PLDM_INVALID_BIOS_DATA_TRANSFER_HANDLE;
+    }
+
+    size_t offset = transferHandle;
+    auto length = std::min(maxPartSize, getTable->size() - offset);
+    auto end = offset + length;
+    auto last = end == getTable->size();
+
+    part.assign(getTable->begin() + offset, getTable->begin() + end);
+    nextTransferHandle = last ? 0 : end;
+
+    if (offset == 0)
+    {
+        transferFlag = last ? PLDM_START_AND_END : PLDM_START;
+    }
+    else
+    {
+        transferFlag = last ? PLDM_END : PLDM_MIDDLE;
+    }
+
+    if (last)
+    {
+        getTable.reset();
+    }
+
+    return PLDM_SUCCESS;
+}
+
+int BIOSTableTransfer::setPart(uint32_t transferHandle, uint8_t transferFlag,
+                               const variable_field& part,
+                               uint32_t& nextTransferHandle,
+                               std::optional<Table>& table)
+{
+    switch (transferFlag)
+    {
+        case PLDM_START:
+        case PLDM_START_AND_END:
+            setTable.emplace();
+            break;
+        case PLDM_MIDDLE:
+        case PLDM_END:
+            if (!setTable || transferHandle != setTable->size())
+            {
+                return PLDM_INVALID_BIOS_DATA_TRANSFER_HANDLE;
+            }
+            break;
+        default:
+            return PLDM_INVALID_BIOS_TRANSFER_FLAG;
+    }
+
+    if (part.length > maxTableSize - setTable->size())
+    {
+        setTable.reset();
+        return PLDM_ERROR_INVALID_LENGTH;
+    }
+    setTable->insert(setTable->end(), part.ptr, part.ptr + part.length);
+
+    if (transferFlag == PLDM_START || transferFlag == PLDM_MIDDLE)
+    {
+        nextTransferHandle = setTable->size();
+        return PLDM_SUCCESS;
+    }
+
+    nextTransferHandle = 0;
+    table = std::move(setTable);
+    setTable.reset();
+    return PLDM_SUCCESS;
+}
+
 BIOSStringTable::BIOSStringTable(const Table& stringTable) :
     stringTable(stringTable)
-{}
+{
+    index.update(PLDM_BIOS_STRING_TABLE, this->stringTable);
+}
 
 BIOSStringTable::BIOSStringTable(const BIOSTable& biosTable)
 {
     biosTable.load(stringTable);
+    index.update(PLDM_BIOS_STRING_TABLE, stringTable);
 }
 
 std::string BIOSStringTable::findString(uint16_t handle) const
 {
-    auto stringEntry = pldm_bios_table_string_find_by_handle(
-        stringTable.data(), stringTable.size(), handle);
-    if (stringEntry == nullptr)
+    auto offset = index.findString(handle);
+    if (!offset)
     {
         throw std::invalid_argument("Invalid String Handle");
     }
-    return table::string::decodeString(stringEntry);
+    return table::string::decodeString(
+        reinterpret_cast<const pldm_bios_string_table_entry*>(
+            stringTable.data() + *offset));
 }
 
 uint16_t BIOSStringTable::findHandle(const std::string& name) const
 {
-    auto stringEntry = pldm_bios_table_string_find_by_string(
-        stringTable.data(), stringTable.size(), name.c_str());
-    if (stringEntry == nullptr)
+    auto handle = index.findStringHandle(name);
+    if (!handle)
     {
         throw std::invalid_argument("Invalid String Name");
     }
 
-    return table::string::decodeHandle(stringEntry);
+    return *handle;
 }
 
 namespace table
@@ -8,6 +8,7 @@
 #include <filesystem>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace pldm
@@ -74,6 +75,156 @@ class BIOSTable
     fs::path filePath;
 };
 
+/** @class BIOSTableIndex
+ *
+ *  @brief Hash indexes over the packed BIOS tables, so that string, attribute
+ *         and attribute value entries are found without walking the table.
+ *         The indexes hold offsets into the table they were built from and
+ *         must be rebuilt whenever that table changes.
+ */
+class BIOSTableIndex
+{
+  public:
+    /** @brief Rebuild the indexes of a table
+     *
+     *  @param[in] tableType - type of the table
+     *  @param[in] table - the table, an empty table drops its indexes
+     */
+    void update(pldm_bios_table_types tableType, const Table& table);
+
+    /** @brief Drop the indexes of all the tables
+     */
+    void clear();
+
+    /** @brief Find a string table entry by string handle
+     *
+     *  @param[in] handle - string handle
+     *  @return offset of the entry in the string table
+     */
+    std::optional<size_t> findString(uint16_t handle) const;
+
+    /** @brief Find the string handle of a string
+     *
+     *  @param[in] name - the string
+     *  @return handle of the string
+     */
+    std::optional<uint16_t> findStringHandle(const std::string& name) const;
+
+    /** @brief Find an attribute table entry by attribute handle
+     *
+     *  @param[in] attrHandle - attribute handle
+     *  @return offset of the entry in the attribute table
+     */
+    std::optional<size_t> findAttr(uint16_t attrHandle) const;
+
+    /** @brief Find the attribute handle of an attribute by its name handle
+     *
+     *  @param[in] stringHandle - string handle of the attribute name
+     *  @return handle of the attribute
+     */
+    std::optional<uint16_t> findAttrHandle(uint16_t stringHandle) const;
+
+    /** @brief Find an attribute value table entry by attribute handle
+     *
+     *  @param[in] attrHandle - attribute handle
+     *  @return offset of the entry in the attribute value table
+     */
+    std::optional<size_t> findAttrValue(uint16_t attrHandle) const;
+
+  private:
+    /** @brief string handle to offset in the string table */
+    std::unordered_map<uint16_t, size_t> stringOffsets;
+
+    /** @brief string to string handle */
+    std::unordered_map<std::string, uint16_t> stringHandles;
+
+    /** @brief attribute handle to offset in the attribute table */
+    std::unordered_map<uint16_t, size_t> attrOffsets;
+
+    /** @brief attribute name handle to attribute handle */
+    std::unordered_map<uint16_t, uint16_t> attrHandles;
+
+    /** @brief attribute handle to offset in the attribute value table */
+    std::unordered_map<uint16_t, size_t> attrValueOffsets;
+};
+
+/** @class BIOSTableTransfer
+ *
+ *  @brief Multipart transfer state of a BIOS table. GetBIOSTable parts are
+ *         served from a snapshot taken when the transfer starts, so the
+ *         table is copied once per transfer rather than once per part. The
+ *         snapshot is dropped once its last part is served. SetBIOSTable
+ *         parts are appended until the last part arrives, up to a maximum
+ *         table size. The transfer handle of a part is its offset in the
+ *         table.
+ */
+class BIOSTableTransfer
+{
+  public:
+    /** @brief Constructor
+     *
+     *  @param[in] maxTableSize - maximum size of a table being set
+     */
+    explicit BIOSTableTransfer(size_t maxTableSize) :
+        maxTableSize(maxTableSize)
+    {}
+
+    /** @brief Start serving a table in parts
+     *
+     *  @param[in] table - snapshot of the table
+     */
+    void startGet(Table table);
+
+    /** @brief Check whether a snapshot is being served
+     *
+     *  @return true if startGet was called and the last part is not served
+     *          yet
+     */
+    bool isGetInProgress() const;
+
+    /** @brief Get a part of the snapshot, the snapshot is dropped once the
+     *         last part is got
+     *
+     *  @param[in] transferHandle - offset of the part in the table
+     *  @param[in] maxPartSize - maximum size of a part
+     *  @param[out] part - the part
+     *  @param[out] nextTransferHandle - handle of the next part, 0 if this is
+     *                                   the last part
+     *  @param[out] transferFlag - PLDM_START, PLDM_MIDDLE, PLDM_END or
+     *                             PLDM_START_AND_END
+     *  @return pldm_completion_codes
+     */
+    int getPart(uint32_t transferHandle, size_t maxPartSize, Table& part,
+                uint32_t& nextTransferHandle, uint8_t& transferFlag);
+
+    /** @brief Add a part of a table being set
+     *
+     *  @param[in] transferHandle - handle of the part, ignored for the first
+     *                              part
+     *  @param[in] transferFlag - PLDM_START, PLDM_MIDDLE, PLDM_END or
+     *                            PLDM_START_AND_END
+     *  @param[in] part - the part
+     *  @param[out] nextTransferHandle - handle of the next part, 0 if this is
+     *                                   the last part
+     *  @param[out] table - the reassembled table once the last part is added
+     *  @return pldm_completion_codes, PLDM_ERROR_INVALID_LENGTH if the table
+     *          grows past the maximum size, the transfer is dropped then
+     */
+    int setPart(uint32_t transferHandle, uint8_t transferFlag,
+                const variable_field& part, uint32_t& nextTransferHandle,
+                std::optional<Table>& table);
+
+  private:
+    /** @brief maximum size of a table being set */
+    size_t maxTableSize;
+
+    /** @brief snapshot served by GetBIOSTable */
+    std::optional<Table> getTable;
+
+    /** @brief parts received by SetBIOSTable so far */
+    std::optional<Table> setTable;
+};
+
 /** @class BIOSStringTableInterface
  *  @brief Provide interfaces to the BIOS string table operations
  */
@@ -133,6 +284,7 @@ class BIOSStringTable : public BIOSStringTableInterface
 
   private:
     Table stringTable;
+    BIOSTableIndex index;
 };
 
 namespace table
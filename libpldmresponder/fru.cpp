@@ -17,6 +17,7 @@
 #include <sdbusplus/bus.hpp>
 
 #include <iostream>
+#include <memory>
 #include <set>
 
 namespace pldm
@@ -179,7 +180,10 @@ void FruImpl::buildFRUTable()
         bool isPresent = true;
 #ifdef OEM_IBM
         isPresent =
-            pldm::responder::utils::checkFruPresence(object.first.str.c_str());
+            presenceChecked
+                ? !absentObjPaths.contains(object.first.str)
+                : pldm::responder::utils::checkFruPresence(
+                      object.first.str.c_str());
 #endif
         if (!isPresent)
         {
@@ -229,6 +233,57 @@ void FruImpl::buildFRUTable()
 
     isBuilt = true;
 }
+
+void FruImpl::checkFruPresence(std::function<void()>&& callback)
+{
+#ifdef OEM_IBM
+    if (isBuilt)
+    {
+        callback();
+        return;
+    }
+
+    const pldm::utils::ObjectValueTree* inventoryObjects = nullptr;
+    try
+    {
+        inventoryObjects = &pldm::utils::DBusHandler::getInventoryObjects();
+    }
+    catch (const std::exception& e)
+    {
+        // buildFRUTable() reports the failure
+        callback();
+        return;
+    }
+    if (inventoryObjects->empty())
+    {
+        callback();
+        return;
+    }
+
+    absentObjPaths.clear();
+    auto pending = std::make_shared<size_t>(inventoryObjects->size());
+    auto done = std::make_shared<std::function<void()>>(std::move(callback));
+    for (const auto& object : *inventoryObjects)
+    {
+        pldm::responder::utils::checkFruPresenceAsync(
+            object.first.str.c_str(),
+            [this, objPath = object.first.str, pending, done](bool isPresent) {
+                if (!isPresent)
+                {
+                    absentObjPaths.insert(objPath);
+                }
+                if (!--*pending)
+                {
+                    presenceChecked = true;
+                    (*done)();
+                }
+            });
+    }
+#else
+    callback();
+#endif
+}
+
 std::string FruImpl::populatefwVersion()
 {
     static constexpr auto fwFunctionalObjPath =
@@ -1398,6 +1453,11 @@ namespace fru
 Response Handler::getFRURecordTableMetadata(const pldm_msg* request,
                                             size_t /*payloadLength*/)
 {
+    if (!ready)
+    {
+        return ccOnlyResponse(request, PLDM_ERROR_NOT_READY);
+    }
+
     // FRU table is built lazily, build if not done.
     buildFRUTable();
 
@@ -1427,6 +1487,11 @@ Response Handler::getFRURecordTableMetadata(const pldm_msg* request,
 Response Handler::getFRURecordTable(const pldm_msg* request,
                                     size_t payloadLength)
 {
+    if (!ready)
+    {
+        return ccOnlyResponse(request, PLDM_ERROR_NOT_READY);
+    }
+
     // FRU table is built lazily, build if not done.
     buildFRUTable();
 
@@ -1455,6 +1520,11 @@ Response Handler::getFRURecordTable(const pldm_msg* request,
 Response Handler::getFRURecordByOption(const pldm_msg* request,
                                        size_t payloadLength)
 {
+    if (!ready)
+    {
+        return ccOnlyResponse(request, PLDM_ERROR_NOT_READY);
+    }
+
     if (payloadLength != sizeof(pldm_get_fru_record_by_option_req))
     {
         return ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH);
@@ -1506,6 +1576,11 @@ Response Handler::getFRURecordByOption(const pldm_msg* request,
 Response Handler::setFRURecordTable(const pldm_msg* request,
                                     size_t payloadLength)
 {
+    if (!ready)
+    {
+        return ccOnlyResponse(request, PLDM_ERROR_NOT_READY);
+    }
+
     uint32_t transferHandle{};
     uint8_t transferOpFlag{};
     struct variable_field fruData;
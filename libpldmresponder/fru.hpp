@@ -16,7 +16,9 @@
 
 #include <sdbusplus/message.hpp>
 
+#include <functional>
 #include <map>
+#include <set>
 #include <string>
 #include <variant>
 #include <vector>
@@ -176,6 +178,14 @@ class FruImpl
      */
     void buildFRUTable();
 
+    /** @brief Check the presence of the inventory objects without blocking,
+     *         buildFRUTable() then takes the presence checked
+     *
+     *  @param[in] callback - invoked once the presence of all the inventory
+     *                        objects is known
+     */
+    void checkFruPresence(std::function<void()>&& callback);
+
     /** @brief Get std::map associated with the entity
      *         key: object path
      *         value: pldm_entity
@@ -358,6 +368,15 @@ class FruImpl
     std::vector<std::unique_ptr<sdbusplus::bus::match::match>>
         panelHotplugMatch;
     dbus::ObjectValueTree objects;
+
+    /** @brief true if checkFruPresence() checked the presence of the
+     *         inventory objects
+     */
+    bool presenceChecked = false;
+
+    /** @brief inventory objects checkFruPresence() found absent */
+    std::set<std::string> absentObjPaths;
+
     std::vector<fs::path> statePDRJsonsDir;
     uint16_t startStateSensorId;
     uint16_t startStateEffecterId;
@@ -433,6 +452,16 @@ class Handler : public CmdHandler
         impl.buildFRUTable();
     }
 
+    /** @brief Check the presence of the FRUs without blocking, before the
+     *         FRU table is built
+     *
+     *  @param[in] callback - invoked once the presence of the FRUs is known
+     */
+    void checkFruPresence(std::function<void()>&& callback)
+    {
+        impl.checkFruPresence(std::move(callback));
+    }
+
     /** @brief Get std::map associated with the entity
      *         key: object path
      *         value: pldm_entity
@@ -471,11 +500,26 @@ class Handler : public CmdHandler
         pldm::responder::pdr_utils::DbusObjMaps& effecterDbusObjMaps,
         bool hotPlug);
 
+    /** @brief Set whether the FRU table and the PDRs are built, the FRU
+     *         commands answer NOT_READY until they are
+     *
+     *  @param[in] ready - true once the platform handler built them
+     */
+    void setReady(bool ready)
+    {
+        this->ready = ready;
+    }
+
     // std::vector<uint8_t> table;
     using Table = std::vector<uint8_t>;
 
   private:
     FruImpl impl;
+
+    /** @brief false while the FRU table and the PDRs are built in the
+     *         background
+     */
+    bool ready = true;
 };
 
 } // namespace fru
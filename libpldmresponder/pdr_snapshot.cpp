@@ -0,0 +1,553 @@
+#include "pdr_snapshot.hpp"
+
+#include "libpldm/platform.h"
+#include "libpldm/utils.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace pldm
+{
+
+namespace responder
+{
+
+namespace pdr_snapshot
+{
+
+namespace
+{
+
+constexpr uint32_t snapshotMagic = 0x53524450; // "PDRS"
+constexpr uint32_t snapshotVersion = 1;
+
+/** @struct Header
+ *
+ *  Header of a snapshot file. It is followed by the PDRs, each prefixed with
+ *  its size, the effecter and the sensor D-Bus maps, and the CRC32 of the
+ *  whole file.
+ */
+struct Header
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint16_t nextEffecterId;
+    uint16_t nextSensorId;
+    uint32_t recordCount;
+};
+static_assert(sizeof(Header) == 24);
+
+using pldm::utils::PropertyValue;
+
+template <typename T>
+concept Scalar = std::is_arithmetic_v<T>;
+
+/** @class Hash
+ *
+ *  64-bit FNV-1a hash
+ */
+class Hash
+{
+  public:
+    void update(const void* data, size_t size)
+    {
+        auto bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash = (hash ^ bytes[i]) * 0x100000001b3;
+        }
+    }
+
+    template <Scalar T>
+    void update(T value)
+    {
+        update(&value, sizeof(value));
+    }
+
+    void update(const std::string& value)
+    {
+        update<uint32_t>(value.size());
+        update(value.data(), value.size());
+    }
+
+    uint64_t value() const
+    {
+        return hash;
+    }
+
+  private:
+    uint64_t hash = 0xcbf29ce484222325;
+};
+
+/** @class Writer
+ *
+ *  Serializes a snapshot into a buffer
+ */
+class Writer
+{
+  public:
+    void write(const void* data, size_t size)
+    {
+        auto bytes = static_cast<const uint8_t*>(data);
+        buffer.insert(buffer.end(), bytes, bytes + size);
+    }
+
+    template <Scalar T>
+    void write(T value)
+    {
+        write(&value, sizeof(value));
+    }
+
+    void write(const std::string& value)
+    {
+        write<uint32_t>(value.size());
+        write(value.data(), value.size());
+    }
+
+    void write(const std::vector<uint8_t>& value)
+    {
+        write<uint32_t>(value.size());
+        write(value.data(), value.size());
+    }
+
+    void write(const PropertyValue& value)
+    {
+        write<uint8_t>(value.index());
+        std::visit([this](const auto& v) { write(v); }, value);
+    }
+
+    void write(const pdr_utils::DbusObjMaps& maps)
+    {
+        write<uint32_t>(maps.size());
+        for (const auto& [id, dbusObj] : maps)
+        {
+            const auto& [dbusMappings, dbusValMaps] = dbusObj;
+            write(id);
+            write<uint32_t>(dbusMappings.size());
+            for (const auto& dbusMapping : dbusMappings)
+            {
+                write(dbusMapping.objectPath);
+                write(dbusMapping.interface);
+                write(dbusMapping.propertyName);
+                write(dbusMapping.propertyType);
+            }
+            write<uint32_t>(dbusValMaps.size());
+            for (const auto& dbusValMap : dbusValMaps)
+            {
+                write<uint32_t>(dbusValMap.size());
+                for (const auto& [state, value] : dbusValMap)
+                {
+                    write(state);
+                    write(value);
+                }
+            }
+        }
+    }
+
+    std::vector<uint8_t> buffer;
+};
+
+/** @class Reader
+ *
+ *  Deserializes a snapshot from its mapping, every read fails past the end
+ */
+class Reader
+{
+  public:
+    Reader(const uint8_t* data, size_t size) : data(data), size(size)
+    {}
+
+    /** @brief Take bytes out of the mapping without copying them
+     *
+     *  @return the bytes, nullptr past the end
+     */
+    const uint8_t* take(size_t length)
+    {
+        if (length > size - offset)
+        {
+            return nullptr;
+        }
+        auto bytes = data + offset;
+        offset += length;
+        return bytes;
+    }
+
+    template <Scalar T>
+    bool read(T& value)
+    {
+        auto bytes = take(sizeof(value));
+        if (bytes)
+        {
+            memcpy(&value, bytes, sizeof(value));
+        }
+        return bytes;
+    }
+
+    bool read(std::string& value)
+    {
+        uint32_t length = 0;
+        const uint8_t* bytes = nullptr;
+        if (!read(length) || !(bytes = take(length)))
+        {
+            return false;
+        }
+        value.assign(reinterpret_cast<const char*>(bytes), length);
+        return true;
+    }
+
+    bool read(std::vector<uint8_t>& value)
+    {
+        uint32_t length = 0;
+        const uint8_t* bytes = nullptr;
+        if (!read(length) || !(bytes = take(length)))
+        {
+            return false;
+        }
+        value.assign(bytes, bytes + length);
+        return true;
+    }
+
+    bool read(PropertyValue& value)
+    {
+        uint8_t index = 0;
+        return read(index) &&
+               readAlternative(
+                   index, value,
+                   std::make_index_sequence<
+                       std::variant_size_v<PropertyValue>>());
+    }
+
+    bool read(pdr_utils::DbusObjMaps& maps)
+    {
+        uint32_t count = 0;
+        if (!read(count))
+        {
+            return false;
+        }
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            uint16_t id = 0;
+            uint32_t mappingCount = 0;
+            if (!read(id) || !read(mappingCount))
+            {
+                return false;
+            }
+
+            pdr_utils::DbusMappings dbusMappings;
+            for (uint32_t j = 0; j < mappingCount; ++j)
+            {
+                pldm::utils::DBusMapping dbusMapping;
+                if (!read(dbusMapping.objectPath) ||
+                    !read(dbusMapping.interface) ||
+                    !read(dbusMapping.propertyName) ||
+                    !read(dbusMapping.propertyType))
+                {
+                    return false;
+                }
+                dbusMappings.emplace_back(std::move(dbusMapping));
+            }
+
+            uint32_t valMapCount = 0;
+            if (!read(valMapCount))
+            {
+                return false;
+            }
+            pdr_utils::DbusValMaps dbusValMaps;
+            for (uint32_t j = 0; j < valMapCount; ++j)
+            {
+                uint32_t valueCount = 0;
+                if (!read(valueCount))
+                {
+                    return false;
+                }
+                pdr_utils::StatestoDbusVal dbusValMap;
+                for (uint32_t k = 0; k < valueCount; ++k)
+                {
+                    pdr_utils::State state = 0;
+                    PropertyValue value;
+                    if (!read(state) || !read(value))
+                    {
+                        return false;
+                    }
+                    dbusValMap.emplace(state, std::move(value));
+                }
+                dbusValMaps.emplace_back(std::move(dbusValMap));
+            }
+
+            maps.emplace(id, std::make_tuple(std::move(dbusMappings),
+                                             std::move(dbusValMaps)));
+        }
+        return true;
+    }
+
+  private:
+    template <size_t... I>
+    bool readAlternative(size_t index, PropertyValue& value,
+                         std::index_sequence<I...>)
+    {
+        bool found = false;
+        bool ok = false;
+        ((index == I ? (found = true, ok = readAs<I>(value)) : false) || ...);
+        return found && ok;
+    }
+
+    template <size_t I>
+    bool readAs(PropertyValue& value)
+    {
+        std::variant_alternative_t<I, PropertyValue> alternative{};
+        if (!read(alternative))
+        {
+            return false;
+        }
+        value.emplace<I>(std::move(alternative));
+        return true;
+    }
+
+    const uint8_t* data;
+    size_t size;
+    size_t offset = 0;
+};
+
+/** @struct Mapping
+ *
+ *  Read-only mapping of a file
+ */
+struct Mapping
+{
+    explicit Mapping(const fs::path& file)
+    {
+        int fd = open(file.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            return;
+        }
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            auto mem = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (MAP_FAILED != mem)
+            {
+                data = static_cast<const uint8_t*>(mem);
+                size = st.st_size;
+            }
+        }
+        close(fd);
+    }
+
+    Mapping(const Mapping&) = delete;
+    Mapping& operator=(const Mapping&) = delete;
+
+    ~Mapping()
+    {
+        if (data)
+        {
+            munmap(const_cast<uint8_t*>(data), size);
+        }
+    }
+
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+};
+
+} // namespace
+
+uint64_t computeKey(const std::vector<fs::path>& dirs,
+                    const std::map<std::string, pldm_entity>& entities,
+                    uint16_t nextEffecterId, uint16_t nextSensorId)
+{
+    Hash hash;
+    hash.update(snapshotVersion);
+
+    std::vector<char> buffer(64 * 1024);
+    for (const auto& dir : dirs)
+    {
+        hash.update(dir.string());
+
+        std::error_code ec;
+        std::vector<fs::path> files;
+        for (const auto& entry : fs::directory_iterator(dir, ec))
+        {
+            if (entry.is_regular_file(ec))
+            {
+                files.push_back(entry.path());
+            }
+        }
+        std::sort(files.begin(), files.end());
+
+        for (const auto& file : files)
+        {
+            hash.update(file.filename().string());
+            std::ifstream jsonFile(file, std::ios::binary);
+            while (jsonFile.read(buffer.data(), buffer.size()) ||
+                   jsonFile.gcount())
+            {
+                hash.update(buffer.data(), jsonFile.gcount());
+            }
+        }
+    }
+
+    for (const auto& [path, entity] : entities)
+    {
+        hash.update(path);
+        hash.update(entity.entity_type);
+        hash.update(entity.entity_instance_num);
+        hash.update(entity.entity_container_id);
+    }
+    hash.update(nextEffecterId);
+    hash.update(nextSensorId);
+
+    return hash.value();
+}
+
+bool load(const fs::path& file, uint64_t key, pdr_utils::RepoInterface& repo,
+          Snapshot& snapshot)
+{
+    Mapping mapping(file);
+    if (mapping.size < sizeof(Header) + sizeof(uint32_t))
+    {
+        return false;
+    }
+
+    Header header;
+    memcpy(&header, mapping.data, sizeof(header));
+    if (header.magic != snapshotMagic || header.version != snapshotVersion ||
+        header.key != key)
+    {
+        std::cout << "PDR snapshot is stale, generating the PDRs, PATH="
+                  << file << "\n";
+        return false;
+    }
+
+    auto size = mapping.size - sizeof(uint32_t);
+    uint32_t checksum = 0;
+    memcpy(&checksum, mapping.data + size, sizeof(checksum));
+    if (checksum != crc32(mapping.data, size))
+    {
+        std::cerr << "PDR snapshot is corrupt, PATH=" << file << "\n";
+        return false;
+    }
+
+    // Go through the whole snapshot before touching the repository
+    Reader reader(mapping.data + sizeof(Header), size - sizeof(Header));
+    std::vector<pdr_utils::PdrEntry> records;
+    for (uint32_t i = 0; i < header.recordCount; ++i)
+    {
+        uint32_t recordSize = 0;
+        const uint8_t* record = nullptr;
+        if (!reader.read(recordSize) || recordSize < sizeof(pldm_pdr_hdr) ||
+            !(record = reader.take(recordSize)))
+        {
+            std::cerr << "PDR snapshot is corrupt, PATH=" << file << "\n";
+            return false;
+        }
+        pdr_utils::PdrEntry pdrEntry{};
+        pdrEntry.data = const_cast<uint8_t*>(record);
+        pdrEntry.size = recordSize;
+        records.emplace_back(pdrEntry);
+    }
+
+    Snapshot loaded{header.nextEffecterId, header.nextSensorId, {}, {}};
+    if (!reader.read(loaded.effecterDbusObjMaps) ||
+        !reader.read(loaded.sensorDbusObjMaps))
+    {
+        std::cerr << "PDR snapshot is corrupt, PATH=" << file << "\n";
+        return false;
+    }
+
+    // The repository copies the records, and assigns them their handles
+    for (const auto& pdrEntry : records)
+    {
+        repo.addRecord(pdrEntry);
+    }
+    snapshot = std::move(loaded);
+    return true;
+}
+
+bool save(const fs::path& file, uint64_t key, pdr_utils::RepoInterface& repo,
+          uint32_t firstRecord, const Snapshot& snapshot)
+{
+    Header header{snapshotMagic,         snapshotVersion,
+                  key,                   snapshot.nextEffecterId,
+                  snapshot.nextSensorId, 0};
+    Writer writer;
+    writer.write(&header, sizeof(header));
+
+    pdr_utils::PdrEntry pdrEntry{};
+    uint32_t index = 0;
+    for (auto record = repo.getFirstRecord(pdrEntry); record;
+         record = repo.getNextRecord(record, pdrEntry), ++index)
+    {
+        if (index >= firstRecord)
+        {
+            writer.write(pdrEntry.size);
+            writer.write(pdrEntry.data, pdrEntry.size);
+            ++header.recordCount;
+        }
+    }
+    memcpy(writer.buffer.data() + offsetof(Header, recordCount),
+           &header.recordCount, sizeof(header.recordCount));
+
+    writer.write(snapshot.effecterDbusObjMaps);
+    writer.write(snapshot.sensorDbusObjMaps);
+    writer.write(crc32(writer.buffer.data(), writer.buffer.size()));
+
+    try
+    {
+        fs::create_directories(file.parent_path());
+
+        // Write to a temporary file and rename it over the snapshot, so that
+        // a crash mid-write never leaves a truncated snapshot behind
+        auto tmpFile = file;
+        tmpFile += ".tmp";
+        {
+            std::ofstream os;
+            os.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+            os.open(tmpFile, std::ios::binary);
+            os.write(reinterpret_cast<const char*>(writer.buffer.data()),
+                     writer.buffer.size());
+        }
+
+        // Sync the data before renaming, or a power loss may leave an empty
+        // snapshot in place of the previous one
+        auto fd = open(tmpFile.c_str(), O_RDONLY);
+        if (fd < 0 || fsync(fd) < 0)
+        {
+            auto rc = errno;
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+            throw std::system_error(rc, std::generic_category(),
+                                    "fsync failed");
+        }
+        close(fd);
+        fs::rename(tmpFile, file);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Failed to save the PDR snapshot, PATH=" << file
+                  << " ERROR=" << e.what() << "\n";
+        return false;
+    }
+    return true;
+}
+
+} // namespace pdr_snapshot
+
+} // namespace responder
+
+} // namespace pldm
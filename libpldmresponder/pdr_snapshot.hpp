@@ -0,0 +1,87 @@
+#pragma once
+
+#include "libpldm/pdr.h"
+
+#include "pdr_utils.hpp"
+
+#include <stdint.h>
+
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace pldm
+{
+
+namespace responder
+{
+
+namespace pdr_snapshot
+{
+
+namespace fs = std::filesystem;
+
+/** @struct Snapshot
+ *
+ *  What platform::Handler::generate builds out of the PDR JSONs, besides the
+ *  PDRs themselves
+ */
+struct Snapshot
+{
+    uint16_t nextEffecterId = 0; //!< last effecter ID assigned
+    uint16_t nextSensorId = 0;   //!< last sensor ID assigned
+    pdr_utils::DbusObjMaps effecterDbusObjMaps;
+    pdr_utils::DbusObjMaps sensorDbusObjMaps;
+};
+
+/** @brief Compute the key of the PDRs generated out of a PDR JSON set
+ *
+ *  The key covers the content of the JSON files and the directories they are
+ *  in, the one of the system type among them, and the rest of the input of
+ *  the generation: the entities of the FRU table and the IDs assigned so far.
+ *
+ *  @param[in] dirs - directories housing the PDR JSON files
+ *  @param[in] entities - entities of the FRU table by D-Bus object path
+ *  @param[in] nextEffecterId - last effecter ID assigned
+ *  @param[in] nextSensorId - last sensor ID assigned
+ *
+ *  @return the key
+ */
+uint64_t computeKey(const std::vector<fs::path>& dirs,
+                    const std::map<std::string, pldm_entity>& entities,
+                    uint16_t nextEffecterId, uint16_t nextSensorId);
+
+/** @brief Load a snapshot of generated PDRs, the PDRs are added to the
+ *         repository straight from the mapping of the file
+ *
+ *  @param[in] file - snapshot file
+ *  @param[in] key - key of the PDRs to generate
+ *  @param[in] repo - PDR repository to add the PDRs to
+ *  @param[out] snapshot - the rest of the snapshot
+ *
+ *  @return true if loaded, false if the snapshot is missing, was taken with
+ *          another key or is corrupt, the repository is left untouched then
+ */
+bool load(const fs::path& file, uint64_t key, pdr_utils::RepoInterface& repo,
+          Snapshot& snapshot);
+
+/** @brief Save a snapshot of generated PDRs
+ *
+ *  @param[in] file - snapshot file
+ *  @param[in] key - key of the generated PDRs
+ *  @param[in] repo - PDR repository
+ *  @param[in] firstRecord - index of the first generated PDR in the
+ *                           repository, the PDRs after it are generated too
+ *  @param[in] snapshot - the rest of the snapshot
+ *
+ *  @return true if saved
+ */
+bool save(const fs::path& file, uint64_t key, pdr_utils::RepoInterface& repo,
+          uint32_t firstRecord, const Snapshot& snapshot);
+
+} // namespace pdr_snapshot
+
+} // namespace responder
+
+} // namespace pldm
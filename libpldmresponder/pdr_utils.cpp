@@ -7,6 +7,7 @@
 
 #include <bitset>
 #include <climits>
+#include <cstddef>
 
 using namespace pldm::pdr;
 
@@ -26,8 +27,31 @@ pldm_pdr* Repo::getPdr() const
 
 RecordHandle Repo::addRecord(const PdrEntry& pdrEntry)
 {
-    return pldm_pdr_add(repo, pdrEntry.data, pdrEntry.size,
-                        pdrEntry.handle.recordHandle, false, TERMINUS_HANDLE);
+    bool indexCurrent = idIndexGeneration == pldm_pdr_get_generation(repo);
+    auto recordHandle =
+        pldm_pdr_add(repo, pdrEntry.data, pdrEntry.size,
+                     pdrEntry.handle.recordHandle, false, TERMINUS_HANDLE);
+    if (indexCurrent)
+    {
+        uint8_t* pdrData = nullptr;
+        uint32_t pdrSize{};
+        uint32_t nextRecordHandle{};
+        auto record = pldm_pdr_find_record(repo, recordHandle, &pdrData,
+                                           &pdrSize, &nextRecordHandle);
+        // A remote PDR may share the handle, rebuild the index from the
+        // records then
+        if (record && !record->is_remote)
+        {
+            indexRecord(record);
+            idIndexGeneration = pldm_pdr_get_generation(repo);
+        }
+        else
+        {
+            idIndexGeneration.reset();
+        }
+    }
+
+    return recordHandle;
 }
 
 const pldm_pdr_record* Repo::getFirstRecord(PdrEntry& pdrEntry)
@@ -75,6 +99,83 @@ bool Repo::empty()
     return !getRecordCount();
 }
 
+static inline uint32_t idIndexKey(Type pdrType, uint16_t id)
+{
+    return (static_cast<uint32_t>(pdrType) << 16) | id;
+}
+
+void Repo::indexRecord(const pldm_pdr_record* record)
+{
+    if (!record || record->size < offsetof(pldm_state_sensor_pdr, sensor_id) +
+                                      sizeof(uint16_t))
+    {
+        return;
+    }
+
+    // The sensor ID and effecter ID share the same offset in all of the
+    // indexed PDR types
+    auto hdr = reinterpret_cast<const pldm_pdr_hdr*>(record->data);
+    switch (hdr->type)
+    {
+        case PLDM_STATE_SENSOR_PDR:
+        {
+            auto pdr =
+                reinterpret_cast<const pldm_state_sensor_pdr*>(record->data);
+            idIndex.try_emplace(idIndexKey(hdr->type, pdr->sensor_id),
+                                record);
+            break;
+        }
+        case PLDM_STATE_EFFECTER_PDR:
+        case PLDM_NUMERIC_EFFECTER_PDR:
+        {
+            auto pdr =
+                reinterpret_cast<const pldm_state_effecter_pdr*>(record->data);
+            idIndex.try_emplace(idIndexKey(hdr->type, pdr->effecter_id),
+                                record);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void Repo::refreshIdIndex()
+{
+    auto generation = pldm_pdr_get_generation(repo);
+    if (idIndexGeneration == generation)
+    {
+        return;
+    }
+
+    idIndex.clear();
+    for (auto record = repo->first; record != nullptr; record = record->next)
+    {
+        indexRecord(record);
+    }
+    idIndexGeneration = generation;
+}
+
+const pldm_pdr_record* Repo::getRecordById(Type pdrType, uint16_t id,
+                                           PdrEntry& pdrEntry)
+{
+    refreshIdIndex();
+    auto it = idIndex.find(idIndexKey(pdrType, id));
+    if (it == idIndex.end())
+    {
+        return nullptr;
+    }
+
+    // The index holds the records themselves rather than their handles, a
+    // handle may be shared with a remote PDR or renumbered
+    auto record = it->second;
+    pdrEntry.data = record->data;
+    pdrEntry.size = record->size;
+    pdrEntry.handle.nextRecordHandle =
+        record->next ? record->next->record_handle : 0;
+
+    return record;
+}
+
 StatestoDbusVal populateMapping(const std::string& type, const Json& dBusValues,
                                 const PossibleValues& pv)
 {
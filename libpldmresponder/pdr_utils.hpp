@@ -14,7 +14,9 @@
 #include <fstream>
 #include <functional>
 #include <iostream>
+#include <optional>
 #include <string>
+#include <unordered_map>
 
 using InternalFailure =
     sdbusplus::xyz::openbmc_project::Common::Error::InternalFailure;
@@ -220,6 +222,38 @@ class Repo : public RepoInterface
     uint32_t getRecordCount() override;
 
     bool empty() override;
+
+    /** @brief Get a sensor or effecter PDR by its sensor/effecter ID
+     *
+     *  @param[in] pdrType - PLDM_STATE_SENSOR_PDR, PLDM_STATE_EFFECTER_PDR or
+     *                       PLDM_NUMERIC_EFFECTER_PDR
+     *  @param[in] id - sensor ID or effecter ID
+     *  @param[out] pdrEntry - PDR records entry(data, size, nextRecordHandle)
+     *
+     *  @return opaque pointer acting as PDR record handle, will be NULL if
+     *          record was not found
+     */
+    const pldm_pdr_record* getRecordById(Type pdrType, uint16_t id,
+                                         PdrEntry& pdrEntry);
+
+  private:
+    /** @brief Index the sensor/effecter ID of a PDR record, if it has one
+     *
+     *  @param[in] record - opaque pointer acting as a PDR record handle
+     */
+    void indexRecord(const pldm_pdr_record* record);
+
+    /** @brief Rebuild the ID index if the repository changed behind it */
+    void refreshIdIndex();
+
+    /** @brief Map of (PDR type, sensor/effecter ID) to record, the first
+     *         record in the repository wins on duplicate IDs. The records
+     *         are only valid for the generation the index was built for.
+     */
+    std::unordered_map<uint32_t, const pldm_pdr_record*> idIndex;
+
+    /** @brief Repository generation the ID index was built for */
+    std::optional<uint32_t> idIndexGeneration;
 };
 
 /** @brief Parse the State Sensor PDR and return the parsed sensor info which
@@ -2,7 +2,9 @@
 
 #include "libpldm/entity.h"
 #include "libpldm/state_set.h"
+#include "libpldm/utils.h"
 
+#include "common/deferred_response.hpp"
 #include "common/types.hpp"
 #include "common/utils.hpp"
 #include "event_parser.hpp"
@@ -10,6 +12,7 @@
 #include "host-bmc/dbus/serialize.hpp"
 #include "pdr.hpp"
 #include "pdr_numeric_effecter.hpp"
+#include "pdr_snapshot.hpp"
 #include "pdr_state_effecter.hpp"
 #include "pdr_state_sensor.hpp"
 #include "pdr_utils.hpp"
@@ -19,9 +22,13 @@
 
 #include <config.h>
 
+#include <algorithm>
+#include <optional>
+
 using namespace pldm::utils;
 using namespace pldm::responder::pdr;
 using namespace pldm::responder::pdr_utils;
+using pldm::deferred::DeferredResponse;
 
 namespace pldm
 {
@@ -76,6 +83,38 @@ void Handler::generate(const pldm::utils::DBusHandler& dBusIntf,
         }
     }
 
+    // The PDRs generated out of the same JSONs and FRU table on an earlier run
+    // of pldmd are loaded, rather than parsing the JSONs and looking up the
+    // D-Bus services of the sensors and effecters again
+    std::optional<uint64_t> snapshotKey{};
+    if (!pdrSnapshotFile.empty())
+    {
+        static const AssociatedEntityMap noEntities{};
+        snapshotKey = pdr_snapshot::computeKey(
+            dir, fruHandler ? getAssociateEntityMap() : noEntities,
+            nextEffecterId, nextSensorId);
+
+        pdr_snapshot::Snapshot snapshot;
+        if (pdr_snapshot::load(pdrSnapshotFile, *snapshotKey, repo, snapshot))
+        {
+            nextEffecterId = snapshot.nextEffecterId;
+            nextSensorId = snapshot.nextSensorId;
+            effecterDbusObjMaps.merge(snapshot.effecterDbusObjMaps);
+            sensorDbusObjMaps.merge(snapshot.sensorDbusObjMaps);
+
+            if (fruHandler)
+            {
+                fruHandler->setStatePDRParams(
+                    pdrJsonsDir, getNextSensorId(), getNextEffecterId(),
+                    sensorDbusObjMaps, effecterDbusObjMaps, false);
+            }
+            return;
+        }
+    }
+    auto firstRecord = repo.getRecordCount();
+    auto knownEffecters = effecterDbusObjMaps;
+    auto knownSensors = sensorDbusObjMaps;
+
     // A map of PDR type to a lambda that handles creation of that PDR type.
     // The lambda essentially would parse the platform specific PDR JSONs to
     // generate the PDR structures. This function iterates through the map to
@@ -163,6 +202,12 @@ void Handler::generate(const pldm::utils::DBusHandler& dBusIntf,
         }
     }
 
+    if (snapshotKey)
+    {
+        savePDRSnapshot(*snapshotKey, repo, firstRecord, knownEffecters,
+                        knownSensors);
+    }
+
     if (fruHandler)
     {
         fruHandler->setStatePDRParams(pdrJsonsDir, getNextSensorId(),
@@ -171,60 +216,153 @@ void Handler::generate(const pldm::utils::DBusHandler& dBusIntf,
     }
 }
 
-Response Handler::getPDR(const pldm_msg* request, size_t payloadLength)
+void Handler::savePDRSnapshot(uint64_t key, Repo& repo, uint32_t firstRecord,
+                              const DbusObjMaps& knownEffecters,
+                              const DbusObjMaps& knownSensors)
 {
-    if (oemPlatformHandler != nullptr)
-    {
-        //  we assume that the entity manager
-        // already sends the system type information before we
-        // reach BMC ready state.
-        auto rc = oemPlatformHandler->checkBMCState();
-        if (rc != PLDM_SUCCESS)
+    pdr_snapshot::Snapshot snapshot{nextEffecterId, nextSensorId, {}, {}};
+    auto generated = [](const DbusObjMaps& maps, const DbusObjMaps& known,
+                        DbusObjMaps& snapshotMaps) {
+        for (const auto& [id, dbusObj] : maps)
         {
-            return ccOnlyResponse(request, PLDM_ERROR_NOT_READY);
+            if (known.contains(id))
+            {
+                continue;
+            }
+            // A D-Bus object missing at this point of the boot leaves its
+            // mapping empty, it is not worth keeping for the next runs
+            for (const auto& dbusMapping : std::get<0>(dbusObj))
+            {
+                if (dbusMapping.objectPath.empty())
+                {
+                    return false;
+                }
+            }
+            snapshotMaps.emplace(id, dbusObj);
         }
-    }
+        return true;
+    };
 
-    // Build FRU table if not built, since entity association PDR's
-    // are built when the FRU table is constructed.
-    if (fruHandler)
+    if (!generated(effecterDbusObjMaps, knownEffecters,
+                   snapshot.effecterDbusObjMaps) ||
+        !generated(sensorDbusObjMaps, knownSensors,
+                   snapshot.sensorDbusObjMaps))
     {
-        fruHandler->buildFRUTable();
+        std::cerr << "Not all the D-Bus objects of the PDRs are present, the "
+                     "PDR snapshot is not saved\n";
+        return;
     }
+    pdr_snapshot::save(pdrSnapshotFile, key, repo, firstRecord, snapshot);
+}
 
-    if (!pdrCreated)
+void Handler::buildPDRStep(sdeventplus::source::EventBase& /*source*/)
+{
+    if (pdrState == PDRState::Waiting)
     {
-        generateTerminusLocatorPDR(pdrRepo);
-
-        if (oemPlatformHandler != nullptr)
+        if (!checkPDRDependencies())
         {
-            auto systemType = oemPlatformHandler->getConfigDir();
-            if (!systemType.empty())
-            {
-                // In case of normal poweron , the system type would have been
-                // already filled by entity manager when ever BMC reaches Ready
-                // state. If this is not filled by time we get a getpdr request
-                // we can assume that the entity manager service is not present
-                // on this system & continue to build the common PDR's.
-                pdrJsonsDir.push_back(pdrJsonDir /
-                                      oemPlatformHandler->getConfigDir());
-            }
-            oemPlatformHandler->buildOEMPDR(pdrRepo);
+            return;
         }
-        generate(*dBusIntf, pdrJsonsDir, pdrRepo, bmcEntityTree);
+        bmcStateMatch.reset();
+        pdrState = PDRState::Building;
+    }
+    else
+    {
+        switch (buildStep)
+        {
+            case BuildStep::FRUPresence:
+                buildStep = BuildStep::FRUTable;
+                if (fruHandler)
+                {
+                    // The next step runs once the D-Bus replies are in
+                    fruHandler->checkFruPresence([this]() {
+                        buildPDREvent->set_enabled(
+                            sdeventplus::source::Enabled::OneShot);
+                    });
+                    return;
+                }
+                break;
 
-        pdrCreated = true;
+            case BuildStep::FRUTable:
+                // Entity association PDRs are built along with the FRU table
+                if (fruHandler)
+                {
+                    fruHandler->buildFRUTable();
+                }
+                buildStep = BuildStep::PlatformPDRs;
+                break;
 
-        if (dbusToPLDMEventHandler)
-        {
-            deferredGetPDREvent = std::make_unique<sdeventplus::source::Defer>(
-                event,
-                std::bind(std::mem_fn(&pldm::responder::platform::Handler::
-                                          _processPostGetPDRActions),
-                          this, std::placeholders::_1));
+            case BuildStep::PlatformPDRs:
+                generateTerminusLocatorPDR(pdrRepo);
+                if (oemPlatformHandler != nullptr)
+                {
+                    // The entity manager fills the system type before the BMC
+                    // is ready, if it has not, it is not present on this
+                    // system and the common PDRs are built alone.
+                    auto systemType = oemPlatformHandler->getConfigDir();
+                    if (!systemType.empty())
+                    {
+                        pdrJsonsDir.push_back(pdrJsonDir / systemType);
+                    }
+                    oemPlatformHandler->buildOEMPDR(pdrRepo);
+                }
+                buildStep = BuildStep::JsonPDRs;
+                break;
+
+            case BuildStep::JsonPDRs:
+                generate(*dBusIntf, pdrJsonsDir, pdrRepo, bmcEntityTree);
+                pdrState = PDRState::Ready;
+                if (fruHandler)
+                {
+                    fruHandler->setReady(true);
+                }
+                if (dbusToPLDMEventHandler)
+                {
+                    dbusToPLDMEventHandler->listenSensorEvent(
+                        pdrRepo, sensorDbusObjMaps);
+                }
+                buildPDREvent.reset();
+                return;
         }
     }
 
+    // Defer sources are one shot, the next step runs on the next idle
+    // iteration of the event loop
+    buildPDREvent->set_enabled(sdeventplus::source::Enabled::OneShot);
+}
+
+bool Handler::checkPDRDependencies()
+{
+    if (oemPlatformHandler == nullptr)
+    {
+        return true;
+    }
+
+    if (!bmcStateMatch)
+    {
+        bmcStateMatch = std::make_unique<sdbusplus::bus::match::match>(
+            pldm::utils::DBusHandler::getBus(),
+            sdbusplus::bus::match::rules::propertiesChanged(
+                "/xyz/openbmc_project/state/bmc0",
+                "xyz.openbmc_project.State.BMC"),
+            [this](sdbusplus::message::message&) {
+                buildPDREvent->set_enabled(
+                    sdeventplus::source::Enabled::OneShot);
+            });
+    }
+    // The FRU table and the system type are there by the time the BMC is
+    // ready
+    return oemPlatformHandler->checkBMCState() == PLDM_SUCCESS;
+}
+
+Response Handler::getPDR(const pldm_msg* request, size_t payloadLength)
+{
+    // The PDRs are built in the background, never on the request path
+    if (pdrState != PDRState::Ready)
+    {
+        return ccOnlyResponse(request, PLDM_ERROR_NOT_READY);
+    }
+
     Response response(sizeof(pldm_msg_hdr) + PLDM_GET_PDR_MIN_RESP_BYTES, 0);
 
     if (payloadLength != PLDM_GET_PDR_REQ_BYTES)
@@ -255,6 +393,13 @@ Response Handler::getPDR(const pldm_msg* request, size_t payloadLength)
         return CmdHandler::ccOnlyResponse(request, rc);
     }
 
+    if (transferOpFlag != PLDM_GET_FIRSTPART &&
+        transferOpFlag != PLDM_GET_NEXTPART)
+    {
+        return CmdHandler::ccOnlyResponse(
+            request, PLDM_PLATFORM_INVALID_TRANSFER_OPERATION_FLAG);
+    }
+
     uint16_t respSizeBytes{};
     uint8_t* recordData = nullptr;
     try
@@ -267,22 +412,65 @@ Response Handler::getPDR(const pldm_msg* request, size_t payloadLength)
                 request, PLDM_PLATFORM_INVALID_RECORD_HANDLE);
         }
 
-        if (reqSizeBytes)
+        // A record larger than the requested size is sent in parts, the data
+        // transfer handle being the offset of the next part in the record. A
+        // GetNextPart with handle 0 gets the first part, as requesters that
+        // do not set the operation flag have been doing.
+        uint32_t offset = 0;
+        if (transferOpFlag == PLDM_GET_NEXTPART && dataTransferHandle)
         {
-            respSizeBytes = e.size;
-            if (respSizeBytes > reqSizeBytes)
+            if (dataTransferHandle >= e.size)
+            {
+                return CmdHandler::ccOnlyResponse(
+                    request, PLDM_PLATFORM_INVALID_DATA_TRANSFER_HANDLE);
+            }
+            // A size of 0 only queries the record, it cannot end a transfer
+            if (!reqSizeBytes)
             {
-                respSizeBytes = reqSizeBytes;
+                return CmdHandler::ccOnlyResponse(request,
+                                                  PLDM_ERROR_INVALID_DATA);
             }
-            recordData = e.data;
+            offset = dataTransferHandle;
+        }
+
+        if (reqSizeBytes)
+        {
+            respSizeBytes = std::min<uint32_t>(e.size - offset, reqSizeBytes);
+            recordData = e.data + offset;
+        }
+
+        uint32_t nextDataTransferHandle = 0;
+        uint8_t transferFlag = PLDM_START_AND_END;
+        uint8_t transferCRC = 0;
+        bool lastPart = !reqSizeBytes || offset + respSizeBytes == e.size;
+        if (offset == 0 && !lastPart)
+        {
+            transferFlag = PLDM_START;
+        }
+        else if (offset != 0)
+        {
+            transferFlag = lastPart ? PLDM_END : PLDM_MIDDLE;
         }
+        if (!lastPart)
+        {
+            nextDataTransferHandle = offset + respSizeBytes;
+        }
+        if (transferFlag == PLDM_END)
+        {
+            transferCRC = crc8(e.data, e.size);
+        }
+
         response.resize(sizeof(pldm_msg_hdr) + PLDM_GET_PDR_MIN_RESP_BYTES +
-                            respSizeBytes,
+                            respSizeBytes +
+                            (transferFlag == PLDM_END ? sizeof(transferCRC)
+                                                      : 0),
                         0);
         auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
-        rc = encode_get_pdr_resp(
-            request->hdr.instance_id, PLDM_SUCCESS, e.handle.nextRecordHandle,
-            0, PLDM_START_AND_END, respSizeBytes, recordData, 0, responsePtr);
+        rc = encode_get_pdr_resp(request->hdr.instance_id, PLDM_SUCCESS,
+                                 e.handle.nextRecordHandle,
+                                 nextDataTransferHandle, transferFlag,
+                                 respSizeBytes, recordData, transferCRC,
+                                 responsePtr);
         if (rc != PLDM_SUCCESS)
         {
             return ccOnlyResponse(request, rc);
@@ -300,6 +488,13 @@ Response Handler::getPDR(const pldm_msg* request, size_t payloadLength)
 Response Handler::setStateEffecterStates(const pldm_msg* request,
                                          size_t payloadLength)
 {
+    // The effecter and sensor lookups go through the PDRs, built in the
+    // background
+    if (pdrState != PDRState::Ready)
+    {
+        return ccOnlyResponse(request, PLDM_ERROR_NOT_READY);
+    }
+
     Response response(
         sizeof(pldm_msg_hdr) + PLDM_SET_STATE_EFFECTER_STATES_RESP_BYTES, 0);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
@@ -340,6 +535,29 @@ Response Handler::setStateEffecterStates(const pldm_msg* request,
             entityType, entityInstance, stateSetId, compEffecterCnt, stateField,
             effecterId);
     }
+    else if (DeferredResponse::GetInstance().requester())
+    {
+        // Respond once the D-Bus properties are set, without blocking
+        // meanwhile
+        pldm::utils::DBusPropertySetter setter;
+        rc = platform_state_effecter::setStateEffecterStatesHandler<
+            pldm::utils::DBusPropertySetter, Handler>(setter, *this,
+                                                      effecterId, stateField);
+        if (rc == PLDM_SUCCESS)
+        {
+            auto responder = *DeferredResponse::GetInstance().defer();
+            setter.setAsync([responder](bool set) {
+                Response response(sizeof(pldm_msg_hdr) +
+                                      PLDM_SET_STATE_EFFECTER_STATES_RESP_BYTES,
+                                  0);
+                encode_set_state_effecter_states_resp(
+                    responder.instanceId(), set ? PLDM_SUCCESS : PLDM_ERROR,
+                    reinterpret_cast<pldm_msg*>(response.data()));
+                responder.send(std::move(response));
+            });
+            return response;
+        }
+    }
     else
     {
         rc = platform_state_effecter::setStateEffecterStatesHandler<
@@ -671,6 +889,11 @@ int Handler::getPDRRecordHandles(const ChangeEntry* changeEntryData,
 Response Handler::setNumericEffecterValue(const pldm_msg* request,
                                           size_t payloadLength)
 {
+    if (pdrState != PDRState::Ready)
+    {
+        return ccOnlyResponse(request, PLDM_ERROR_NOT_READY);
+    }
+
     Response response(sizeof(pldm_msg_hdr) +
                       PLDM_SET_NUMERIC_EFFECTER_VALUE_RESP_BYTES);
     uint16_t effecterId{};
@@ -705,6 +928,31 @@ Response Handler::setNumericEffecterValue(const pldm_msg* request,
             entityType, entityInstance, effecterSemanticId, effecterDataSize,
             effecterValue, effecterOffset, effecterResolution, effecterId);
     }
+    else if (DeferredResponse::GetInstance().requester())
+    {
+        // Respond once the D-Bus property is set, without blocking meanwhile
+        pldm::utils::DBusPropertySetter setter;
+        rc = platform_numeric_effecter::setNumericEffecterValueHandler<
+            pldm::utils::DBusPropertySetter, Handler>(
+            setter, *this, effecterId, effecterDataSize, effecterValue,
+            sizeof(effecterValue));
+        if (rc == PLDM_SUCCESS)
+        {
+            auto responder = *DeferredResponse::GetInstance().defer();
+            setter.setAsync([responder](bool set) {
+                Response response(
+                    sizeof(pldm_msg_hdr) +
+                        PLDM_SET_NUMERIC_EFFECTER_VALUE_RESP_BYTES,
+                    0);
+                encode_set_numeric_effecter_value_resp(
+                    responder.instanceId(), set ? PLDM_SUCCESS : PLDM_ERROR,
+                    reinterpret_cast<pldm_msg*>(response.data()),
+                    PLDM_SET_NUMERIC_EFFECTER_VALUE_RESP_BYTES);
+                responder.send(std::move(response));
+            });
+            return response;
+        }
+    }
     else
     {
         rc = platform_numeric_effecter::setNumericEffecterValueHandler<
@@ -753,6 +1001,11 @@ void Handler::generateTerminusLocatorPDR(Repo& repo)
 Response Handler::getStateSensorReadings(const pldm_msg* request,
                                          size_t payloadLength)
 {
+    if (pdrState != PDRState::Ready)
+    {
+        return ccOnlyResponse(request, PLDM_ERROR_NOT_READY);
+    }
+
     uint16_t sensorId{};
     bitfield8_t sensorRearm{};
     uint8_t reserved{};
@@ -817,13 +1070,6 @@ Response Handler::getStateSensorReadings(const pldm_msg* request,
     return response;
 }
 
-void Handler::_processPostGetPDRActions(sdeventplus::source::EventBase&
-                                        /*source */)
-{
-    deferredGetPDREvent.reset();
-    dbusToPLDMEventHandler->listenSensorEvent(pdrRepo, sensorDbusObjMaps);
-}
-
 bool isOemNumericEffecter(Handler& handler, uint16_t effecterId,
                           uint16_t& entityType, uint16_t& entityInstance,
                           uint8_t& effecterDataSize,
@@ -831,33 +1077,14 @@ bool isOemNumericEffecter(Handler& handler, uint16_t effecterId,
                           real32_t& effecterOffset,
                           real32_t& effecterResolution)
 {
-    pldm_numeric_effecter_value_pdr* pdr = nullptr;
-
-    std::unique_ptr<pldm_pdr, decltype(&pldm_pdr_destroy)>
-        numericEffecterPdrRepo(pldm_pdr_init(), pldm_pdr_destroy);
-    pldm::responder::pdr_utils::Repo numericEffecterPDRs(
-        numericEffecterPdrRepo.get());
-    pldm::responder::pdr::getRepoByType(handler.getRepo(), numericEffecterPDRs,
-                                        PLDM_NUMERIC_EFFECTER_PDR);
-
-    if (numericEffecterPDRs.empty())
-    {
-        std::cerr << "Failed to get record by PDR type\n";
-        return false;
-    }
-
     PdrEntry pdrEntry{};
-    auto pdrRecord = numericEffecterPDRs.getFirstRecord(pdrEntry);
-    while (pdrRecord)
+    auto pdrRecord = handler.getRepo().getRecordById(PLDM_NUMERIC_EFFECTER_PDR,
+                                                     effecterId, pdrEntry);
+    if (pdrRecord)
     {
-        pdr = reinterpret_cast<pldm_numeric_effecter_value_pdr*>(pdrEntry.data);
+        auto pdr =
+            reinterpret_cast<pldm_numeric_effecter_value_pdr*>(pdrEntry.data);
         assert(pdr != NULL);
-        if (pdr->effecter_id != effecterId)
-        {
-            pdr = nullptr;
-            pdrRecord = numericEffecterPDRs.getNextRecord(pdrRecord, pdrEntry);
-            continue;
-        }
 
         auto tmpEntityType = pdr->entity_type;
         auto tmpEntityInstance = pdr->entity_instance;
@@ -893,30 +1120,13 @@ bool isOemStateSensor(Handler& handler, uint16_t sensorId,
                       uint16_t& entityType, uint16_t& entityInstance,
                       uint16_t& stateSetId, uint16_t& containerId)
 {
-    pldm_state_sensor_pdr* pdr = nullptr;
-
-    std::unique_ptr<pldm_pdr, decltype(&pldm_pdr_destroy)> stateSensorPdrRepo(
-        pldm_pdr_init(), pldm_pdr_destroy);
-    Repo stateSensorPDRs(stateSensorPdrRepo.get());
-    getRepoByType(handler.getRepo(), stateSensorPDRs, PLDM_STATE_SENSOR_PDR);
-    if (stateSensorPDRs.empty())
-    {
-        std::cerr << "Failed to get record by PDR type\n";
-        return false;
-    }
-
     PdrEntry pdrEntry{};
-    auto pdrRecord = stateSensorPDRs.getFirstRecord(pdrEntry);
-    while (pdrRecord)
+    auto pdrRecord = handler.getRepo().getRecordById(PLDM_STATE_SENSOR_PDR,
+                                                     sensorId, pdrEntry);
+    if (pdrRecord)
     {
-        pdr = reinterpret_cast<pldm_state_sensor_pdr*>(pdrEntry.data);
+        auto pdr = reinterpret_cast<pldm_state_sensor_pdr*>(pdrEntry.data);
         assert(pdr != NULL);
-        if (pdr->sensor_id != sensorId)
-        {
-            pdr = nullptr;
-            pdrRecord = stateSensorPDRs.getNextRecord(pdrRecord, pdrEntry);
-            continue;
-        }
         auto tmpEntityType = pdr->entity_type;
         auto tmpEntityInstance = pdr->entity_instance;
         auto tmpEntityContainerId = pdr->container_id;
@@ -932,7 +1142,7 @@ bool isOemStateSensor(Handler& handler, uint16_t sensorId,
                       << " count for the sensor, SENSOR_ID=" << sensorId
                       << "SENSOR_REARM_COUNT=" << (uint16_t)sensorRearmCount
                       << "\n";
-            break;
+            return false;
         }
 
         if ((tmpEntityType >= PLDM_OEM_ENTITY_TYPE_START &&
@@ -959,31 +1169,13 @@ bool isOemStateEffecter(Handler& handler, uint16_t effecterId,
                         uint8_t compEffecterCnt, uint16_t& entityType,
                         uint16_t& entityInstance, uint16_t& stateSetId)
 {
-    pldm_state_effecter_pdr* pdr = nullptr;
-
-    std::unique_ptr<pldm_pdr, decltype(&pldm_pdr_destroy)> stateEffecterPdrRepo(
-        pldm_pdr_init(), pldm_pdr_destroy);
-    Repo stateEffecterPDRs(stateEffecterPdrRepo.get());
-    getRepoByType(handler.getRepo(), stateEffecterPDRs,
-                  PLDM_STATE_EFFECTER_PDR);
-    if (stateEffecterPDRs.empty())
-    {
-        std::cerr << "Failed to get record by PDR type\n";
-        return false;
-    }
-
     PdrEntry pdrEntry{};
-    auto pdrRecord = stateEffecterPDRs.getFirstRecord(pdrEntry);
-    while (pdrRecord)
+    auto pdrRecord = handler.getRepo().getRecordById(PLDM_STATE_EFFECTER_PDR,
+                                                     effecterId, pdrEntry);
+    if (pdrRecord)
     {
-        pdr = reinterpret_cast<pldm_state_effecter_pdr*>(pdrEntry.data);
+        auto pdr = reinterpret_cast<pldm_state_effecter_pdr*>(pdrEntry.data);
         assert(pdr != NULL);
-        if (pdr->effecter_id != effecterId)
-        {
-            pdr = nullptr;
-            pdrRecord = stateEffecterPDRs.getNextRecord(pdrRecord, pdrEntry);
-            continue;
-        }
 
         auto tmpEntityType = pdr->entity_type;
         auto tmpEntityInstance = pdr->entity_instance;
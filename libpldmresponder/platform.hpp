@@ -18,6 +18,9 @@
 
 #include <stdint.h>
 
+#include <sdbusplus/bus/match.hpp>
+#include <sdeventplus/source/event.hpp>
+
 #include <map>
 
 namespace pldm
@@ -46,6 +49,14 @@ using EventHandlers = std::vector<EventHandler>;
 using EventMap = std::map<EventType, EventHandlers>;
 using AssociatedEntityMap = std::map<DbusPath, pldm_entity>;
 
+/** @brief State of the PDR repository of the BMC */
+enum class PDRState
+{
+    Waiting,  //!< waiting for the D-Bus objects the PDRs are built from
+    Building, //!< being built from the event loop
+    Ready     //!< built, the PDR commands are served
+};
+
 class Handler : public CmdHandler
 {
   public:
@@ -56,20 +67,32 @@ class Handler : public CmdHandler
             fru::Handler* fruHandler,
             pldm_entity_association_tree* bmcEntityTree,
             pldm::responder::oem_platform::Handler* oemPlatformHandler,
-            sdeventplus::Event& event, bool buildPDRLazily = false,
+            sdeventplus::Event& event, bool buildPDRInBackground = false,
             const std::optional<EventMap>& addOnHandlersMap = std::nullopt) :
         pdrRepo(repo),
         hostPDRHandler(hostPDRHandler),
         dbusToPLDMEventHandler(dbusToPLDMEventHandler), fruHandler(fruHandler),
         bmcEntityTree(bmcEntityTree), dBusIntf(dBusIntf),
         oemPlatformHandler(oemPlatformHandler), event(event),
-        pdrJsonDir(pdrJsonDir), pdrCreated(false), pdrJsonsDir({pdrJsonDir})
+        pdrJsonDir(pdrJsonDir), pdrJsonsDir({pdrJsonDir})
     {
-        if (!buildPDRLazily)
+        if (!buildPDRInBackground)
         {
             generateTerminusLocatorPDR(pdrRepo);
             generate(*dBusIntf, pdrJsonsDir, pdrRepo, bmcEntityTree);
-            pdrCreated = true;
+            pdrState = PDRState::Ready;
+        }
+        else
+        {
+            // The FRU table and the PDRs are built a step at a time whenever
+            // the event loop is idle, rather than on the first GetPDR
+            buildPDREvent = std::make_unique<sdeventplus::source::Defer>(
+                event, std::bind_front(&Handler::buildPDRStep, this));
+            buildPDREvent->set_priority(SD_EVENT_PRIORITY_IDLE);
+            if (fruHandler)
+            {
+                fruHandler->setReady(false);
+            }
         }
 
         handlers.emplace(PLDM_GET_PDR,
@@ -180,6 +203,17 @@ class Handler : public CmdHandler
         return ++nextSensorId;
     }
 
+    /** @brief Keep a snapshot of the PDRs generated out of the PDR JSONs and
+     *         load it instead of generating them again, as long as the JSONs
+     *         and the FRU table are the same
+     *
+     *  @param[in] file - snapshot file
+     */
+    void setPDRSnapshotFile(const fs::path& file)
+    {
+        pdrSnapshotFile = file;
+    }
+
     /** @brief Parse PDR JSONs and build PDR repository
      *
      *  @param[in] dBusIntf - The interface object
@@ -304,55 +338,29 @@ class Handler : public CmdHandler
         const DBusInterface& dBusIntf, uint16_t effecterId,
         const std::vector<set_effecter_state_field>& stateField)
     {
-        using namespace pldm::responder::pdr;
         using namespace pldm::utils;
         using StateSetNum = uint8_t;
 
-        state_effecter_possible_states* states = nullptr;
-        pldm_state_effecter_pdr* pdr = nullptr;
         uint8_t compEffecterCnt = stateField.size();
 
-        std::unique_ptr<pldm_pdr, decltype(&pldm_pdr_destroy)>
-            stateEffecterPdrRepo(pldm_pdr_init(), pldm_pdr_destroy);
-        pldm::responder::pdr_utils::Repo stateEffecterPDRs(
-            stateEffecterPdrRepo.get());
-        getRepoByType(pdrRepo, stateEffecterPDRs, PLDM_STATE_EFFECTER_PDR);
-        if (stateEffecterPDRs.empty())
-        {
-            std::cerr << "Failed to get record by PDR type\n";
-            return PLDM_PLATFORM_INVALID_EFFECTER_ID;
-        }
-
         pldm::responder::pdr_utils::PdrEntry pdrEntry{};
-        auto pdrRecord = stateEffecterPDRs.getFirstRecord(pdrEntry);
-        while (pdrRecord)
+        auto pdrRecord = pdrRepo.getRecordById(PLDM_STATE_EFFECTER_PDR,
+                                               effecterId, pdrEntry);
+        if (!pdrRecord)
         {
-            pdr = reinterpret_cast<pldm_state_effecter_pdr*>(pdrEntry.data);
-            if (pdr->effecter_id != effecterId)
-            {
-                pdr = nullptr;
-                pdrRecord =
-                    stateEffecterPDRs.getNextRecord(pdrRecord, pdrEntry);
-                continue;
-            }
-
-            states = reinterpret_cast<state_effecter_possible_states*>(
-                pdr->possible_states);
-            if (compEffecterCnt > pdr->composite_effecter_count)
-            {
-                std::cerr << "The requester sent wrong composite effecter"
-                          << " count for the effecter, EFFECTER_ID="
-                          << (unsigned)effecterId
-                          << "COMP_EFF_CNT=" << (unsigned)compEffecterCnt
-                          << "\n";
-                return PLDM_ERROR_INVALID_DATA;
-            }
-            break;
+            return PLDM_PLATFORM_INVALID_EFFECTER_ID;
         }
 
-        if (!pdr)
+        auto pdr = reinterpret_cast<pldm_state_effecter_pdr*>(pdrEntry.data);
+        auto states = reinterpret_cast<state_effecter_possible_states*>(
+            pdr->possible_states);
+        if (compEffecterCnt > pdr->composite_effecter_count)
         {
-            return PLDM_PLATFORM_INVALID_EFFECTER_ID;
+            std::cerr << "The requester sent wrong composite effecter"
+                      << " count for the effecter, EFFECTER_ID="
+                      << (unsigned)effecterId
+                      << "COMP_EFF_CNT=" << (unsigned)compEffecterCnt << "\n";
+            return PLDM_ERROR_INVALID_DATA;
         }
 
         int rc = PLDM_SUCCESS;
@@ -445,13 +453,55 @@ class Handler : public CmdHandler
         return fruHandler->getAssociateEntityMap();
     }
 
-    /** @brief process the actions that needs to be performed after a GetPDR
-     *         call is received
-     *  @param[in] source - sdeventplus event source
+    /** @brief Get the state of the PDR repository, the commands depending on
+     *         the PDRs are not served till it is ready
+     *
+     *  @return the state of the PDR repository
      */
-    void _processPostGetPDRActions(sdeventplus::source::EventBase& source);
+    PDRState getPDRState() const
+    {
+        return pdrState;
+    }
 
   private:
+    /** @brief Steps of the construction of the PDRs in the background */
+    enum class BuildStep
+    {
+        FRUPresence,  //!< presence of the FRUs
+        FRUTable,     //!< FRU table and entity association PDRs
+        PlatformPDRs, //!< terminus locator and OEM PDRs
+        JsonPDRs      //!< PDRs generated out of the PDR JSONs
+    };
+
+    /** @brief Run the next step of the construction of the PDRs, one per
+     *         dispatch of the idle event source
+     *
+     *  @param[in] source - sdeventplus event source
+     */
+    void buildPDRStep(sdeventplus::source::EventBase& source);
+
+    /** @brief Check whether the D-Bus objects the PDRs are built from are
+     *         there, the construction is resumed when the BMC state changes
+     *         otherwise
+     *
+     *  @return true if the PDRs can be built
+     */
+    bool checkPDRDependencies();
+
+    /** @brief Save a snapshot of the PDRs generate() built, unless some of
+     *         their D-Bus objects are missing
+     *
+     *  @param[in] key - key of the PDR JSONs and FRU table
+     *  @param[in] repo - instance of concrete implementation of Repo
+     *  @param[in] firstRecord - index of the first PDR generated in the repo
+     *  @param[in] knownEffecters - effecter D-Bus maps added before
+     *  @param[in] knownSensors - sensor D-Bus maps added before
+     */
+    void savePDRSnapshot(uint64_t key, pdr_utils::Repo& repo,
+                         uint32_t firstRecord,
+                         const pdr_utils::DbusObjMaps& knownEffecters,
+                         const pdr_utils::DbusObjMaps& knownSensors);
+
     pdr_utils::Repo pdrRepo;
     uint16_t nextEffecterId{};
     uint16_t nextSensorId{};
@@ -465,9 +515,12 @@ class Handler : public CmdHandler
     pldm::responder::oem_platform::Handler* oemPlatformHandler;
     sdeventplus::Event& event;
     fs::path pdrJsonDir;
-    bool pdrCreated;
+    PDRState pdrState = PDRState::Waiting;
+    BuildStep buildStep = BuildStep::FRUPresence;
     std::vector<fs::path> pdrJsonsDir;
-    std::unique_ptr<sdeventplus::source::Defer> deferredGetPDREvent;
+    fs::path pdrSnapshotFile;
+    std::unique_ptr<sdeventplus::source::Defer> buildPDREvent;
+    std::unique_ptr<sdbusplus::bus::match::match> bmcStateMatch;
     bool isFirstGetPDR = true;
 };
 
@@ -37,53 +37,28 @@ int setStateEffecterStatesHandler(
     const DBusInterface& dBusIntf, Handler& handler, uint16_t effecterId,
     const std::vector<set_effecter_state_field>& stateField)
 {
-    using namespace pldm::responder::pdr;
     using namespace pldm::utils;
     using StateSetNum = uint8_t;
 
-    state_effecter_possible_states* states = nullptr;
-    pldm_state_effecter_pdr* pdr = nullptr;
     uint8_t compEffecterCnt = stateField.size();
 
-    std::unique_ptr<pldm_pdr, decltype(&pldm_pdr_destroy)> stateEffecterPdrRepo(
-        pldm_pdr_init(), pldm_pdr_destroy);
-    pldm::responder::pdr_utils::Repo stateEffecterPDRs(
-        stateEffecterPdrRepo.get());
-    getRepoByType(handler.getRepo(), stateEffecterPDRs,
-                  PLDM_STATE_EFFECTER_PDR);
-    if (stateEffecterPDRs.empty())
-    {
-        std::cerr << "Failed to get record by PDR type\n";
-        return PLDM_PLATFORM_INVALID_EFFECTER_ID;
-    }
-
     pldm::responder::pdr_utils::PdrEntry pdrEntry{};
-    auto pdrRecord = stateEffecterPDRs.getFirstRecord(pdrEntry);
-    while (pdrRecord)
+    auto pdrRecord = handler.getRepo().getRecordById(PLDM_STATE_EFFECTER_PDR,
+                                                     effecterId, pdrEntry);
+    if (!pdrRecord)
     {
-        pdr = reinterpret_cast<pldm_state_effecter_pdr*>(pdrEntry.data);
-        if (pdr->effecter_id != effecterId)
-        {
-            pdr = nullptr;
-            pdrRecord = stateEffecterPDRs.getNextRecord(pdrRecord, pdrEntry);
-            continue;
-        }
-
-        states = reinterpret_cast<state_effecter_possible_states*>(
-            pdr->possible_states);
-        if (compEffecterCnt > pdr->composite_effecter_count)
-        {
-            std::cerr << "The requester sent wrong composite effecter"
-                      << " count for the effecter, EFFECTER_ID=" << effecterId
-                      << "COMP_EFF_CNT=" << compEffecterCnt << "\n";
-            return PLDM_ERROR_INVALID_DATA;
-        }
-        break;
+        return PLDM_PLATFORM_INVALID_EFFECTER_ID;
     }
 
-    if (!pdr)
+    auto pdr = reinterpret_cast<pldm_state_effecter_pdr*>(pdrEntry.data);
+    auto states =
+        reinterpret_cast<state_effecter_possible_states*>(pdr->possible_states);
+    if (compEffecterCnt > pdr->composite_effecter_count)
     {
-        return PLDM_PLATFORM_INVALID_EFFECTER_ID;
+        std::cerr << "The requester sent wrong composite effecter"
+                  << " count for the effecter, EFFECTER_ID=" << effecterId
+                  << "COMP_EFF_CNT=" << compEffecterCnt << "\n";
+        return PLDM_ERROR_INVALID_DATA;
     }
 
     int rc = PLDM_SUCCESS;
@@ -318,3 +318,128 @@ TEST_F(TestBIOSConfig, setAttrValue)
     EXPECT_THAT(std::vector<uint8_t>(p, p + attrValueEntry.size()),
                 ElementsAreArray(attrValueEntry));
 }
+
+TEST_F(TestBIOSConfig, setAttrValueInPlace)
+{
+    MockdBusHandler dbusHandler;
+
+    ON_CALL(dbusHandler, getDbusPropertyVariant(_, _, _))
+        .WillByDefault(Throw(std::exception()));
+
+    std::vector<uint8_t> attrValueEntry{
+        0, 0,                   /* attr handle */
+        3,                      /* attr type integer read-write */
+        5, 0, 0, 0, 0, 0, 0, 0, /* current value */
+    };
+
+    {
+        BIOSConfig biosConfig("./bios_jsons", tableDir.c_str(), &dbusHandler,
+                              0, 0, nullptr, nullptr);
+        biosConfig.removeTables();
+        biosConfig.buildTables();
+
+        auto stringHandle = biosConfig.findStringHandle("VDD_AVSBUS_RAIL");
+        ASSERT_TRUE(stringHandle);
+        auto attrEntry = biosConfig.findAttrEntryByStringHandle(*stringHandle);
+        ASSERT_NE(attrEntry, nullptr);
+        auto attrHandle = table::attribute::decodeHeader(attrEntry).attrHandle;
+        attrValueEntry[0] = attrHandle & 0xff;
+        attrValueEntry[1] = (attrHandle >> 8) & 0xff;
+
+        auto tableSize =
+            biosConfig.getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE)->size();
+
+        PropertyValue value = static_cast<uint8_t>(5);
+        EXPECT_CALL(dbusHandler, setDbusProperty(_, value)).Times(1);
+        auto rc = biosConfig.setAttrValue(attrValueEntry.data(),
+                                          attrValueEntry.size());
+        EXPECT_EQ(rc, PLDM_SUCCESS);
+
+        auto attrValueTable =
+            biosConfig.getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE);
+        EXPECT_EQ(attrValueTable->size(), tableSize);
+        EXPECT_TRUE(pldm_bios_table_checksum(attrValueTable->data(),
+                                             attrValueTable->size()));
+        auto entry = biosConfig.findAttrValueEntry(attrHandle);
+        ASSERT_NE(entry, nullptr);
+        auto p = reinterpret_cast<const uint8_t*>(entry);
+        EXPECT_THAT(std::vector<uint8_t>(p, p + attrValueEntry.size()),
+                    ElementsAreArray(attrValueEntry));
+    }
+
+    // Pending writes are flushed when the config goes away
+    BIOSConfig biosConfig("./bios_jsons", tableDir.c_str(), &dbusHandler, 0, 0,
+                          nullptr, nullptr);
+    auto attrHandle = attrValueEntry[0] | (attrValueEntry[1] << 8);
+    auto entry = biosConfig.findAttrValueEntry(attrHandle);
+    ASSERT_NE(entry, nullptr);
+    auto p = reinterpret_cast<const uint8_t*>(entry);
+    EXPECT_THAT(std::vector<uint8_t>(p, p + attrValueEntry.size()),
+                ElementsAreArray(attrValueEntry));
+}
+
+TEST_F(TestBIOSConfig, indexedLookups)
+{
+    MockdBusHandler dbusHandler;
+
+    ON_CALL(dbusHandler, getDbusPropertyVariant(_, _, _))
+        .WillByDefault(Throw(std::exception()));
+
+    BIOSConfig biosConfig("./bios_jsons", tableDir.c_str(), &dbusHandler, 0, 0,
+                          nullptr, nullptr);
+    biosConfig.removeTables();
+    EXPECT_FALSE(biosConfig.findStringHandle("str_example1"));
+    biosConfig.buildTables();
+
+    auto stringHandle = biosConfig.findStringHandle("str_example1");
+    ASSERT_TRUE(stringHandle);
+    auto stringEntry = biosConfig.findStringEntry(*stringHandle);
+    ASSERT_NE(stringEntry, nullptr);
+    EXPECT_EQ(table::string::decodeString(stringEntry), "str_example1");
+
+    auto attrEntry = biosConfig.findAttrEntryByStringHandle(*stringHandle);
+    ASSERT_NE(attrEntry, nullptr);
+    auto attrHandle = table::attribute::decodeHeader(attrEntry).attrHandle;
+    EXPECT_EQ(biosConfig.findAttrEntry(attrHandle), attrEntry);
+
+    auto attrValueTable = biosConfig.getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE);
+    auto attrValueEntry = biosConfig.findAttrValueEntry(attrHandle);
+    ASSERT_NE(attrValueEntry, nullptr);
+    auto expected = pldm_bios_table_attr_value_find_by_handle(
+        attrValueTable->data(), attrValueTable->size(), attrHandle);
+    auto length = pldm_bios_table_attr_value_entry_length(expected);
+    auto p = reinterpret_cast<const uint8_t*>(attrValueEntry);
+    auto e = reinterpret_cast<const uint8_t*>(expected);
+    EXPECT_THAT(std::vector<uint8_t>(p, p + length),
+                ElementsAreArray(e, length));
+
+    EXPECT_EQ(biosConfig.findAttrValueEntry(0xffff), nullptr);
+    EXPECT_FALSE(biosConfig.findStringHandle("no_such_string"));
+}
+
+TEST_F(TestBIOSConfig, tablesStayResident)
+{
+    MockdBusHandler dbusHandler;
+
+    ON_CALL(dbusHandler, getDbusPropertyVariant(_, _, _))
+        .WillByDefault(Throw(std::exception()));
+
+    BIOSConfig biosConfig("./bios_jsons", tableDir.c_str(), &dbusHandler, 0, 0,
+                          nullptr, nullptr);
+    biosConfig.removeTables();
+    biosConfig.buildTables();
+
+    auto attrValueTable = biosConfig.getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE);
+    ASSERT_TRUE(attrValueTable);
+
+    // Tables are served from memory once built, the files are not re-read
+    fs::remove(tableDir / "attributeValueTable");
+    auto cachedTable = biosConfig.getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE);
+    ASSERT_TRUE(cachedTable);
+    EXPECT_EQ(*cachedTable, *attrValueTable);
+
+    biosConfig.removeTables();
+    EXPECT_FALSE(biosConfig.getBIOSTable(PLDM_BIOS_STRING_TABLE));
+    EXPECT_FALSE(biosConfig.getBIOSTable(PLDM_BIOS_ATTR_TABLE));
+    EXPECT_FALSE(biosConfig.getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE));
+}
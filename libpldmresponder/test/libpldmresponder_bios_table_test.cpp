@@ -3,6 +3,7 @@
 #include <stdlib.h>
 
 #include <algorithm>
+#include <numeric>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -59,3 +60,209 @@ TEST_F(TestBIOSTable, testLoadOntoExisting)
     ASSERT_EQ(out[0], 99);
     ASSERT_EQ(out[1], 99);
 }
+
+TEST(BIOSTableIndex, testLookups)
+{
+    Table stringTable;
+    std::vector<std::string> names;
+    for (int i = 0; i < 1000; i++)
+    {
+        names.emplace_back("attr" + std::to_string(i));
+        table::string::constructEntry(stringTable, names.back());
+    }
+    table::appendPadAndChecksum(stringTable);
+
+    BIOSStringTable biosStringTable(stringTable);
+    for (const auto& name : names)
+    {
+        EXPECT_EQ(biosStringTable.findString(biosStringTable.findHandle(name)),
+                  name);
+    }
+    EXPECT_THROW(biosStringTable.findHandle("attr1000"),
+                 std::invalid_argument);
+    EXPECT_THROW(biosStringTable.findString(1000), std::invalid_argument);
+
+    Table attrTable;
+    Table attrValueTable;
+    for (uint16_t stringHandle = 0; stringHandle < names.size();
+         stringHandle++)
+    {
+        pldm_bios_table_attr_entry_integer_info info{
+            stringHandle, false, 0, 100, 1, 0};
+        auto attrEntry = table::attribute::constructIntegerEntry(attrTable,
+                                                                 &info);
+        auto attrHandle = table::attribute::decodeHeader(attrEntry).attrHandle;
+        table::attribute_value::constructIntegerEntry(
+            attrValueTable, attrHandle, PLDM_BIOS_INTEGER, stringHandle % 100);
+    }
+    table::appendPadAndChecksum(attrTable);
+    table::appendPadAndChecksum(attrValueTable);
+
+    BIOSTableIndex index;
+    index.update(PLDM_BIOS_ATTR_TABLE, attrTable);
+    index.update(PLDM_BIOS_ATTR_VAL_TABLE, attrValueTable);
+
+    for (uint16_t stringHandle = 0; stringHandle < names.size();
+         stringHandle++)
+    {
+        auto attrHandle = index.findAttrHandle(stringHandle);
+        ASSERT_TRUE(attrHandle);
+
+        auto attrOffset = index.findAttr(*attrHandle);
+        ASSERT_TRUE(attrOffset);
+        auto attrEntry = reinterpret_cast<const pldm_bios_attr_table_entry*>(
+            attrTable.data() + *attrOffset);
+        EXPECT_EQ(attrEntry, table::attribute::findByHandle(attrTable,
+                                                            *attrHandle));
+
+        auto valueOffset = index.findAttrValue(*attrHandle);
+        ASSERT_TRUE(valueOffset);
+        auto valueEntry =
+            reinterpret_cast<const pldm_bios_attr_val_table_entry*>(
+                attrValueTable.data() + *valueOffset);
+        EXPECT_EQ(table::attribute_value::decodeIntegerEntry(valueEntry),
+                  stringHandle % 100);
+    }
+    EXPECT_FALSE(index.findAttrHandle(names.size()));
+
+    index.update(PLDM_BIOS_ATTR_VAL_TABLE, {});
+    EXPECT_FALSE(index.findAttrValue(0));
+    EXPECT_TRUE(index.findAttr(0));
+
+    index.clear();
+    EXPECT_FALSE(index.findAttr(0));
+}
+
+TEST(BIOSTableTransfer, testGetParts)
+{
+    Table table(10);
+    std::iota(table.begin(), table.end(), 0);
+
+    BIOSTableTransfer transfer(table.size());
+    Table part;
+    uint32_t nextTransferHandle{};
+    uint8_t transferFlag{};
+    EXPECT_EQ(transfer.getPart(0, 4, part, nextTransferHandle, transferFlag),
+              PLDM_INVALID_BIOS_DATA_TRANSFER_HANDLE);
+
+    transfer.startGet(table);
+    EXPECT_TRUE(transfer.isGetInProgress());
+
+    Table received;
+    uint32_t transferHandle = 0;
+    std::vector<uint8_t> flags;
+    do
+    {
+        ASSERT_EQ(transfer.getPart(transferHandle, 4, part, nextTransferHandle,
+                                   transferFlag),
+                  PLDM_SUCCESS);
+        EXPECT_LE(part.size(), 4);
+        received.insert(received.end(), part.begin(), part.end());
+        flags.push_back(transferFlag);
+        transferHandle = nextTransferHandle;
+    } while (nextTransferHandle != 0);
+
+    EXPECT_EQ(received, table);
+    EXPECT_EQ(flags, std::vector<uint8_t>({PLDM_START, PLDM_MIDDLE, PLDM_END}));
+
+    // The snapshot is dropped once the last part is served
+    EXPECT_FALSE(transfer.isGetInProgress());
+    EXPECT_EQ(transfer.getPart(0, 16, part, nextTransferHandle, transferFlag),
+              PLDM_INVALID_BIOS_DATA_TRANSFER_HANDLE);
+
+    transfer.startGet(table);
+    ASSERT_EQ(transfer.getPart(0, 16, part, nextTransferHandle, transferFlag),
+              PLDM_SUCCESS);
+    EXPECT_EQ(part, table);
+    EXPECT_EQ(nextTransferHandle, 0);
+    EXPECT_EQ(transferFlag, PLDM_START_AND_END);
+    EXPECT_FALSE(transfer.isGetInProgress());
+
+    transfer.startGet(table);
+    EXPECT_EQ(transfer.getPart(table.size(), 4, part, nextTransferHandle,
+                               transferFlag),
+              PLDM_INVALID_BIOS_DATA_TRANSFER_HANDLE);
+}
+
+TEST(BIOSTableTransfer, testSetParts)
+{
+    Table table(10);
+    std::iota(table.begin(), table.end(), 0);
+
+    BIOSTableTransfer transfer(table.size());
+    uint32_t nextTransferHandle{};
+    std::optional<Table> result;
+
+    variable_field part{table.data() + 4, 4};
+    EXPECT_EQ(transfer.setPart(4, PLDM_MIDDLE, part, nextTransferHandle,
+                               result),
+              PLDM_INVALID_BIOS_DATA_TRANSFER_HANDLE);
+    EXPECT_EQ(transfer.setPart(0, 0xff, part, nextTransferHandle, result),
+              PLDM_INVALID_BIOS_TRANSFER_FLAG);
+
+    part = {table.data(), 4};
+    ASSERT_EQ(transfer.setPart(0, PLDM_START, part, nextTransferHandle,
+                               result),
+              PLDM_SUCCESS);
+    EXPECT_EQ(nextTransferHandle, 4);
+    EXPECT_FALSE(result);
+
+    part = {table.data() + 4, 4};
+    EXPECT_EQ(transfer.setPart(3, PLDM_MIDDLE, part, nextTransferHandle,
+                               result),
+              PLDM_INVALID_BIOS_DATA_TRANSFER_HANDLE);
+    ASSERT_EQ(transfer.setPart(4, PLDM_MIDDLE, part, nextTransferHandle,
+                               result),
+              PLDM_SUCCESS);
+    EXPECT_EQ(nextTransferHandle, 8);
+    EXPECT_FALSE(result);
+
+    part = {table.data() + 8, 2};
+    ASSERT_EQ(transfer.setPart(8, PLDM_END, part, nextTransferHandle, result),
+              PLDM_SUCCESS);
+    EXPECT_EQ(nextTransferHandle, 0);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(*result, table);
+
+    result.reset();
+    part = {table.data(), table.size()};
+    ASSERT_EQ(transfer.setPart(0, PLDM_START_AND_END, part,
+                               nextTransferHandle, result),
+              PLDM_SUCCESS);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(*result, table);
+}
+
+TEST(BIOSTableTransfer, testSetPartsTooLarge)
+{
+    Table table(10);
+    std::iota(table.begin(), table.end(), 0);
+
+    BIOSTableTransfer transfer(8);
+    uint32_t nextTransferHandle{};
+    std::optional<Table> result;
+
+    variable_field part{table.data(), 4};
+    ASSERT_EQ(transfer.setPart(0, PLDM_START, part, nextTransferHandle,
+                               result),
+              PLDM_SUCCESS);
+    part = {table.data() + 4, 4};
+    ASSERT_EQ(transfer.setPart(4, PLDM_MIDDLE, part, nextTransferHandle,
+                               result),
+              PLDM_SUCCESS);
+
+    // A part past the maximum size drops the transfer
+    part = {table.data() + 8, 2};
+    EXPECT_EQ(transfer.setPart(8, PLDM_MIDDLE, part, nextTransferHandle,
+                               result),
+              PLDM_ERROR_INVALID_LENGTH);
+    EXPECT_EQ(transfer.setPart(8, PLDM_END, part, nextTransferHandle, result),
+              PLDM_INVALID_BIOS_DATA_TRANSFER_HANDLE);
+    EXPECT_FALSE(result);
+
+    part = {table.data(), table.size()};
+    EXPECT_EQ(transfer.setPart(0, PLDM_START_AND_END, part,
+                               nextTransferHandle, result),
+              PLDM_ERROR_INVALID_LENGTH);
+    EXPECT_FALSE(result);
+}
@@ -1,9 +1,12 @@
 #include "libpldm/base.h"
 #include "libpldm/bios.h"
 
+#include "common/bios_utils.hpp"
+#include "common/test/mocked_utils.hpp"
 #include "libpldmresponder/bios.hpp"
 #include "libpldmresponder/bios_table.hpp"
 
+#include <stdlib.h>
 #include <string.h>
 
 #include <array>
@@ -11,13 +14,18 @@
 #include <ctime>
 #include <filesystem>
 
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 using namespace pldm;
+using namespace pldm::bios::utils;
 using namespace pldm::responder;
 using namespace pldm::responder::bios;
 using namespace pldm::responder::utils;
 
+using ::testing::_;
+using ::testing::Throw;
+
 TEST(epochToBCDTime, testTime)
 {
     struct tm time
@@ -63,4 +71,98 @@ TEST(timeToEpoch, testTime0)
     timeSec = timeToEpoch(sec, min, hours, day, month, year);
 
     EXPECT_EQ(ret, timeSec);
-}
\ No newline at end of file
+}
+TEST(getBIOSTable, testNextPartZeroAfterChange)
+{
+    char tmpdir[] = "/tmp/BIOSTables.XXXXXX";
+    std::filesystem::path tableDir(mkdtemp(tmpdir));
+    MockdBusHandler dbusHandler;
+    ON_CALL(dbusHandler, getDbusPropertyVariant(_, _, _))
+        .WillByDefault(Throw(std::exception()));
+
+    {
+        Handler handler("./bios_jsons", tableDir.c_str(), &dbusHandler, 0, 0,
+                        nullptr, nullptr);
+
+        // Requesters get the whole table with GetNextPart and handle 0
+        auto getAttrValueTable = [&handler]() {
+            std::array<uint8_t,
+                       sizeof(pldm_msg_hdr) + PLDM_GET_BIOS_TABLE_REQ_BYTES>
+                requestMsg{};
+            auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+            EXPECT_EQ(encode_get_bios_table_req(0, 0, PLDM_GET_NEXTPART,
+                                                PLDM_BIOS_ATTR_VAL_TABLE,
+                                                request),
+                      PLDM_SUCCESS);
+            auto response =
+                handler.getBIOSTable(request, PLDM_GET_BIOS_TABLE_REQ_BYTES);
+            auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+
+            uint8_t completionCode{};
+            uint32_t nextTransferHandle{};
+            uint8_t transferFlag{};
+            size_t tableOffset{};
+            EXPECT_EQ(decode_get_bios_table_resp(
+                          responsePtr, response.size() - sizeof(pldm_msg_hdr),
+                          &completionCode, &nextTransferHandle, &transferFlag,
+                          &tableOffset),
+                      PLDM_SUCCESS);
+            EXPECT_EQ(completionCode, PLDM_SUCCESS);
+            EXPECT_EQ(transferFlag, PLDM_START_AND_END);
+            return Table(responsePtr->payload + tableOffset,
+                         response.data() + response.size());
+        };
+
+        auto before = getAttrValueTable();
+        ASSERT_FALSE(before.empty());
+
+        // Set the read-write integer attribute to a value other than its
+        // default
+        std::vector<uint8_t> attrValueEntry{
+            0, 0,                   /* attr handle */
+            PLDM_BIOS_INTEGER,      /* attr type integer read-write */
+            5, 0, 0, 0, 0, 0, 0, 0, /* current value */
+        };
+        bool found = false;
+        for (auto entry : BIOSTableIter<PLDM_BIOS_ATTR_VAL_TABLE>(
+                 before.data(), before.size()))
+        {
+            auto [attrHandle, attrType] =
+                table::attribute_value::decodeHeader(entry);
+            if (attrType == PLDM_BIOS_INTEGER)
+            {
+                attrValueEntry[0] = attrHandle & 0xff;
+                attrValueEntry[1] = (attrHandle >> 8) & 0xff;
+                found = true;
+                break;
+            }
+        }
+        ASSERT_TRUE(found);
+
+        EXPECT_CALL(dbusHandler, setDbusProperty(_, _)).Times(1);
+        std::vector<uint8_t> requestMsg(
+            sizeof(pldm_msg_hdr) + PLDM_SET_BIOS_ATTR_CURR_VAL_MIN_REQ_BYTES +
+            attrValueEntry.size());
+        auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+        ASSERT_EQ(encode_set_bios_attribute_current_value_req(
+                      0, 0, PLDM_START_AND_END, attrValueEntry.data(),
+                      attrValueEntry.size(), request,
+                      requestMsg.size() - sizeof(pldm_msg_hdr)),
+                  PLDM_SUCCESS);
+        auto response = handler.setBIOSAttributeCurrentValue(
+            request, requestMsg.size() - sizeof(pldm_msg_hdr));
+        auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+        ASSERT_EQ(responsePtr->payload[0], PLDM_SUCCESS);
+
+        // The second read is a new transfer, not the snapshot of the first
+        auto after = getAttrValueTable();
+        EXPECT_NE(after, before);
+        auto entry = pldm_bios_table_attr_value_find_by_handle(
+            after.data(), after.size(),
+            attrValueEntry[0] | (attrValueEntry[1] << 8));
+        ASSERT_NE(entry, nullptr);
+        EXPECT_EQ(table::attribute_value::decodeIntegerEntry(entry), 5);
+    }
+
+    std::filesystem::remove_all(tableDir);
+}
@@ -69,6 +69,73 @@ TEST(GeneratePDRByStateSensor, testGoodJson)
     pldm_pdr_destroy(outPDRRepo);
 }
 
+TEST(GeneratePDRByStateSensor, testGetRecordById)
+{
+    std::array<uint8_t, sizeof(pldm_msg_hdr) + PLDM_GET_PDR_REQ_BYTES>
+        requestPayload{};
+    auto req = reinterpret_cast<pldm_msg*>(requestPayload.data());
+    size_t requestPayloadLength = requestPayload.size() - sizeof(pldm_msg_hdr);
+
+    MockdBusHandler mockedUtils;
+    EXPECT_CALL(mockedUtils, getService(StrEq("/foo/bar"), _))
+        .Times(1)
+        .WillRepeatedly(Return("foo.bar"));
+
+    auto inPDRRepo = pldm_pdr_init();
+    auto event = sdeventplus::Event::get_default();
+    Handler handler(&mockedUtils, "./pdr_jsons/state_sensor/good", inPDRRepo,
+                    nullptr, nullptr, nullptr, nullptr, nullptr, event);
+    handler.getPDR(req, requestPayloadLength);
+    Repo inRepo(inPDRRepo);
+
+    pdr_utils::PdrEntry e;
+    auto record = inRepo.getRecordById(PLDM_STATE_SENSOR_PDR, 1, e);
+    ASSERT_NE(record, nullptr);
+    auto pdr = reinterpret_cast<pldm_state_sensor_pdr*>(e.data);
+    EXPECT_EQ(pdr->hdr.type, PLDM_STATE_SENSOR_PDR);
+    EXPECT_EQ(pdr->sensor_id, 1);
+
+    EXPECT_EQ(inRepo.getRecordById(PLDM_STATE_SENSOR_PDR, 2, e), nullptr);
+    EXPECT_EQ(inRepo.getRecordById(PLDM_STATE_EFFECTER_PDR, 1, e), nullptr);
+
+    // The index follows records removed behind the Repo's back
+    pldm_delete_by_sensor_id(inPDRRepo, 1, false);
+    EXPECT_EQ(inRepo.getRecordById(PLDM_STATE_SENSOR_PDR, 1, e), nullptr);
+
+    pldm_pdr_destroy(inPDRRepo);
+}
+
+TEST(GeneratePDRByStateSensor, testIdIndexSharedHandle)
+{
+    auto pdrRepo = pldm_pdr_init();
+    Repo repo(pdrRepo);
+
+    std::vector<uint8_t> sensor(sizeof(pldm_state_sensor_pdr));
+    auto sensorPdr = reinterpret_cast<pldm_state_sensor_pdr*>(sensor.data());
+    sensorPdr->hdr.type = PLDM_STATE_SENSOR_PDR;
+    sensorPdr->sensor_id = 7;
+    pldm_pdr_add(pdrRepo, sensor.data(), sensor.size(), 5, false, 1);
+
+    pdr_utils::PdrEntry e;
+    ASSERT_NE(repo.getRecordById(PLDM_STATE_SENSOR_PDR, 7, e), nullptr);
+
+    // A remote PDR with the same record handle does not shadow the sensor
+    std::vector<uint8_t> remote(sizeof(pldm_terminus_locator_pdr));
+    auto remotePdr =
+        reinterpret_cast<pldm_terminus_locator_pdr*>(remote.data());
+    remotePdr->hdr.type = PLDM_TERMINUS_LOCATOR_PDR;
+    pldm_pdr_add(pdrRepo, remote.data(), remote.size(), 5, true, 2);
+
+    auto record = repo.getRecordById(PLDM_STATE_SENSOR_PDR, 7, e);
+    ASSERT_NE(record, nullptr);
+    ASSERT_EQ(e.size, sensor.size());
+    auto pdr = reinterpret_cast<pldm_state_sensor_pdr*>(e.data);
+    EXPECT_EQ(pdr->hdr.type, PLDM_STATE_SENSOR_PDR);
+    EXPECT_EQ(pdr->sensor_id, 7);
+
+    pldm_pdr_destroy(pdrRepo);
+}
+
 TEST(GeneratePDR, testMalformedJson)
 {
     std::array<uint8_t, sizeof(pldm_msg_hdr) + PLDM_GET_PDR_REQ_BYTES>
@@ -0,0 +1,244 @@
+#include "libpldm/platform.h"
+
+#include "common/test/mocked_utils.hpp"
+#include "libpldmresponder/pdr_snapshot.hpp"
+#include "libpldmresponder/pdr_utils.hpp"
+#include "libpldmresponder/platform.hpp"
+
+#include <stdlib.h>
+
+#include <sdeventplus/event.hpp>
+
+#include <filesystem>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::responder;
+using namespace pldm::responder::pdr_utils;
+using namespace pldm::responder::pdr_snapshot;
+
+using ::testing::_;
+using ::testing::Return;
+using ::testing::StrEq;
+
+class PdrSnapshotTest : public testing::Test
+{
+  protected:
+    PdrSnapshotTest()
+    {
+        char dir[] = "/tmp/pldm_pdr_snapshot.XXXXXX";
+        tmpDir = mkdtemp(dir);
+        file = tmpDir / "pdr_snapshot";
+        jsonDir = tmpDir / "pdr";
+        fs::create_directories(jsonDir);
+        writeJson("1.json", R"({"effecterPDRs": []})");
+    }
+
+    ~PdrSnapshotTest()
+    {
+        fs::remove_all(tmpDir);
+    }
+
+    void writeJson(const std::string& name, const std::string& content)
+    {
+        std::ofstream json(jsonDir / name);
+        json << content;
+    }
+
+    /** @brief Add a PDR with a record handle assigned by the repository */
+    static void addRecord(Repo& repo, uint8_t type, uint8_t fill)
+    {
+        std::vector<uint8_t> data(sizeof(pldm_pdr_hdr) + 8, fill);
+        auto hdr = reinterpret_cast<pldm_pdr_hdr*>(data.data());
+        hdr->record_handle = 0;
+        hdr->type = type;
+        PdrEntry pdrEntry{};
+        pdrEntry.data = data.data();
+        pdrEntry.size = data.size();
+        repo.addRecord(pdrEntry);
+    }
+
+    static std::vector<std::vector<uint8_t>> records(Repo& repo)
+    {
+        std::vector<std::vector<uint8_t>> data;
+        PdrEntry pdrEntry{};
+        for (auto record = repo.getFirstRecord(pdrEntry); record;
+             record = repo.getNextRecord(record, pdrEntry))
+        {
+            data.emplace_back(pdrEntry.data, pdrEntry.data + pdrEntry.size);
+        }
+        return data;
+    }
+
+    static Snapshot makeSnapshot()
+    {
+        Snapshot snapshot{5, 3, {}, {}};
+        pldm::utils::DBusMapping effecter{"/xyz/openbmc_project/state/host0",
+                                          "xyz.openbmc_project.State.Host",
+                                          "RequestedHostTransition", "string"};
+        StatestoDbusVal effecterValues{
+            {1, std::string("xyz.openbmc_project.State.Host.Transition.On")},
+            {2, std::string("xyz.openbmc_project.State.Host.Transition.Off")}};
+        snapshot.effecterDbusObjMaps.emplace(
+            5, std::make_tuple(DbusMappings{effecter},
+                               DbusValMaps{effecterValues}));
+
+        pldm::utils::DBusMapping sensor{"/foo/bar", "xyz.openbmc_project.Foo",
+                                        "Bar", "bool"};
+        StatestoDbusVal sensorValues{
+            {0, true}, {1, uint8_t(7)}, {2, 1.5}, {3, std::vector<uint8_t>{9}}};
+        snapshot.sensorDbusObjMaps.emplace(
+            3,
+            std::make_tuple(DbusMappings{sensor}, DbusValMaps{sensorValues}));
+        return snapshot;
+    }
+
+    /** @brief Run the event loop till the handler has built its PDRs */
+    static void buildPDRs(sdeventplus::Event& event,
+                          platform::Handler& handler)
+    {
+        for (int i = 0;
+             i < 10 && handler.getPDRState() != platform::PDRState::Ready; ++i)
+        {
+            sd_event_run(event.get(), 0);
+        }
+        ASSERT_TRUE(handler.getPDRState() == platform::PDRState::Ready);
+    }
+
+    fs::path tmpDir;
+    fs::path file;
+    fs::path jsonDir;
+};
+
+TEST_F(PdrSnapshotTest, loadSaved)
+{
+    auto pdrRepo = pldm_pdr_init();
+    Repo repo(pdrRepo);
+    addRecord(repo, PLDM_TERMINUS_LOCATOR_PDR, 0x11);
+    addRecord(repo, PLDM_STATE_EFFECTER_PDR, 0x22);
+    addRecord(repo, PLDM_STATE_SENSOR_PDR, 0x33);
+
+    auto key = computeKey({jsonDir}, {}, 0, 0);
+    auto snapshot = makeSnapshot();
+    EXPECT_TRUE(save(file, key, repo, 1, snapshot));
+
+    // The PDRs built before the generated ones are not in the snapshot
+    auto loadedPdrRepo = pldm_pdr_init();
+    Repo loadedRepo(loadedPdrRepo);
+    addRecord(loadedRepo, PLDM_TERMINUS_LOCATOR_PDR, 0x11);
+    Snapshot loaded;
+    EXPECT_TRUE(load(file, key, loadedRepo, loaded));
+    EXPECT_EQ(records(loadedRepo), records(repo));
+
+    EXPECT_EQ(loaded.nextEffecterId, 5);
+    EXPECT_EQ(loaded.nextSensorId, 3);
+    ASSERT_EQ(loaded.effecterDbusObjMaps.size(), 1);
+    const auto& [mappings, valMaps] = loaded.effecterDbusObjMaps.at(5);
+    ASSERT_EQ(mappings.size(), 1);
+    EXPECT_EQ(mappings[0].objectPath, "/xyz/openbmc_project/state/host0");
+    EXPECT_EQ(mappings[0].interface, "xyz.openbmc_project.State.Host");
+    EXPECT_EQ(mappings[0].propertyName, "RequestedHostTransition");
+    EXPECT_EQ(mappings[0].propertyType, "string");
+    EXPECT_EQ(valMaps, std::get<1>(snapshot.effecterDbusObjMaps.at(5)));
+    EXPECT_EQ(std::get<1>(loaded.sensorDbusObjMaps.at(3)),
+              std::get<1>(snapshot.sensorDbusObjMaps.at(3)));
+
+    pldm_pdr_destroy(pdrRepo);
+    pldm_pdr_destroy(loadedPdrRepo);
+}
+
+TEST_F(PdrSnapshotTest, staleSnapshot)
+{
+    auto pdrRepo = pldm_pdr_init();
+    Repo repo(pdrRepo);
+    addRecord(repo, PLDM_STATE_EFFECTER_PDR, 0x22);
+    auto key = computeKey({jsonDir}, {}, 0, 0);
+    EXPECT_TRUE(save(file, key, repo, 0, makeSnapshot()));
+
+    // Any input of the PDR generation changes the key
+    std::map<std::string, pldm_entity> entities{
+        {"/xyz/openbmc_project/inventory/system", {45, 1, 0}}};
+    EXPECT_NE(computeKey({jsonDir}, entities, 0, 0), key);
+    EXPECT_NE(computeKey({jsonDir}, {}, 1, 0), key);
+    EXPECT_NE(computeKey({jsonDir, jsonDir / "ibm,rainier-2u"}, {}, 0, 0),
+              key);
+    writeJson("1.json", R"({"effecterPDRs": [{}]})");
+    auto newKey = computeKey({jsonDir}, {}, 0, 0);
+    EXPECT_NE(newKey, key);
+
+    auto loadedPdrRepo = pldm_pdr_init();
+    Repo loadedRepo(loadedPdrRepo);
+    Snapshot loaded;
+    EXPECT_FALSE(load(file, newKey, loadedRepo, loaded));
+    EXPECT_TRUE(loadedRepo.empty());
+    EXPECT_FALSE(load(tmpDir / "missing", key, loadedRepo, loaded));
+
+    pldm_pdr_destroy(pdrRepo);
+    pldm_pdr_destroy(loadedPdrRepo);
+}
+
+TEST_F(PdrSnapshotTest, corruptSnapshot)
+{
+    auto pdrRepo = pldm_pdr_init();
+    Repo repo(pdrRepo);
+    addRecord(repo, PLDM_STATE_EFFECTER_PDR, 0x22);
+    auto key = computeKey({jsonDir}, {}, 0, 0);
+    EXPECT_TRUE(save(file, key, repo, 0, makeSnapshot()));
+    {
+        std::fstream snapshot(file,
+                              std::ios::in | std::ios::out | std::ios::binary);
+        snapshot.seekp(32);
+        snapshot.put(0x5a);
+    }
+
+    auto loadedPdrRepo = pldm_pdr_init();
+    Repo loadedRepo(loadedPdrRepo);
+    Snapshot loaded;
+    EXPECT_FALSE(load(file, key, loadedRepo, loaded));
+    EXPECT_TRUE(loadedRepo.empty());
+
+    pldm_pdr_destroy(pdrRepo);
+    pldm_pdr_destroy(loadedPdrRepo);
+}
+
+TEST_F(PdrSnapshotTest, generateFromSnapshot)
+{
+    auto event = sdeventplus::Event::get_default();
+
+    MockdBusHandler mockedUtils;
+    EXPECT_CALL(mockedUtils, getService(StrEq("/foo/bar"), _))
+        .Times(1)
+        .WillRepeatedly(Return("foo.bar"));
+    auto pdrRepo = pldm_pdr_init();
+    platform::Handler handler(&mockedUtils, "./pdr_jsons/state_sensor/good",
+                              pdrRepo, nullptr, nullptr, nullptr, nullptr,
+                              nullptr, event, true);
+    handler.setPDRSnapshotFile(file);
+    buildPDRs(event, handler);
+    EXPECT_TRUE(fs::exists(file));
+
+    // The next run neither parses the JSONs nor looks up the D-Bus services
+    MockdBusHandler snapshotUtils;
+    EXPECT_CALL(snapshotUtils, getService(_, _)).Times(0);
+    auto snapshotPdrRepo = pldm_pdr_init();
+    platform::Handler snapshotHandler(
+        &snapshotUtils, "./pdr_jsons/state_sensor/good", snapshotPdrRepo,
+        nullptr, nullptr, nullptr, nullptr, nullptr, event, true);
+    snapshotHandler.setPDRSnapshotFile(file);
+    buildPDRs(event, snapshotHandler);
+
+    Repo repo(pdrRepo);
+    Repo snapshotRepo(snapshotPdrRepo);
+    EXPECT_EQ(records(snapshotRepo), records(repo));
+    const auto& [mappings, valMaps] =
+        snapshotHandler.getDbusObjMaps(1, TypeId::PLDM_SENSOR_ID);
+    ASSERT_EQ(mappings.size(), 1);
+    EXPECT_EQ(mappings[0].objectPath, "/foo/bar");
+    EXPECT_EQ(valMaps,
+              std::get<1>(handler.getDbusObjMaps(1, TypeId::PLDM_SENSOR_ID)));
+    EXPECT_EQ(snapshotHandler.getNextSensorId(), handler.getNextSensorId());
+
+    pldm_pdr_destroy(pdrRepo);
+    pldm_pdr_destroy(snapshotPdrRepo);
+}
@@ -1,3 +1,5 @@
+#include "libpldm/utils.h"
+
 #include "common/test/mocked_utils.hpp"
 #include "common/utils.hpp"
 #include "libpldmresponder/event_parser.hpp"
@@ -93,6 +95,91 @@ TEST(getPDR, testShortRead)
     pldm_pdr_destroy(pdrRepo);
 }
 
+TEST(getPDR, testMultipart)
+{
+    MockdBusHandler mockedUtils;
+    EXPECT_CALL(mockedUtils, getService(StrEq("/foo/bar"), _))
+        .Times(5)
+        .WillRepeatedly(Return("foo.bar"));
+
+    auto pdrRepo = pldm_pdr_init();
+    auto event = sdeventplus::Event::get_default();
+    Handler handler(&mockedUtils, "./pdr_jsons/state_effecter/good", pdrRepo,
+                    nullptr, nullptr, nullptr, nullptr, nullptr, event);
+    Repo repo(pdrRepo);
+    ASSERT_EQ(repo.empty(), false);
+
+    PdrEntry e;
+    auto record = pdr::getRecordByHandle(repo, 1, e);
+    ASSERT_NE(record, nullptr);
+    std::vector<uint8_t> expected(e.data, e.data + e.size);
+
+    // Fetch the record in parts of a few bytes, the way a requester limited
+    // by its transport would
+    constexpr uint16_t partSize = 7;
+    std::vector<uint8_t> pdr;
+    uint32_t dataTransferHandle = 0;
+    uint8_t transferOpFlag = PLDM_GET_FIRSTPART;
+    uint8_t transferFlag{};
+    uint8_t transferCRC{};
+    size_t roundTrips = 0;
+    do
+    {
+        std::array<uint8_t, sizeof(pldm_msg_hdr) + PLDM_GET_PDR_REQ_BYTES>
+            requestMsg{};
+        auto req = reinterpret_cast<pldm_msg*>(requestMsg.data());
+        ASSERT_EQ(encode_get_pdr_req(0, 1, dataTransferHandle, transferOpFlag,
+                                     partSize, 0, req, PLDM_GET_PDR_REQ_BYTES),
+                  PLDM_SUCCESS);
+        auto response = handler.getPDR(req, PLDM_GET_PDR_REQ_BYTES);
+        ++roundTrips;
+
+        auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+        uint8_t completionCode{};
+        uint32_t nextRecordHandle{};
+        uint16_t respCount{};
+        std::array<uint8_t, partSize> part{};
+        ASSERT_EQ(decode_get_pdr_resp(
+                      responsePtr, response.size() - sizeof(pldm_msg_hdr),
+                      &completionCode, &nextRecordHandle, &dataTransferHandle,
+                      &transferFlag, &respCount, part.data(), part.size(),
+                      &transferCRC),
+                  PLDM_SUCCESS);
+        ASSERT_EQ(completionCode, PLDM_SUCCESS);
+        ASSERT_EQ(nextRecordHandle, 2);
+        ASSERT_LE(respCount, partSize);
+        pdr.insert(pdr.end(), part.begin(), part.begin() + respCount);
+        transferOpFlag = PLDM_GET_NEXTPART;
+    } while (dataTransferHandle != 0);
+
+    EXPECT_EQ(transferFlag, PLDM_END);
+    EXPECT_EQ(transferCRC, crc8(expected.data(), expected.size()));
+    EXPECT_EQ(pdr, expected);
+    EXPECT_EQ(roundTrips, (expected.size() + partSize - 1) / partSize);
+
+    std::array<uint8_t, sizeof(pldm_msg_hdr) + PLDM_GET_PDR_REQ_BYTES>
+        requestMsg{};
+    auto req = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    ASSERT_EQ(encode_get_pdr_req(0, 1, expected.size(), PLDM_GET_NEXTPART,
+                                 partSize, 0, req, PLDM_GET_PDR_REQ_BYTES),
+              PLDM_SUCCESS);
+    auto response = handler.getPDR(req, PLDM_GET_PDR_REQ_BYTES);
+    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+    EXPECT_EQ(responsePtr->payload[0],
+              PLDM_PLATFORM_INVALID_DATA_TRANSFER_HANDLE);
+
+    // A next part of no data would end the transfer without the rest of the
+    // record
+    ASSERT_EQ(encode_get_pdr_req(0, 1, partSize, PLDM_GET_NEXTPART, 0, 0, req,
+                                 PLDM_GET_PDR_REQ_BYTES),
+              PLDM_SUCCESS);
+    response = handler.getPDR(req, PLDM_GET_PDR_REQ_BYTES);
+    responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+    EXPECT_EQ(responsePtr->payload[0], PLDM_ERROR_INVALID_DATA);
+
+    pldm_pdr_destroy(pdrRepo);
+}
+
 TEST(getPDR, testBadRecordHandle)
 {
     std::array<uint8_t, sizeof(pldm_msg_hdr) + PLDM_GET_PDR_REQ_BYTES>
@@ -156,6 +243,85 @@ TEST(getPDR, testNoNextRecord)
     pldm_pdr_destroy(pdrRepo);
 }
 
+TEST(getPDR, testBuiltInBackground)
+{
+    std::array<uint8_t, sizeof(pldm_msg_hdr) + PLDM_GET_PDR_REQ_BYTES>
+        requestPayload{};
+    auto req = reinterpret_cast<pldm_msg*>(requestPayload.data());
+    size_t requestPayloadLength = requestPayload.size() - sizeof(pldm_msg_hdr);
+
+    struct pldm_get_pdr_req* request =
+        reinterpret_cast<struct pldm_get_pdr_req*>(req->payload);
+    request->request_count = 100;
+
+    MockdBusHandler mockedUtils;
+    EXPECT_CALL(mockedUtils, getService(StrEq("/foo/bar"), _))
+        .Times(5)
+        .WillRepeatedly(Return("foo.bar"));
+
+    auto pdrRepo = pldm_pdr_init();
+    auto event = sdeventplus::Event::get_default();
+    Handler handler(&mockedUtils, "./pdr_jsons/state_effecter/good", pdrRepo,
+                    nullptr, nullptr, nullptr, nullptr, nullptr, event, true);
+    Repo repo(pdrRepo);
+    ASSERT_EQ(repo.empty(), true);
+
+    // GetPDR does not build the PDRs, the event loop does when it is idle
+    auto response = handler.getPDR(req, requestPayloadLength);
+    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+    ASSERT_EQ(responsePtr->payload[0], PLDM_ERROR_NOT_READY);
+    ASSERT_EQ(repo.empty(), true);
+
+    sd_event_run(event.get(), 0);
+    ASSERT_EQ(handler.getPDRState(), PDRState::Building);
+    for (int i = 0; i < 10 && handler.getPDRState() != PDRState::Ready; ++i)
+    {
+        sd_event_run(event.get(), 0);
+    }
+    ASSERT_EQ(handler.getPDRState(), PDRState::Ready);
+    ASSERT_EQ(repo.empty(), false);
+
+    response = handler.getPDR(req, requestPayloadLength);
+    responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+    auto resp =
+        reinterpret_cast<struct pldm_get_pdr_resp*>(responsePtr->payload);
+    ASSERT_EQ(PLDM_SUCCESS, resp->completion_code);
+    ASSERT_EQ(2, resp->next_record_handle);
+
+    pldm_pdr_destroy(pdrRepo);
+}
+
+TEST(platformHandler, testNotReadyWhileBuilding)
+{
+    std::array<uint8_t, sizeof(pldm_msg_hdr) +
+                            PLDM_SET_STATE_EFFECTER_STATES_REQ_BYTES>
+        requestMsg{};
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    size_t payloadLength = requestMsg.size() - sizeof(pldm_msg_hdr);
+
+    MockdBusHandler mockedUtils;
+    auto pdrRepo = pldm_pdr_init();
+    auto event = sdeventplus::Event::get_default();
+    Handler handler(&mockedUtils, "./pdr_jsons/state_effecter/good", pdrRepo,
+                    nullptr, nullptr, nullptr, nullptr, nullptr, event, true);
+    ASSERT_NE(handler.getPDRState(), PDRState::Ready);
+
+    // The effecters and sensors are not known till the PDRs are built
+    auto response = handler.setStateEffecterStates(request, payloadLength);
+    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+    EXPECT_EQ(responsePtr->payload[0], PLDM_ERROR_NOT_READY);
+
+    response = handler.setNumericEffecterValue(request, payloadLength);
+    responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+    EXPECT_EQ(responsePtr->payload[0], PLDM_ERROR_NOT_READY);
+
+    response = handler.getStateSensorReadings(request, payloadLength);
+    responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+    EXPECT_EQ(responsePtr->payload[0], PLDM_ERROR_NOT_READY);
+
+    pldm_pdr_destroy(pdrRepo);
+}
+
 TEST(getPDR, testFindPDR)
 {
     std::array<uint8_t, sizeof(pldm_msg_hdr) + PLDM_GET_PDR_REQ_BYTES>
@@ -268,6 +434,44 @@ TEST(setStateEffecterStatesHandler, testGoodRequest)
     pldm_pdr_destroy(outPDRRepo);
 }
 
+TEST(setStateEffecterStatesHandler, testPropertiesKeptToSet)
+{
+    std::array<uint8_t, sizeof(pldm_msg_hdr) + PLDM_GET_PDR_REQ_BYTES>
+        requestPayload{};
+    auto req = reinterpret_cast<pldm_msg*>(requestPayload.data());
+    size_t requestPayloadLength = requestPayload.size() - sizeof(pldm_msg_hdr);
+
+    MockdBusHandler mockedUtils;
+    EXPECT_CALL(mockedUtils, getService(StrEq("/foo/bar"), _))
+        .Times(5)
+        .WillRepeatedly(Return("foo.bar"));
+
+    auto inPDRRepo = pldm_pdr_init();
+    auto event = sdeventplus::Event::get_default();
+    Handler handler(&mockedUtils, "./pdr_jsons/state_effecter/good", inPDRRepo,
+                    nullptr, nullptr, nullptr, nullptr, nullptr, event);
+    handler.getPDR(req, requestPayloadLength);
+
+    std::vector<set_effecter_state_field> stateField;
+    stateField.push_back({PLDM_REQUEST_SET, 1});
+    stateField.push_back({PLDM_NO_CHANGE, 1});
+    PropertyValue propertyValue = std::string("xyz.openbmc_project.Foo.Bar.V1");
+    DBusMapping dbusMapping{"/foo/bar", "xyz.openbmc_project.Foo.Bar",
+                            "propertyName", "string"};
+
+    // The properties are kept to be set without blocking, not set
+    EXPECT_CALL(mockedUtils, setDbusProperty(_, _)).Times(0);
+    DBusPropertySetter setter;
+    auto rc = platform_state_effecter::setStateEffecterStatesHandler<
+        DBusPropertySetter, Handler>(setter, handler, 0x1, stateField);
+    ASSERT_EQ(rc, PLDM_SUCCESS);
+    ASSERT_EQ(setter.getProperties().size(), 1);
+    EXPECT_EQ(setter.getProperties()[0].first, dbusMapping);
+    EXPECT_EQ(setter.getProperties()[0].second, propertyValue);
+
+    pldm_pdr_destroy(inPDRRepo);
+}
+
 TEST(setStateEffecterStatesHandler, testBadRequest)
 {
     std::array<uint8_t, sizeof(pldm_msg_hdr) + PLDM_GET_PDR_REQ_BYTES>
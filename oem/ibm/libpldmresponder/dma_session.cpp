@@ -0,0 +1,222 @@
+#include "dma_session.hpp"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <iostream>
+
+namespace pldm
+{
+namespace responder
+{
+namespace dma
+{
+
+Session::Session(const std::string& device, size_t windowSize,
+                 size_t windows) :
+    device(device),
+    maxMappedWindows(std::clamp<size_t>(windows, 1, maxWindows))
+{
+    static const size_t pageSize = getpagesize();
+    mappedSize = (windowSize + pageSize - 1) / pageSize * pageSize;
+}
+
+Session::~Session()
+{
+    close();
+}
+
+int Session::open(Client& client)
+{
+    client.fd = ::open(device.c_str(), O_RDWR | O_NONBLOCK);
+    if (client.fd < 0)
+    {
+        int rc = -errno;
+        std::cerr << "Failed to open the XDMA device, RC=" << rc << "\n";
+        return rc;
+    }
+
+    client.mem = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED,
+                      client.fd, windowOffset(client));
+    if (MAP_FAILED == client.mem)
+    {
+        int rc = -errno;
+        client.mem = nullptr;
+        ::close(client.fd);
+        client.fd = -1;
+        return rc;
+    }
+    return 0;
+}
+
+int Session::open()
+{
+    if (mappedWindows)
+    {
+        return 0;
+    }
+
+    auto rc = open(clients[0]);
+    if (rc < 0)
+    {
+        std::cerr << "Failed to mmap the XDMA device, RC=" << rc << "\n";
+        return rc;
+    }
+    mappedWindows = 1;
+
+    // The transfers still work one chunk at a time without the next windows
+    for (; mappedWindows < maxMappedWindows; ++mappedWindows)
+    {
+        rc = open(clients[mappedWindows]);
+        if (rc < 0)
+        {
+            std::cerr << "XDMA window " << mappedWindows
+                      << " not mapped, DMA not pipelined, RC=" << rc << "\n";
+            break;
+        }
+    }
+    return 0;
+}
+
+void Session::close()
+{
+    for (auto& client : clients)
+    {
+        if (client.mem)
+        {
+            if (client.inProgress)
+            {
+                // The engine may still write to the window
+                std::cerr << "Closing the XDMA session during a DMA transfer. "
+                             "Skipping Unmap\n";
+            }
+            else
+            {
+                munmap(client.mem, mappedSize);
+            }
+            client.mem = nullptr;
+        }
+        if (client.fd >= 0)
+        {
+            ::close(client.fd);
+            client.fd = -1;
+        }
+        client.inProgress = false;
+    }
+    mappedWindows = 0;
+}
+
+int Session::transfer(uint64_t address, uint32_t length, bool upstream,
+                      size_t index)
+{
+    auto rc = start(address, length, upstream, index);
+    if (rc < 0)
+    {
+        return rc;
+    }
+    return wait(index);
+}
+
+int Session::start(uint64_t address, uint32_t length, bool upstream,
+                   size_t index)
+{
+    if (length > mappedSize)
+    {
+        std::cerr << "DMA operation larger than the XDMA window, LENGTH="
+                  << length << "\n";
+        return -EINVAL;
+    }
+    auto rc = open();
+    if (rc < 0)
+    {
+        return rc;
+    }
+    if (index >= mappedWindows)
+    {
+        return -EINVAL;
+    }
+
+    AspeedXdmaOp xdmaOp;
+    xdmaOp.upstream = upstream ? 1 : 0;
+    xdmaOp.hostAddr = address;
+    xdmaOp.len = length;
+
+    auto& client = clients[index];
+    rc = submit(client, xdmaOp);
+    if (rc < 0)
+    {
+        std::cerr << "Failed to execute the DMA operation, RC=" << rc
+                  << " UPSTREAM=" << upstream << " ADDRESS=" << address
+                  << " LENGTH=" << length << "\n";
+        return rc;
+    }
+    client.inProgress = true;
+    return 0;
+}
+
+int Session::wait(size_t index)
+{
+    auto& client = clients[index];
+    if (!client.inProgress)
+    {
+        return 0;
+    }
+    auto rc = complete(client);
+    client.inProgress = false;
+    if (rc < 0)
+    {
+        std::cerr << "DMA operation failed, RC=" << rc << "\n";
+    }
+    return rc;
+}
+
+int Session::submit(Client& client, const AspeedXdmaOp& op)
+{
+    while (write(client.fd, &op, sizeof(op)) < 0)
+    {
+        // The engine runs one operation at a time, wait for it to be free
+        if (errno != EAGAIN && errno != EBUSY)
+        {
+            return -errno;
+        }
+        pollfd pfd{client.fd, POLLOUT, 0};
+        if (poll(&pfd, 1, -1) < 0 && errno != EINTR)
+        {
+            return -errno;
+        }
+    }
+    return 0;
+}
+
+int Session::complete(Client& client)
+{
+    pollfd pfd{client.fd, POLLIN, 0};
+    while (true)
+    {
+        auto rc = poll(&pfd, 1, -1);
+        if (rc < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return -errno;
+        }
+        if (pfd.revents & POLLERR)
+        {
+            return -EIO;
+        }
+        if (pfd.revents & POLLIN)
+        {
+            return 0;
+        }
+    }
+}
+
+} // namespace dma
+} // namespace responder
+} // namespace pldm
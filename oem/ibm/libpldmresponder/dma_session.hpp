@@ -0,0 +1,205 @@
+#pragma once
+
+#include "config.h"
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+namespace pldm
+{
+namespace responder
+{
+namespace dma
+{
+
+/** @struct AspeedXdmaOp
+ *
+ * Structure representing XDMA operation
+ */
+struct AspeedXdmaOp
+{
+    uint64_t hostAddr; //!< the DMA address on the host side, configured by
+                       //!< PCI subsystem.
+    uint32_t len;      //!< the size of the transfer in bytes, it should be a
+                       //!< multiple of 16 bytes
+    uint32_t upstream; //!< boolean indicating the direction of the DMA
+                       //!< operation, true means a transfer from BMC to host.
+};
+
+constexpr auto xdmaDev = "/dev/aspeed-xdma";
+
+/** @brief Maximum number of VGA memory windows of a session */
+constexpr size_t maxWindows = 2;
+
+/**
+ * @class Session
+ *
+ * Long-lived access to the XDMA engine. The device is opened and its VGA
+ * memory window mapped on the first transfer, and both are reused by the
+ * next ones, rather than opened and mapped for every DMA_MAXSIZE chunk of a
+ * file transfer.
+ *
+ * A second window is mapped when the VGA memory has room for it, so that the
+ * file I/O of a chunk overlaps the DMA of the previous one. Each window is a
+ * client of the XDMA driver of its own, the DMA operations are started
+ * without blocking and waited for with poll().
+ */
+class Session
+{
+  public:
+    Session(const Session&) = delete;
+    Session(Session&&) = delete;
+    Session& operator=(const Session&) = delete;
+    Session& operator=(Session&&) = delete;
+
+    /** @brief Constructor
+     *
+     *  @param[in] device - path of the XDMA device
+     *  @param[in] windowSize - size of the mappings of the VGA memory, the
+     *                          largest transfer the session performs
+     *  @param[in] windows - number of windows to map, at most maxWindows
+     */
+    explicit Session(const std::string& device = xdmaDev,
+                     size_t windowSize = DMA_MAXSIZE,
+                     size_t windows = maxWindows);
+
+    virtual ~Session();
+
+    /** @brief Get the session of the XDMA device of the BMC */
+    static Session& GetInstance()
+    {
+        static Session session;
+        return session;
+    }
+
+    /** @brief Open the device and map the windows, if not done yet
+     *
+     *  @return 0 on success, negative errno on failure
+     */
+    int open();
+
+    /** @brief Unmap the windows and close the device */
+    void close();
+
+    /** @brief Get a mapped VGA memory window
+     *
+     *  @param[in] index - index of the window, less than windows()
+     *
+     *  @return the window, nullptr till open() succeeds
+     */
+    char* window(size_t index = 0) const
+    {
+        return static_cast<char*>(clients[index].mem);
+    }
+
+    /** @brief Get the size of the mapped windows */
+    size_t windowSize() const
+    {
+        return mappedSize;
+    }
+
+    /** @brief Get the number of windows mapped */
+    size_t windows() const
+    {
+        return mappedWindows;
+    }
+
+    /** @brief Run a DMA operation between a window and the host memory and
+     *         wait for it
+     *
+     *  @param[in] address - DMA address on the host
+     *  @param[in] length - length of the data to transfer, at most the window
+     *                      size
+     *  @param[in] upstream - true for a transfer from the window to the host
+     *  @param[in] index - index of the window
+     *
+     *  @return 0 on success, negative errno on failure
+     */
+    int transfer(uint64_t address, uint32_t length, bool upstream,
+                 size_t index = 0);
+
+    /** @brief Start a DMA operation between a window and the host memory
+     *
+     *  The window must not be accessed till wait() returns.
+     *
+     *  @param[in] address - DMA address on the host
+     *  @param[in] length - length of the data to transfer, at most the window
+     *                      size
+     *  @param[in] upstream - true for a transfer from the window to the host
+     *  @param[in] index - index of the window
+     *
+     *  @return 0 on success, negative errno on failure
+     */
+    int start(uint64_t address, uint32_t length, bool upstream,
+              size_t index = 0);
+
+    /** @brief Wait for the DMA operation started on a window to complete
+     *
+     *  @param[in] index - index of the window
+     *
+     *  @return 0 on success, negative errno on failure
+     */
+    int wait(size_t index = 0);
+
+  protected:
+    /** @struct Client
+     *
+     *  A client of the XDMA driver, an open fd and its window
+     */
+    struct Client
+    {
+        int fd = -1;
+        void* mem = nullptr;
+        bool inProgress = false; //!< a DMA operation uses the window
+    };
+
+    /** @brief Open a client of the device and map its window
+     *
+     *  @param[in] client - client to open
+     *
+     *  @return 0 on success, negative errno on failure
+     */
+    int open(Client& client);
+
+    /** @brief Get the offset in the device the window of a client is mapped
+     *         at, the XDMA driver allocates the VGA memory of every client
+     *         on its own
+     *
+     *  @param[in] client - client of the window
+     */
+    virtual off_t windowOffset(const Client& /*client*/) const
+    {
+        return 0;
+    }
+
+    /** @brief Submit a DMA operation to the device, without waiting for it
+     *
+     *  @param[in] client - client to submit the operation with
+     *  @param[in] op - DMA operation
+     *
+     *  @return 0 on success, negative errno on failure
+     */
+    virtual int submit(Client& client, const AspeedXdmaOp& op);
+
+    /** @brief Wait for the DMA operation of a client to complete
+     *
+     *  @param[in] client - client that submitted the operation
+     *
+     *  @return 0 on success, negative errno on failure
+     */
+    virtual int complete(Client& client);
+
+    std::string device;
+    size_t mappedSize;
+    size_t maxMappedWindows;
+    size_t mappedWindows = 0;
+    std::array<Client, maxWindows> clients;
+};
+
+} // namespace dma
+} // namespace responder
+} // namespace pldm
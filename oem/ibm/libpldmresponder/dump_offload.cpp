@@ -0,0 +1,164 @@
+#include "dump_offload.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <functional>
+#include <iostream>
+
+namespace pldm
+{
+namespace responder
+{
+namespace dump
+{
+
+using namespace sdeventplus::source;
+
+// A larger pipe moves a DMA chunk to the socket in fewer splices
+constexpr int pipeSize = 1024 * 1024;
+
+OffloadWriter::Chunk::~Chunk()
+{
+    munmap(mem, size);
+}
+
+OffloadWriter::OffloadWriter(const sdeventplus::Event& event, int sock,
+                             size_t maxQueued) :
+    sock(sock),
+    maxQueued(maxQueued),
+    io(event, sock, EPOLLOUT, std::bind_front(&OffloadWriter::onWritable, this))
+{
+    io.set_enabled(Enabled::Off);
+
+    auto flags = fcntl(sock, F_GETFL);
+    if (flags < 0 || fcntl(sock, F_SETFL, flags | O_NONBLOCK) < 0 ||
+        pipe2(pipeFds, O_NONBLOCK | O_CLOEXEC) < 0)
+    {
+        fail(-errno);
+        return;
+    }
+    fcntl(pipeFds[1], F_SETPIPE_SZ, pipeSize);
+}
+
+OffloadWriter::~OffloadWriter()
+{
+    io.set_enabled(Enabled::Off);
+    for (auto fd : pipeFds)
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+    }
+    close(sock);
+}
+
+int OffloadWriter::write(const char* data, size_t length)
+{
+    if (rc)
+    {
+        return rc;
+    }
+    if (!length)
+    {
+        return 0;
+    }
+
+    auto mem = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (MAP_FAILED == mem)
+    {
+        fail(-errno);
+        return rc;
+    }
+    memcpy(mem, data, length);
+    chunks.emplace_back(mem, length);
+    queued += length;
+
+    auto error = pump();
+    if (error < 0)
+    {
+        fail(error);
+        return rc;
+    }
+    io.set_enabled(drained() ? Enabled::Off : Enabled::On);
+    return 0;
+}
+
+int OffloadWriter::pump()
+{
+    while (queued)
+    {
+        if (inPipe)
+        {
+            auto n = splice(pipeFds[0], nullptr, sock, nullptr, inPipe,
+                            SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+            if (n < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (n < 0)
+            {
+                return errno == EAGAIN ? 0 : -errno;
+            }
+            inPipe -= n;
+            queued -= n;
+            continue;
+        }
+
+        auto& chunk = chunks.front();
+        iovec iov{static_cast<char*>(chunk.mem) + chunk.spliced,
+                  chunk.size - chunk.spliced};
+        auto n = vmsplice(pipeFds[1], &iov, 1, SPLICE_F_NONBLOCK);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n < 0)
+        {
+            return -errno;
+        }
+        chunk.spliced += n;
+        inPipe += n;
+        if (chunk.spliced == chunk.size)
+        {
+            // The pipe holds references to the pages, they outlive the mapping
+            chunks.pop_front();
+        }
+    }
+    return 0;
+}
+
+void OffloadWriter::onWritable(IO& io, int /*fd*/, uint32_t /*revents*/)
+{
+    auto error = pump();
+    if (error < 0)
+    {
+        fail(error);
+        return;
+    }
+    if (drained())
+    {
+        io.set_enabled(Enabled::Off);
+    }
+}
+
+void OffloadWriter::fail(int error)
+{
+    std::cerr << "Failed to write the dump to the offload socket, RC=" << error
+              << "\n";
+    rc = error;
+    io.set_enabled(Enabled::Off);
+    chunks.clear();
+    inPipe = 0;
+    queued = 0;
+}
+
+} // namespace dump
+} // namespace responder
+} // namespace pldm
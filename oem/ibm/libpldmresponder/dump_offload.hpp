@@ -0,0 +1,141 @@
+#pragma once
+
+#include "config.h"
+
+#include <stdint.h>
+
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
+
+#include <cstddef>
+#include <deque>
+
+namespace pldm
+{
+namespace responder
+{
+namespace dump
+{
+
+/**
+ * @class OffloadWriter
+ *
+ * Streams a dump to the unix socket of its offload client. The socket is
+ * non-blocking and the writer waits for it to be writable from the event
+ * loop, so every dump being offloaded has a writer of its own instead of
+ * sharing a thread and a global write status.
+ *
+ * The data is spliced to the socket through a pipe rather than written, the
+ * socket buffers reference the pages of the chunks instead of copying them.
+ */
+class OffloadWriter
+{
+  public:
+    OffloadWriter(const OffloadWriter&) = delete;
+    OffloadWriter(OffloadWriter&&) = delete;
+    OffloadWriter& operator=(const OffloadWriter&) = delete;
+    OffloadWriter& operator=(OffloadWriter&&) = delete;
+
+    /** @brief Constructor
+     *
+     *  @param[in] event - event loop the socket is written from
+     *  @param[in] sock - connected socket of the offload client, closed by
+     *                    the writer
+     *  @param[in] maxQueued - amount of data queued past which the writer
+     *                         is not ready for more
+     */
+    OffloadWriter(const sdeventplus::Event& event, int sock,
+                  size_t maxQueued = DMA_MAXSIZE);
+
+    ~OffloadWriter();
+
+    /** @brief Queue data to write to the socket. The data is copied, what the
+     *         socket takes right away is written before returning and the
+     *         rest from the event loop.
+     *
+     *  @param[in] data - data to write
+     *  @param[in] length - length of the data
+     *
+     *  @return 0 on success, negative errno on failure
+     */
+    int write(const char* data, size_t length);
+
+    /** @brief Check whether the writer takes more data, false while too much
+     *         of it is waiting for the socket
+     */
+    bool ready() const
+    {
+        return !rc && queued < maxQueued;
+    }
+
+    /** @brief Check whether all the data queued was written to the socket */
+    bool drained() const
+    {
+        return !queued;
+    }
+
+    /** @brief Get the error that stopped the writer
+     *
+     *  @return 0 if none, negative errno otherwise
+     */
+    int error() const
+    {
+        return rc;
+    }
+
+  private:
+    /** @struct Chunk
+     *
+     *  Data queued to the socket, in an anonymous mapping of its own. The
+     *  pages spliced to the socket are referenced till the client reads them,
+     *  unmapping the chunk rather than freeing it to the heap keeps them from
+     *  being reused meanwhile.
+     */
+    struct Chunk
+    {
+        Chunk(void* mem, size_t size) : mem(mem), size(size)
+        {}
+        Chunk(const Chunk&) = delete;
+        Chunk(Chunk&&) = delete;
+        Chunk& operator=(const Chunk&) = delete;
+        Chunk& operator=(Chunk&&) = delete;
+        ~Chunk();
+
+        void* mem;
+        size_t size;
+        size_t spliced = 0; //!< amount of the chunk moved to the pipe
+    };
+
+    /** @brief Move the queued data to the socket till it would block
+     *
+     *  @return 0 on success, negative errno on failure
+     */
+    int pump();
+
+    /** @brief Handler of the socket becoming writable
+     *
+     *  @param[in] io - IO source of the socket
+     *  @param[in] fd - the socket
+     *  @param[in] revents - events on the socket
+     */
+    void onWritable(sdeventplus::source::IO& io, int fd, uint32_t revents);
+
+    /** @brief Stop the writer on an error
+     *
+     *  @param[in] error - negative errno
+     */
+    void fail(int error);
+
+    int sock;
+    int pipeFds[2] = {-1, -1};
+    size_t inPipe = 0;  //!< amount of data in the pipe
+    size_t queued = 0;  //!< amount of data not written to the socket yet
+    size_t maxQueued;
+    int rc = 0;
+    std::deque<Chunk> chunks;
+    sdeventplus::source::IO io;
+};
+
+} // namespace dump
+} // namespace responder
+} // namespace pldm
@@ -15,11 +15,11 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cstring>
 #include <fstream>
 #include <iostream>
 #include <memory>
-#include <thread>
 
 namespace pldm
 {
@@ -28,209 +28,204 @@ using namespace sdbusplus::xyz::openbmc_project::Common::Error;
 
 namespace responder
 {
-extern SocketWriteStatus socketWriteStatus;
 namespace fs = std::filesystem;
 namespace dma
 {
 
-/** @struct AspeedXdmaOp
- *
- * Structure representing XDMA operation
- */
-struct AspeedXdmaOp
+int DMA::transferHostDataToSocket(dump::OffloadWriter& writer,
+                                  uint32_t length, uint64_t address)
 {
-    uint64_t hostAddr; //!< the DMA address on the host side, configured by
-                       //!< PCI subsystem.
-    uint32_t len;      //!< the size of the transfer in bytes, it should be a
-                       //!< multiple of 16 bytes
-    uint32_t upstream; //!< boolean indicating the direction of the DMA
-                       //!< operation, true means a transfer from BMC to host.
-};
-
-constexpr auto xdmaDev = "/dev/aspeed-xdma";
-
-int DMA::transferHostDataToSocket(int fd, uint32_t length, uint64_t address)
-{
-    socketWriteStatus = NotReady;
-    static const size_t pageSize = getpagesize();
-    uint32_t numPages = length / pageSize;
-    uint32_t pageAlignedLength = numPages * pageSize;
-
-    if (length > pageAlignedLength)
-    {
-        pageAlignedLength += pageSize;
-    }
-    int dmaFd = -1;
-    int rc = 0;
-    dmaFd = open(xdmaDev, O_RDWR);
-    if (dmaFd < 0)
+    auto rc = session.transfer(address, length, false);
+    if (rc < 0)
     {
-        rc = -errno;
-        std::cerr
-            << "transferHostDataToSocket : Failed to open the XDMA device, RC="
-            << rc << "\n";
+        std::cerr << "transferHostDataToSocket : DMA failed, RC=" << rc
+                  << " ADDRESS=" << address << " LENGTH=" << length << "\n";
         return rc;
     }
 
-    pldm::utils::CustomFD xdmaFd(dmaFd);
-    void* vgaMemDump = NULL;
-    vgaMemDump =
-        mmap(nullptr, pageAlignedLength, PROT_READ, MAP_SHARED, xdmaFd(), 0);
-    if (MAP_FAILED == vgaMemDump)
-    {
-        rc = -errno;
-        std::cerr
-            << "transferHostDataToSocket : Failed to mmap the XDMA device, RC="
-            << rc << "\n";
-        return rc;
-    }
+    // The window is reused by the next DMA operation, the writer queues a
+    // copy of the data
+    return writer.write(session.window(), length);
+}
 
-    AspeedXdmaOp xdmaOp;
-    xdmaOp.upstream = 0;
-    xdmaOp.hostAddr = address;
-    xdmaOp.len = length;
+namespace
+{
 
-    rc = write(xdmaFd(), &xdmaOp, sizeof(xdmaOp));
-    if (rc < 0)
+/** @brief Read a chunk of a file into a window
+ *
+ *  @return 0 on success, -1 on failure
+ */
+int readChunk(int fd, char* window, uint32_t offset, uint32_t length)
+{
+    uint32_t count = 0;
+    while (count < length)
     {
-        rc = -errno;
-        std::cerr
-            << "transferHostDataToSocket : Failed to execute the DMA operation, RC="
-            << rc << " ADDRESS=" << address << " LENGTH=" << length << "\n";
-        munmap(vgaMemDump, pageAlignedLength);
-        return rc;
+        auto rc = pread(fd, window + count, length - count, offset + count);
+        if (rc == -1 && errno == EINTR)
+        {
+            continue;
+        }
+        if (rc == -1)
+        {
+            std::cerr << "transferDataHost upstream : file read failed, ERROR="
+                      << errno << ", LENGTH=" << length
+                      << ", OFFSET=" << offset << "\n";
+            return -1;
+        }
+        if (rc == 0)
+        {
+            std::cerr << "transferDataHost upstream : mismatch between number "
+                         "of characters to read and the length read, LENGTH="
+                      << length << " COUNT=" << count << "\n";
+            return -1;
+        }
+        count += rc;
     }
-
-    std::thread dumpOffloadThread(writeToUnixSocket, fd,
-                                  static_cast<const char*>(vgaMemDump), length);
-    dumpOffloadThread.detach();
-
     return 0;
 }
 
-int DMA::transferDataHost(int fd, uint32_t offset, uint32_t length,
-                          uint64_t address, bool upstream)
+/** @brief Write a chunk of a file from a window
+ *
+ *  @return 0 on success, -1 on failure
+ */
+int writeChunk(int fd, const char* window, uint32_t offset, uint32_t length)
 {
-    static const size_t pageSize = getpagesize();
-    uint32_t numPages = length / pageSize;
-    uint32_t pageAlignedLength = numPages * pageSize;
-
-    if (length > pageAlignedLength)
+    uint32_t count = 0;
+    while (count < length)
     {
-        pageAlignedLength += pageSize;
-    }
-    int rc = 0;
-    auto mmapCleanup = [pageAlignedLength, &rc](void* vgaMem) {
-        if (rc != -EINTR)
+        auto rc = pwrite(fd, window + count, length - count, offset + count);
+        if (rc == -1 && errno == EINTR)
         {
-            munmap(vgaMem, pageAlignedLength);
+            continue;
         }
-        else
+        if (rc == -1)
         {
             std::cerr
-                << "Received interrupt during DMA transfer. Skipping Unmap"
-                << std::endl;
+                << "transferDataHost downstream : file write failed, ERROR="
+                << errno << ", LENGTH=" << length << ", OFFSET=" << offset
+                << "\n";
+            return -1;
         }
-    };
+        count += rc;
+    }
+    return 0;
+}
+
+} // namespace
 
-    int dmaFd = -1;
-    dmaFd = open(xdmaDev, O_RDWR);
-    if (dmaFd < 0)
+int DMA::transferDataHost(int fd, uint32_t offset, uint32_t length,
+                          uint64_t address, bool upstream)
+{
+    int rc = session.open();
+    if (rc < 0)
     {
-        rc = -errno;
-        std::cerr << "transferDataHost : Failed to open the XDMA device, RC="
+        std::cerr << "transferDataHost : Failed to open the XDMA session, RC="
                   << rc << "\n";
         return rc;
     }
+    if (length > session.windowSize())
+    {
+        std::cerr << "transferDataHost : length exceeds the XDMA window, "
+                     "LENGTH="
+                  << length << "\n";
+        return -EINVAL;
+    }
 
-    pldm::utils::CustomFD xdmaFd(dmaFd);
+    // The file is read into and written from the window itself, the DMA
+    // operation only covers the length of the transfer
+    if (upstream && readChunk(fd, session.window(), offset, length) < 0)
+    {
+        return -1;
+    }
+    rc = session.transfer(address, length, upstream);
+    if (rc < 0)
+    {
+        return rc;
+    }
+    if (!upstream && writeChunk(fd, session.window(), offset, length) < 0)
+    {
+        return -1;
+    }
+    return 0;
+}
 
-    void* vgaMem;
-    vgaMem = mmap(nullptr, pageAlignedLength, upstream ? PROT_WRITE : PROT_READ,
-                  MAP_SHARED, xdmaFd(), 0);
-    if (MAP_FAILED == vgaMem)
+int DMA::transferAllDataHost(int fd, uint32_t offset, uint32_t length,
+                             uint64_t address, bool upstream)
+{
+    int rc = session.open();
+    if (rc < 0)
     {
-        rc = -errno;
-        std::cerr << "transferDataHost : Failed to mmap the XDMA device, RC="
+        std::cerr << "transferDataHost : Failed to open the XDMA session, RC="
                   << rc << "\n";
         return rc;
     }
+    auto windows = session.windows();
+    auto chunkSize = std::min<uint32_t>(maxSize, session.windowSize());
+    auto chunks = length ? (length + chunkSize - 1) / chunkSize : 1;
+    auto chunkLength = [&](uint32_t chunk) {
+        return std::min(chunkSize, length - chunk * chunkSize);
+    };
+    auto fileIO = [&](uint32_t chunk) {
+        auto window = session.window(chunk % windows);
+        auto chunkOffset = offset + chunk * chunkSize;
+        return upstream
+                   ? readChunk(fd, window, chunkOffset, chunkLength(chunk))
+                   : writeChunk(fd, window, chunkOffset, chunkLength(chunk));
+    };
 
-    std::unique_ptr<void, decltype(mmapCleanup)> vgaMemPtr(vgaMem, mmapCleanup);
-
-    if (upstream)
+    // Upstream the window of a chunk is filled while the previous chunk is
+    // DMAed, downstream it is written out while the next chunk is DMAed
+    if (upstream && fileIO(0) < 0)
     {
-        rc = lseek(fd, offset, SEEK_SET);
-        if (rc == -1)
+        return -1;
+    }
+    for (uint32_t chunk = 0; chunk < chunks; ++chunk)
+    {
+        rc = session.start(address + uint64_t(chunk) * chunkSize,
+                           chunkLength(chunk), upstream, chunk % windows);
+        if (rc < 0)
         {
-            std::cerr << "transferDataHost upstream : lseek failed, ERROR="
-                      << errno << ", UPSTREAM=" << upstream
-                      << ", OFFSET=" << offset << "\n";
             return rc;
         }
 
-        // Writing to the VGA memory should be aligned at page boundary,
-        // otherwise write data into a buffer aligned at page boundary and
-        // then write to the VGA memory.
-        std::vector<char> buffer{};
-        buffer.resize(pageAlignedLength);
-        rc = read(fd, buffer.data(), length);
-        if (rc == -1)
+        // With a single window the file I/O waits for the DMA to complete
+        int ioRc = 0;
+        if (windows > 1)
         {
-            std::cerr << "transferDataHost upstream : file read failed, ERROR="
-                      << errno << ", UPSTREAM=" << upstream
-                      << ", LENGTH=" << length << ", OFFSET=" << offset << "\n";
-            return rc;
+            if (upstream && chunk + 1 < chunks)
+            {
+                ioRc = fileIO(chunk + 1);
+            }
+            else if (!upstream && chunk > 0)
+            {
+                ioRc = fileIO(chunk - 1);
+            }
         }
-        if (rc != static_cast<int>(length))
+        rc = session.wait(chunk % windows);
+        if (rc < 0)
         {
-            std::cerr
-                << "transferDataHost upstream : mismatch between number of characters to read and "
-                << "the length read, LENGTH=" << length << " COUNT=" << rc
-                << "\n";
-            return -1;
+            return rc;
         }
-        memcpy(static_cast<char*>(vgaMemPtr.get()), buffer.data(),
-               pageAlignedLength);
-    }
-
-    AspeedXdmaOp xdmaOp;
-    xdmaOp.upstream = upstream ? 1 : 0;
-    xdmaOp.hostAddr = address;
-    xdmaOp.len = length;
-
-    rc = write(xdmaFd(), &xdmaOp, sizeof(xdmaOp));
-    if (rc < 0)
-    {
-        rc = -errno;
-        std::cerr
-            << "transferDataHost : Failed to execute the DMA operation, RC="
-            << rc << " UPSTREAM=" << upstream << " ADDRESS=" << address
-            << " LENGTH=" << length << "\n";
-        return rc;
-    }
-
-    if (!upstream)
-    {
-        rc = lseek(fd, offset, SEEK_SET);
-        if (rc == -1)
+        if (windows == 1)
         {
-            std::cerr << "transferDataHost downstream : lseek failed, ERROR="
-                      << errno << ", UPSTREAM=" << upstream
-                      << ", OFFSET=" << offset << "\n";
-            return rc;
+            if (upstream && chunk + 1 < chunks)
+            {
+                ioRc = fileIO(chunk + 1);
+            }
+            else if (!upstream)
+            {
+                ioRc = fileIO(chunk);
+            }
         }
-        rc = write(fd, static_cast<const char*>(vgaMemPtr.get()), length);
-        if (rc == -1)
+        if (ioRc < 0)
         {
-            std::cerr
-                << "transferDataHost downstream : file write failed, ERROR="
-                << errno << ", UPSTREAM=" << upstream << ", LENGTH=" << length
-                << ", OFFSET=" << offset << "\n";
-            return rc;
+            return -1;
         }
     }
-
+    if (!upstream && windows > 1 && fileIO(chunks - 1) < 0)
+    {
+        return -1;
+    }
     return 0;
 }
 
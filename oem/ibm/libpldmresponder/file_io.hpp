@@ -7,6 +7,8 @@
 #include "oem/ibm/libpldm/host.h"
 
 #include "common/utils.hpp"
+#include "dma_session.hpp"
+#include "dump_offload.hpp"
 #include "oem/ibm/requester/dbus_to_file_handler.hpp"
 #include "oem_ibm_handler.hpp"
 #include "pldmd/handler.hpp"
@@ -48,6 +50,13 @@ namespace fs = std::filesystem;
 class DMA
 {
   public:
+    /** @brief Constructor
+     *
+     *  @param[in] session - XDMA session the transfers go through
+     */
+    explicit DMA(Session& session = Session::GetInstance()) : session(session)
+    {}
+
     /** @brief API to transfer data between BMC and host using DMA
      *
      * @param[in] path     - pathname of the file to transfer data from or to
@@ -62,22 +71,44 @@ class DMA
     int transferDataHost(int fd, uint32_t offset, uint32_t length,
                          uint64_t address, bool upstream);
 
+    /** @brief API to transfer data of any length between BMC and host using
+     *         DMA, in DMA_MAXSIZE chunks whose file I/O overlaps the DMA of
+     *         the previous or next chunk
+     *
+     * @param[in] fd       - file descriptor of the file to transfer data from
+     *                       or to
+     * @param[in] offset   - offset in the file
+     * @param[in] length   - length of the data to transfer
+     * @param[in] address  - DMA address on the host
+     * @param[in] upstream - indicates direction of the transfer; true indicates
+     *                       transfer to the host
+     *
+     * @return returns 0 on success, negative errno on failure
+     */
+    int transferAllDataHost(int fd, uint32_t offset, uint32_t length,
+                            uint64_t address, bool upstream);
+
     /** @brief API to transfer data on to unix socket from host using DMA
      *
-     * @param[in] path     - pathname of the file to transfer data from or to
+     * @param[in] writer   - writer of the unix socket of the dump offload
      * @param[in] length   - length of the data to transfer
      * @param[in] address  - DMA address on the host
      *
      * @return returns 0 on success, negative errno on failure
      */
-    int transferHostDataToSocket(int fd, uint32_t length, uint64_t address);
+    int transferHostDataToSocket(dump::OffloadWriter& writer, uint32_t length,
+                                 uint64_t address);
+
+  private:
+    Session& session;
 };
 
 /** @brief Transfer the data between BMC and host using DMA.
  *
  *  There is a max size for each DMA operation, transferAll API abstracts this
  *  and the requested length is broken down into multiple DMA operations if the
- *  length exceed max size.
+ *  length exceed max size. Interfaces with a transferAllDataHost API do that
+ *  themselves, and pipeline the DMA operations.
  *
  * @tparam[in] T - DMA interface type
  * @param[in] intf - interface passed to invoke DMA transfer
@@ -124,6 +155,19 @@ Response transferAll(DMAInterface* intf, uint8_t command, fs::path& path,
     }
     pldm::utils::CustomFD fd(file);
 
+    if constexpr (requires {
+                      intf->transferAllDataHost(fd(), offset, length, address,
+                                                upstream);
+                  })
+    {
+        auto rc = intf->transferAllDataHost(fd(), offset, length, address,
+                                            upstream);
+        encode_rw_file_memory_resp(instanceId, command,
+                                   rc < 0 ? PLDM_ERROR : PLDM_SUCCESS,
+                                   rc < 0 ? 0 : origLength, responsePtr);
+        return response;
+    }
+
     while (length > dma::maxSize)
     {
         auto rc = intf->transferDataHost(fd(), offset, dma::maxSize, address,
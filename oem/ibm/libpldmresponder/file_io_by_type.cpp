@@ -37,31 +37,26 @@ int FileHandler::transferFileData(int32_t fd, bool upstream, uint32_t offset,
                                   uint32_t& length, uint64_t address)
 {
     dma::DMA xdmaInterface;
+    auto rc = xdmaInterface.transferAllDataHost(fd, offset, length, address,
+                                                upstream);
+
+    // Leave the length of the last DMA operation, as the transfer of one
+    // chunk at a time did
     while (length > dma::maxSize)
     {
-        auto rc = xdmaInterface.transferDataHost(fd, offset, dma::maxSize,
-                                                 address, upstream);
-        if (rc < 0)
-        {
-            return PLDM_ERROR;
-        }
-        offset += dma::maxSize;
         length -= dma::maxSize;
-        address += dma::maxSize;
     }
-    auto rc =
-        xdmaInterface.transferDataHost(fd, offset, length, address, upstream);
     return rc < 0 ? PLDM_ERROR : PLDM_SUCCESS;
 }
 
-int FileHandler::transferFileDataToSocket(int32_t fd, uint32_t& length,
-                                          uint64_t address)
+int FileHandler::transferFileDataToSocket(dump::OffloadWriter& writer,
+                                          uint32_t& length, uint64_t address)
 {
     dma::DMA xdmaInterface;
     while (length > dma::maxSize)
     {
-        auto rc =
-            xdmaInterface.transferHostDataToSocket(fd, dma::maxSize, address);
+        auto rc = xdmaInterface.transferHostDataToSocket(writer, dma::maxSize,
+                                                         address);
         if (rc < 0)
         {
             return PLDM_ERROR;
@@ -69,7 +64,7 @@ int FileHandler::transferFileDataToSocket(int32_t fd, uint32_t& length,
         length -= dma::maxSize;
         address += dma::maxSize;
     }
-    auto rc = xdmaInterface.transferHostDataToSocket(fd, length, address);
+    auto rc = xdmaInterface.transferHostDataToSocket(writer, length, address);
     return rc < 0 ? PLDM_ERROR : PLDM_SUCCESS;
 }
 
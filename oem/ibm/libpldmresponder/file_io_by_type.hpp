@@ -142,8 +142,8 @@ class FileHandler
     virtual int transferFileData(int fd, bool upstream, uint32_t offset,
                                  uint32_t& length, uint64_t address);
 
-    virtual int transferFileDataToSocket(int fd, uint32_t& length,
-                                         uint64_t address);
+    virtual int transferFileDataToSocket(dump::OffloadWriter& writer,
+                                         uint32_t& length, uint64_t address);
 
     /** @brief Constructor to create a FileHandler object
      */
@@ -12,6 +12,7 @@
 #include <unistd.h>
 
 #include <sdbusplus/server.hpp>
+#include <sdeventplus/event.hpp>
 #include <xyz/openbmc_project/Dump/NewDump/server.hpp>
 
 #include <exception>
@@ -40,9 +41,9 @@ static constexpr auto sbeDumpObjPath = "/xyz/openbmc_project/dump/sbe/entry";
 static constexpr auto hardwareDumpObjPath =
     "/xyz/openbmc_project/dump/hardware/entry";
 
-int DumpHandler::fd = -1;
+std::map<DumpHandler::OffloadKey, std::unique_ptr<dump::OffloadWriter>>
+    DumpHandler::offloads;
 namespace fs = std::filesystem;
-extern SocketWriteStatus socketWriteStatus;
 
 std::string DumpHandler::findDumpObjPath(uint32_t fileHandle)
 {
@@ -256,113 +257,115 @@ std::string DumpHandler::getOffloadUri(uint32_t fileHandle)
     return socketInterface;
 }
 
-int DumpHandler::writeFromMemory(uint32_t, uint32_t length, uint64_t address,
-                                 oem_platform::Handler* /*oemPlatformHandler*/)
+dump::OffloadWriter* DumpHandler::getOffloadWriter()
 {
-    if (DumpHandler::fd == -1)
+    auto offload = offloads.find({dumpType, fileHandle});
+    if (offload != offloads.end())
+    {
+        return offload->second.get();
+    }
+
+    auto socketInterface = getOffloadUri(fileHandle);
+    int sock = setupUnixSocket(socketInterface);
+    if (sock >= 0)
     {
-        auto socketInterface = getOffloadUri(fileHandle);
-        int sock = setupUnixSocket(socketInterface);
-        if (sock < 0)
+        try
         {
-            sock = -errno;
-            close(DumpHandler::fd);
-            std::cerr
-                << "DumpHandler::writeFromMemory: setupUnixSocket() failed"
-                << std::endl;
-            std::remove(socketInterface.c_str());
-            resetOffloadUri();
-            return PLDM_ERROR;
+            auto writer = std::make_unique<dump::OffloadWriter>(
+                sdeventplus::Event::get_default(), sock);
+            return offloads.emplace(OffloadKey{dumpType, fileHandle},
+                                    std::move(writer))
+                .first->second.get();
         }
-
-        DumpHandler::fd = sock;
-        auto rc = transferFileDataToSocket(DumpHandler::fd, length, address);
-        if (rc < 0)
+        catch (const std::exception& e)
         {
-            std::cerr
-                << "DumpHandler::writeFromMemory: transferFileDataToSocket failed"
-                << std::endl;
-            if (DumpHandler::fd >= 0)
-            {
-                close(DumpHandler::fd);
-                DumpHandler::fd = -1;
-            }
-            std::remove(socketInterface.c_str());
-            resetOffloadUri();
-            return PLDM_ERROR;
+            std::cerr << "DumpHandler::getOffloadWriter: failed to watch the "
+                         "Unix socket, ERROR="
+                      << e.what() << "\n";
+            close(sock);
         }
-        return rc < 0 ? PLDM_ERROR : PLDM_SUCCESS;
     }
+    else
+    {
+        std::cerr << "DumpHandler::getOffloadWriter: setupUnixSocket() failed"
+                  << std::endl;
+    }
+    std::remove(socketInterface.c_str());
+    resetOffloadUri();
+    return nullptr;
+}
 
-    if (socketWriteStatus == Error)
+void DumpHandler::endOffload()
+{
+    offloads.erase({dumpType, fileHandle});
+    auto socketInterface = getOffloadUri(fileHandle);
+    std::remove(socketInterface.c_str());
+    resetOffloadUri();
+}
+
+int DumpHandler::writeFromMemory(uint32_t, uint32_t length, uint64_t address,
+                                 oem_platform::Handler* /*oemPlatformHandler*/)
+{
+    auto writer = getOffloadWriter();
+    if (!writer)
+    {
+        return PLDM_ERROR;
+    }
+
+    if (writer->error())
     {
         std::cerr
             << "DumpHandler::writeFromMemory: Error while writing to Unix socket"
             << std::endl;
-        if (DumpHandler::fd >= 0)
-        {
-            close(DumpHandler::fd);
-            DumpHandler::fd = -1;
-        }
-        auto socketInterface = getOffloadUri(fileHandle);
-        std::remove(socketInterface.c_str());
-        resetOffloadUri();
+        endOffload();
         return PLDM_ERROR;
     }
-    else if (socketWriteStatus == InProgress || socketWriteStatus == NotReady)
+    else if (!writer->ready())
     {
         return PLDM_ERROR_NOT_READY;
     }
 
-    auto rc = transferFileDataToSocket(DumpHandler::fd, length, address);
-    if (rc < 0)
+    auto rc = transferFileDataToSocket(*writer, length, address);
+    if (rc != PLDM_SUCCESS)
     {
         std::cerr
             << "DumpHandler::writeFromMemory: transferFileDataToSocket failed"
             << std::endl;
-        if (DumpHandler::fd >= 0)
-        {
-            close(DumpHandler::fd);
-            DumpHandler::fd = -1;
-        }
-        auto socketInterface = getOffloadUri(fileHandle);
-        std::remove(socketInterface.c_str());
-        resetOffloadUri();
+        endOffload();
         return PLDM_ERROR;
     }
-    return rc < 0 ? PLDM_ERROR : PLDM_SUCCESS;
+    return PLDM_SUCCESS;
 }
 
 int DumpHandler::write(const char* buffer, uint32_t, uint32_t& length,
                        oem_platform::Handler* /*oemPlatformHandler*/)
 {
     std::cout << "Enter DumpHandler::write length = " << length
-              << " DumpHandler::fd = " << DumpHandler::fd << std::endl;
+              << " fileHandle = " << fileHandle << std::endl;
+
+    auto writer = getOffloadWriter();
+    if (!writer)
+    {
+        return PLDM_ERROR;
+    }
 
-    if (socketWriteStatus == Error)
+    if (writer->error())
     {
         std::cerr << "DumpHandler::write: Error while writing to Unix socket"
                   << std::endl;
-        close(fd);
-        auto socketInterface = getOffloadUri(fileHandle);
-        std::remove(socketInterface.c_str());
-        resetOffloadUri();
+        endOffload();
         return PLDM_ERROR;
     }
-    else if (socketWriteStatus == InProgress)
+    else if (!writer->ready())
     {
         return PLDM_ERROR_NOT_READY;
     }
 
-    writeToUnixSocket(DumpHandler::fd, buffer, length);
-    if (socketWriteStatus == Error)
+    if (writer->write(buffer, length) < 0)
     {
         std::cerr << "DumpHandler::write: Error while writing to Unix socket"
                   << std::endl;
-        close(fd);
-        auto socketInterface = getOffloadUri(fileHandle);
-        std::remove(socketInterface.c_str());
-        resetOffloadUri();
+        endOffload();
         return PLDM_ERROR;
     }
 
@@ -466,7 +469,8 @@ int DumpHandler::fileAck(uint8_t fileStatus)
             dumpType == PLDM_FILE_TYPE_RESOURCE_DUMP)
         {
 
-            if (socketWriteStatus == InProgress)
+            auto offload = offloads.find({dumpType, fileHandle});
+            if (offload != offloads.end() && !offload->second->drained())
             {
                 return PLDM_ERROR_NOT_READY;
             }
@@ -489,14 +493,7 @@ int DumpHandler::fileAck(uint8_t fileStatus)
                 return PLDM_ERROR;
             }
 
-            auto socketInterface = getOffloadUri(fileHandle);
-            if (DumpHandler::fd >= 0)
-            {
-                close(DumpHandler::fd);
-                DumpHandler::fd = -1;
-            }
-            std::remove(socketInterface.c_str());
-            resetOffloadUri();
+            endOffload();
         }
         return PLDM_SUCCESS;
     }
@@ -688,11 +685,17 @@ int DumpHandler::fileAckWithMetaData(uint8_t /*fileStatus*/,
         return PLDM_SUCCESS;
     }
 
-    if (DumpHandler::fd >= 0 && !path.empty())
+    auto offload = offloads.find({dumpType, fileHandle});
+    if (offload != offloads.end() && !path.empty())
     {
         if (dumpType == PLDM_FILE_TYPE_DUMP ||
             dumpType == PLDM_FILE_TYPE_RESOURCE_DUMP)
         {
+            if (!offload->second->drained())
+            {
+                return PLDM_ERROR_NOT_READY;
+            }
+
             PropertyValue value{true};
             DBusMapping dbusMapping{path, dumpEntry, "Offloaded", "bool"};
             try
@@ -710,11 +713,7 @@ int DumpHandler::fileAckWithMetaData(uint8_t /*fileStatus*/,
                 return PLDM_ERROR;
             }
 
-            close(DumpHandler::fd);
-            auto socketInterface = getOffloadUri(fileHandle);
-            std::remove(socketInterface.c_str());
-            DumpHandler::fd = -1;
-            resetOffloadUri();
+            endOffload();
         }
         return PLDM_SUCCESS;
     }
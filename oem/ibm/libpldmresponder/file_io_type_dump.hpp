@@ -2,6 +2,10 @@
 
 #include "file_io_by_type.hpp"
 
+#include <map>
+#include <memory>
+#include <utility>
+
 namespace pldm
 {
 namespace responder
@@ -60,7 +64,26 @@ class DumpHandler : public FileHandler
     {}
 
   private:
-    static int fd;     //!< fd to manage the dump offload to bmc
+    /** @brief Get the writer of the offload of the dump, the unix socket of
+     *         the offload client is set up on the first chunk
+     *
+     *  @return the writer, nullptr if the socket could not be set up
+     */
+    dump::OffloadWriter* getOffloadWriter();
+
+    /** @brief End the offload of the dump, close its socket and reset its
+     *         OffloadUri
+     */
+    void endOffload();
+
+    using OffloadKey = std::pair<uint16_t, uint32_t>;
+
+    /** @brief writers of the dumps being offloaded to bmc, by dump type and
+     *         file handle
+     */
+    static std::map<OffloadKey, std::unique_ptr<dump::OffloadWriter>>
+        offloads;
+
     uint16_t dumpType; //!< type of the dump
     std::string
         resDumpRequestDirPath; //!< directory where the resource
@@ -5,6 +5,7 @@
 #include "libpldm/base.h"
 #include "oem/ibm/libpldm/file_io.h"
 
+#include "common/deferred_response.hpp"
 #include "common/utils.hpp"
 #include "xyz/openbmc_project/Common/error.hpp"
 
@@ -89,6 +90,33 @@ Entry::Level getEntryLevelFromPEL(const std::string& pelFileName)
 
     return Entry::Level::Error;
 }
+
+/** @brief Create the d-bus method call notifying the pel daemon of a pel
+ *
+ *  @param[in] pelFileName - the pel file path
+ *
+ *  @return the method call
+ */
+sdbusplus::message::message newCreatePelCall(std::string&& pelFileName)
+{
+    static constexpr auto logObjPath = "/xyz/openbmc_project/logging";
+    static constexpr auto logInterface = "xyz.openbmc_project.Logging.Create";
+
+    auto& bus = pldm::utils::DBusHandler::getBus();
+    auto service =
+        pldm::utils::DBusHandler().getService(logObjPath, logInterface);
+    std::map<std::string, std::string> addlData{};
+    auto severity =
+        sdbusplus::xyz::openbmc_project::Logging::server::convertForMessage(
+            getEntryLevelFromPEL(pelFileName));
+    addlData.emplace("RAWPEL", std::move(pelFileName));
+
+    auto method = bus.new_method_call(service.c_str(), logObjPath,
+                                      logInterface, "Create");
+    method.append("xyz.openbmc_project.Host.Error.Event", severity, addlData);
+    return method;
+}
+
 } // namespace detail
 
 int PelHandler::readIntoMemory(uint32_t offset, uint32_t& length,
@@ -206,11 +234,26 @@ int PelHandler::writeFromMemory(uint32_t offset, uint32_t length,
     fs::path path(tmpFile);
 
     auto rc = transferFileData(path, false, offset, length, address);
-    if (rc == PLDM_SUCCESS)
+    if (rc != PLDM_SUCCESS)
     {
-        rc = storePel(path.string());
+        return rc;
     }
-    return rc;
+
+    // Respond once the PEL daemon took the PEL, without blocking meanwhile
+    auto responder = pldm::deferred::DeferredResponse::GetInstance().defer();
+    if (!responder)
+    {
+        return storePel(path.string());
+    }
+    storePelAsync(path.string(), [responder = *responder, length](int rc) {
+        Response response(
+            sizeof(pldm_msg_hdr) + PLDM_RW_FILE_BY_TYPE_MEM_RESP_BYTES, 0);
+        encode_rw_file_by_type_memory_resp(
+            responder.instanceId(), PLDM_WRITE_FILE_BY_TYPE_FROM_MEMORY, rc,
+            length, reinterpret_cast<pldm_msg*>(response.data()));
+        responder.send(std::move(response));
+    });
+    return PLDM_SUCCESS;
 }
 
 int PelHandler::fileAck(uint8_t /*fileStatus*/)
@@ -238,27 +281,10 @@ int PelHandler::fileAck(uint8_t /*fileStatus*/)
 
 int PelHandler::storePel(std::string&& pelFileName)
 {
-    static constexpr auto logObjPath = "/xyz/openbmc_project/logging";
-    static constexpr auto logInterface = "xyz.openbmc_project.Logging.Create";
-
-    auto& bus = pldm::utils::DBusHandler::getBus();
-
     try
     {
-        auto service =
-            pldm::utils::DBusHandler().getService(logObjPath, logInterface);
-        using namespace sdbusplus::xyz::openbmc_project::Logging::server;
-        std::map<std::string, std::string> addlData{};
-        auto severity =
-            sdbusplus::xyz::openbmc_project::Logging::server::convertForMessage(
-                detail::getEntryLevelFromPEL(pelFileName));
-        addlData.emplace("RAWPEL", std::move(pelFileName));
-
-        auto method = bus.new_method_call(service.c_str(), logObjPath,
-                                          logInterface, "Create");
-        method.append("xyz.openbmc_project.Host.Error.Event", severity,
-                      addlData);
-        bus.call_noreply(method);
+        auto method = detail::newCreatePelCall(std::move(pelFileName));
+        pldm::utils::DBusHandler::getBus().call_noreply(method);
     }
     catch (const std::exception& e)
     {
@@ -270,6 +296,33 @@ int PelHandler::storePel(std::string&& pelFileName)
     return PLDM_SUCCESS;
 }
 
+void PelHandler::storePelAsync(std::string&& pelFileName,
+                               std::function<void(int)>&& callback)
+{
+    try
+    {
+        auto method = detail::newCreatePelCall(std::move(pelFileName));
+        pldm::utils::DBusHandler::callAsync(
+            method, [callback](sdbusplus::message::message& reply) {
+                if (reply.is_method_error())
+                {
+                    std::cerr << "d-bus call to PEL daemon failed, ERROR="
+                              << sd_bus_message_get_errno(reply.get())
+                              << "\n";
+                    callback(PLDM_ERROR);
+                    return;
+                }
+                callback(PLDM_SUCCESS);
+            });
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "failed to make a d-bus call to PEL daemon, ERROR="
+                  << e.what() << "\n";
+        callback(PLDM_ERROR);
+    }
+}
+
 int PelHandler::write(const char* buffer, uint32_t offset, uint32_t& length,
                       oem_platform::Handler* /*oemPlatformHandler*/)
 {
@@ -313,6 +366,26 @@ int PelHandler::write(const char* buffer, uint32_t offset, uint32_t& length,
     if (written == length)
     {
         fs::path path(tmpFile);
+        auto responder =
+            pldm::deferred::DeferredResponse::GetInstance().defer();
+        if (responder)
+        {
+            storePelAsync(path.string(), [responder = *responder, length,
+                                          path](int rc) {
+                if (rc != PLDM_SUCCESS)
+                {
+                    std::cerr << "save PEL failed, ERROR = " << rc
+                              << "tmpFile = " << path << "\n";
+                }
+                Response response(sizeof(pldm_msg_hdr) +
+                                  PLDM_RW_FILE_BY_TYPE_RESP_BYTES);
+                encode_rw_file_by_type_resp(
+                    responder.instanceId(), PLDM_WRITE_FILE_BY_TYPE, rc,
+                    length, reinterpret_cast<pldm_msg*>(response.data()));
+                responder.send(std::move(response));
+            });
+            return PLDM_SUCCESS;
+        }
         rc = storePel(path.string());
         if (rc != PLDM_SUCCESS)
         {
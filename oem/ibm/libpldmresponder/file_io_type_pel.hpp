@@ -2,6 +2,8 @@
 
 #include "file_io_by_type.hpp"
 
+#include <functional>
+
 namespace pldm
 {
 namespace responder
@@ -44,6 +46,17 @@ class PelHandler : public FileHandler
      */
     virtual int storePel(std::string&& pelFileName);
 
+    /** @brief method to store a pel file in tempfs and send the d-bus
+     *  notification to pel daemon without waiting for its reply
+     *
+     *  @param[in] pelFileName - the pel file path
+     *  @param[in] callback - invoked with the completion code once the pel
+     *                        daemon replied, or right away if the d-bus call
+     *                        could not be made
+     */
+    virtual void storePelAsync(std::string&& pelFileName,
+                               std::function<void(int)>&& callback);
+
     virtual int newFileAvailable(uint64_t /*length*/)
     {
         return PLDM_ERROR_UNSUPPORTED_PLDM_CMD;
@@ -5,7 +5,6 @@
 #include "common/utils.hpp"
 #include "host-bmc/dbus/custom_dbus.hpp"
 
-#include <sys/mman.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <sys/un.h>
@@ -16,17 +15,13 @@
 #include <exception>
 #include <fstream>
 #include <iostream>
-#include <mutex>
+#include <optional>
 
 namespace pldm
 {
 using namespace pldm::dbus;
 namespace responder
 {
-
-std::atomic<SocketWriteStatus> socketWriteStatus = Free;
-std::mutex lockMutex;
-
 namespace utils
 {
 static constexpr auto curLicFilePath =
@@ -120,77 +115,6 @@ int setupUnixSocket(const std::string& socketInterface)
     return fd;
 }
 
-void writeToUnixSocket(const int sock, const char* buf,
-                       const uint64_t blockSize)
-{
-
-    const std::lock_guard<std::mutex> lock(lockMutex);
-    if (socketWriteStatus == Error)
-    {
-        return;
-    }
-    socketWriteStatus = InProgress;
-    uint64_t i;
-    int nwrite = 0;
-
-    for (i = 0; i < blockSize; i = i + nwrite)
-    {
-
-        fd_set wfd;
-        struct timeval tv;
-        tv.tv_sec = 1;
-        tv.tv_usec = 0;
-
-        FD_ZERO(&wfd);
-        FD_SET(sock, &wfd);
-        int nfd = sock + 1;
-
-        int retval = select(nfd, NULL, &wfd, NULL, &tv);
-        if (retval < 0)
-        {
-            std::cerr << "writeToUnixSocket: select call failed " << errno
-                      << std::endl;
-            close(sock);
-            socketWriteStatus = Error;
-            return;
-        }
-        if (retval == 0)
-        {
-            nwrite = 0;
-            continue;
-        }
-        if ((retval > 0) && (FD_ISSET(sock, &wfd)))
-        {
-            nwrite = write(sock, buf + i, blockSize - i);
-
-            if (nwrite < 0)
-            {
-                if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
-                {
-                    std::cerr << "writeToUnixSocket: Write call failed with "
-                                 "EAGAIN or EWOULDBLOCK or EINTR"
-                              << std::endl;
-                    nwrite = 0;
-                    continue;
-                }
-                std::cerr << "writeToUnixSocket: Failed to write " << errno
-                          << std::endl;
-                close(sock);
-                socketWriteStatus = Error;
-                return;
-            }
-        }
-        else
-        {
-            nwrite = 0;
-        }
-    }
-
-    munmap((void*)buf, blockSize);
-    socketWriteStatus = Completed;
-    return;
-}
-
 Json convertBinFileToJson(const fs::path& path)
 {
     std::ifstream file(path, std::ios::in | std::ios::binary);
@@ -455,7 +379,19 @@ void findPortObjects(const std::string& cardObjPath,
     }
 }
 
-bool checkFruPresence(const char* objPath)
+namespace
+{
+
+constexpr auto presentInterface = "xyz.openbmc_project.Inventory.Item";
+constexpr auto presentProperty = "Present";
+
+/** @brief Get the object whose presence tells the presence of a fru
+ *
+ *  @param[in] objPath - the fru object path
+ *
+ *  @return the object path, std::nullopt if the fru is always present
+ */
+std::optional<std::string> getPresenceObjPath(const char* objPath)
 {
     // if we enter here with port or nvme objects then we need to find the
     // parent and see if the pcie card or the drive bp is present. if so then
@@ -465,7 +401,6 @@ bool checkFruPresence(const char* objPath)
     std::string pcieAdapter("pcie_card");
     std::string portStr("cxp_");
     std::string newObjPath = objPath;
-    bool isPresent = true;
     /*if (newObjPath.find(nvme) != std::string::npos)
     {
         return true;
@@ -474,7 +409,7 @@ bool checkFruPresence(const char* objPath)
     if ((newObjPath.find(pcieAdapter) != std::string::npos) &&
         !checkIfIBMCableCard(newObjPath))
     {
-        return true; // industry std cards
+        return std::nullopt; // industry std cards
     }
     else if (newObjPath.find(portStr) != std::string::npos ||
              newObjPath.find(nvme) != std::string::npos)
@@ -484,14 +419,24 @@ bool checkFruPresence(const char* objPath)
 
     // Phyp expects the FRU records for industry std cards to be always
     // built, irrespective of presence
+    return newObjPath;
+}
+
+} // namespace
+
+bool checkFruPresence(const char* objPath)
+{
+    auto presenceObjPath = getPresenceObjPath(objPath);
+    if (!presenceObjPath)
+    {
+        return true;
+    }
 
-    static constexpr auto presentInterface =
-        "xyz.openbmc_project.Inventory.Item";
-    static constexpr auto presentProperty = "Present";
+    bool isPresent = true;
     try
     {
         auto propVal = pldm::utils::DBusHandler().getDbusPropertyVariant(
-            newObjPath.c_str(), presentProperty, presentInterface);
+            presenceObjPath->c_str(), presentProperty, presentInterface);
         isPresent = std::get<bool>(propVal);
     }
     catch (const sdbusplus::exception::SdBusError& e)
@@ -499,6 +444,33 @@ bool checkFruPresence(const char* objPath)
     return isPresent;
 }
 
+void checkFruPresenceAsync(const char* objPath,
+                           std::function<void(bool)>&& callback)
+{
+    auto presenceObjPath = getPresenceObjPath(objPath);
+    if (!presenceObjPath)
+    {
+        callback(true);
+        return;
+    }
+
+    try
+    {
+        pldm::utils::DBusHandler().getDbusPropertyVariantAsync(
+            presenceObjPath->c_str(), presentProperty, presentInterface,
+            [callback](std::optional<pldm::utils::PropertyValue> propVal) {
+                // Present unless the property says otherwise, as with
+                // checkFruPresence
+                callback(!propVal || !std::holds_alternative<bool>(*propVal) ||
+                         std::get<bool>(*propVal));
+            });
+    }
+    catch (const std::exception& e)
+    {
+        callback(true);
+    }
+}
+
 std::pair<std::string, std::string>
     getSlotAndAdapter(const std::string& portLocationCode)
 {
@@ -5,6 +5,7 @@
 #include <nlohmann/json.hpp>
 
 #include <filesystem>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -12,15 +13,6 @@ namespace pldm
 {
 namespace responder
 {
-
-enum SocketWriteStatus
-{
-    Completed,
-    InProgress,
-    Free,
-    Error,
-    NotReady
-};
 namespace utils
 {
 namespace fs = std::filesystem;
@@ -37,21 +29,6 @@ using Json = nlohmann::json;
  */
 int setupUnixSocket(const std::string& socketInterface);
 
-/** @brief Write data on UNIX socket
- *  This function writes given data to a non-blocking socket.
- *  Irrespective of block size, this function make sure of writing given data
- *  on unix socket.
- *
- *  @param[in] sock - unix socket
- *  @param[in] buf -  data buffer
- *  @param[in] blockSize - size of data to write
- *  @return   on success retruns  0
- *            on failure returns -1
-
- */
-void writeToUnixSocket(const int sock, const char* buf,
-                       const uint64_t blockSize);
-
 /** @brief Converts a binary file to json data
  *  This function converts bson data stored in a binary file to
  *  nlohmann json data
@@ -118,6 +95,13 @@ bool checkIfIBMCableCard(const std::string& objPath);
  */
 bool checkFruPresence(const char* objPath);
 
+/** @brief checks whether the fru is actually present without blocking
+ *  @param[in] objPath - the fru object path
+ *  @param[in] callback - invoked with the presence of the fru
+ */
+void checkFruPresenceAsync(const char* objPath,
+                           std::function<void(bool)>&& callback);
+
 /** @brief finds the ports under an adapter
  *  @param[in] cardObjPath - D-Bus object path for the adapter
  *  @param[out] portObjects - the ports under the adapter
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "libpldmresponder/dma_session.hpp"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <filesystem>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace pldm
+{
+namespace responder
+{
+namespace dma
+{
+
+/** @brief Create an empty temporary file
+ *
+ *  @param[in] size - size of the file
+ *
+ *  @return path of the file
+ */
+inline std::string makeTempFile(size_t size)
+{
+    char path[] = "/tmp/pldm_fake_xdma.XXXXXX";
+    int fd = mkstemp(path);
+    if (fd >= 0)
+    {
+        if (ftruncate(fd, size) < 0)
+        {
+            std::filesystem::remove(path);
+        }
+        close(fd);
+    }
+    return path;
+}
+
+/** @class FakeXdmaSession
+ *
+ *  XDMA session backed by files instead of the XDMA engine: the VGA memory
+ *  windows are mappings of a regular file, and the host memory is a second
+ *  file the DMA operations copy to and from, at the DMA address as offset.
+ */
+class FakeXdmaSession : public Session
+{
+  public:
+    /** @brief Constructor
+     *
+     *  @param[in] windowSize - size of the VGA memory windows
+     *  @param[in] hostMemorySize - size of the host memory
+     *  @param[in] windows - number of windows to map
+     */
+    FakeXdmaSession(size_t windowSize, size_t hostMemorySize,
+                    size_t windows = maxWindows) :
+        Session(makeTempFile(maxWindows * (windowSize + getpagesize())),
+                windowSize, windows),
+        hostMemory(makeTempFile(hostMemorySize))
+    {
+        hostFd = ::open(hostMemory.c_str(), O_RDWR);
+    }
+
+    ~FakeXdmaSession()
+    {
+        Session::close();
+        ::close(hostFd);
+        std::filesystem::remove(device);
+        std::filesystem::remove(hostMemory);
+    }
+
+    /** @brief Write to the host memory */
+    void writeHost(uint64_t address, const std::vector<char>& data)
+    {
+        EXPECT_EQ(pwrite(hostFd, data.data(), data.size(), address),
+                  static_cast<ssize_t>(data.size()));
+    }
+
+    /** @brief Read from the host memory */
+    std::vector<char> readHost(uint64_t address, size_t length)
+    {
+        std::vector<char> data(length);
+        EXPECT_EQ(pread(hostFd, data.data(), length, address),
+                  static_cast<ssize_t>(length));
+        return data;
+    }
+
+    size_t ops = 0; //!< number of DMA operations submitted
+
+  protected:
+    off_t windowOffset(const Client& client) const override
+    {
+        return (&client - clients.data()) * mappedSize;
+    }
+
+    int submit(Client& client, const AspeedXdmaOp& op) override
+    {
+        ++ops;
+
+        // The window file and its shared mappings go through the same page
+        // cache pages, so the copy is visible through window()
+        std::vector<char> data(op.len);
+        auto window = windowOffset(client);
+        auto [from, fromOffset, to, toOffset] =
+            op.upstream
+                ? std::tuple(client.fd, window, hostFd, off_t(op.hostAddr))
+                : std::tuple(hostFd, off_t(op.hostAddr), client.fd, window);
+        if (pread(from, data.data(), op.len, fromOffset) < 0 ||
+            pwrite(to, data.data(), op.len, toOffset) < 0)
+        {
+            return -errno;
+        }
+        return 0;
+    }
+
+  private:
+    std::string hostMemory;
+    int hostFd = -1;
+};
+
+} // namespace dma
+} // namespace responder
+} // namespace pldm
@@ -0,0 +1,158 @@
+#include "libpldm/base.h"
+#include "libpldm/file_io.h"
+
+#include "fake_xdma.hpp"
+#include "libpldmresponder/file_io.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+using namespace pldm::responder;
+using namespace pldm::responder::dma;
+
+namespace
+{
+
+/** @brief Data with a pattern that differs between DMA chunks */
+std::vector<char> pattern(size_t length)
+{
+    std::vector<char> data(length);
+    for (size_t i = 0; i < length; ++i)
+    {
+        data[i] = static_cast<char>((i * 7 + i / maxSize) & 0xFF);
+    }
+    return data;
+}
+
+std::vector<char> readFile(const fs::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(file), {});
+}
+
+} // namespace
+
+TEST(DmaSession, windowMappedOnce)
+{
+    FakeXdmaSession session(maxSize, 2 * maxSize);
+    EXPECT_EQ(session.window(), nullptr);
+    EXPECT_GE(session.windowSize(), maxSize);
+
+    EXPECT_EQ(session.transfer(0, maxSize, false), 0);
+    auto window = session.window();
+    ASSERT_NE(window, nullptr);
+    EXPECT_EQ(session.transfer(maxSize, 16, true), 0);
+    EXPECT_EQ(session.transfer(0, maxSize, false), 0);
+    EXPECT_EQ(session.window(), window);
+    EXPECT_EQ(session.ops, 3);
+}
+
+TEST(DmaSession, badTransfers)
+{
+    Session noDevice("/tmp/pldm_no_xdma_device/xdma");
+    EXPECT_EQ(noDevice.transfer(0, 16, true), -ENOENT);
+    EXPECT_EQ(noDevice.window(), nullptr);
+
+    FakeXdmaSession session(maxSize, maxSize);
+    EXPECT_EQ(session.transfer(0, session.windowSize() + 16, true), -EINVAL);
+    EXPECT_EQ(session.ops, 0);
+}
+
+TEST(DmaSession, windowsMapped)
+{
+    FakeXdmaSession session(maxSize, maxSize);
+    EXPECT_EQ(session.open(), 0);
+    EXPECT_EQ(session.windows(), maxWindows);
+    EXPECT_NE(session.window(0), session.window(1));
+
+    FakeXdmaSession single(maxSize, maxSize, 1);
+    EXPECT_EQ(single.open(), 0);
+    EXPECT_EQ(single.windows(), 1);
+}
+
+TEST(DmaSession, transferAllFromHost)
+{
+    const uint32_t length = 2 * maxSize + 4096;
+    const uint64_t address = 4096;
+    auto data = pattern(length);
+
+    for (size_t windows = 1; windows <= maxWindows; ++windows)
+    {
+        FakeXdmaSession session(maxSize, address + length, windows);
+        session.writeHost(address, data);
+
+        char tmpFile[] = "/tmp/pldm_dma_session.XXXXXX";
+        close(mkstemp(tmpFile));
+        fs::path path(tmpFile);
+
+        DMA intf(session);
+        auto response =
+            transferAll<DMA>(&intf, PLDM_WRITE_FILE_FROM_MEMORY, path, 0,
+                             length, address, false, 0);
+        auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+        EXPECT_EQ(responsePtr->payload[0], PLDM_SUCCESS);
+        EXPECT_EQ(session.ops, 3);
+        EXPECT_TRUE(readFile(path) == data);
+        fs::remove(path);
+    }
+}
+
+TEST(DmaSession, transferAllToHost)
+{
+    const uint32_t length = 2 * maxSize + 4096;
+    const uint32_t offset = 16;
+    auto data = pattern(offset + length);
+
+    char tmpFile[] = "/tmp/pldm_dma_session.XXXXXX";
+    close(mkstemp(tmpFile));
+    fs::path path(tmpFile);
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(data.data(), data.size());
+    }
+
+    for (size_t windows = 1; windows <= maxWindows; ++windows)
+    {
+        FakeXdmaSession session(maxSize, length, windows);
+        DMA intf(session);
+        auto response = transferAll<DMA>(&intf, PLDM_READ_FILE_INTO_MEMORY,
+                                         path, offset, length, 0, true, 0);
+        auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+        EXPECT_EQ(responsePtr->payload[0], PLDM_SUCCESS);
+        EXPECT_EQ(session.ops, 3);
+        EXPECT_TRUE(session.readHost(0, length) ==
+                    std::vector<char>(data.begin() + offset, data.end()));
+    }
+    fs::remove(path);
+}
+
+TEST(DmaSession, transferAllShortFile)
+{
+    const uint32_t length = 2 * maxSize;
+    auto data = pattern(maxSize + 16);
+
+    char tmpFile[] = "/tmp/pldm_dma_session.XXXXXX";
+    close(mkstemp(tmpFile));
+    fs::path path(tmpFile);
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(data.data(), data.size());
+    }
+
+    FakeXdmaSession session(maxSize, length);
+    DMA intf(session);
+    auto response = transferAll<DMA>(&intf, PLDM_READ_FILE_INTO_MEMORY, path,
+                                     0, length, 0, true, 0);
+    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+    EXPECT_EQ(responsePtr->payload[0], PLDM_ERROR);
+    fs::remove(path);
+}
@@ -0,0 +1,143 @@
+#include "libpldmresponder/dump_offload.hpp"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <sdeventplus/event.hpp>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::responder::dump;
+
+class DumpOffloadTest : public testing::Test
+{
+  protected:
+    DumpOffloadTest() : event(sdeventplus::Event::get_default())
+    {}
+
+    /** @brief Connect an offload client
+     *
+     *  @param[out] sock - socket of the writer
+     *
+     *  @return socket of the client
+     */
+    int connect(int& sock)
+    {
+        int fds[2] = {-1, -1};
+        EXPECT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+        sock = fds[0];
+        clients.push_back(fds[1]);
+        return fds[1];
+    }
+
+    ~DumpOffloadTest()
+    {
+        for (auto client : clients)
+        {
+            close(client);
+        }
+    }
+
+    /** @brief Read what an offload client receives, the event loop writes to
+     *         the socket whenever it has no data
+     *
+     *  @param[in] client - socket of the client
+     *  @param[in] length - length of the data to read
+     *
+     *  @return the data read
+     */
+    std::vector<char> receive(int client, size_t length)
+    {
+        std::vector<char> data(length);
+        size_t count = 0;
+        while (count < length)
+        {
+            auto rc = recv(client, data.data() + count, length - count,
+                           MSG_DONTWAIT);
+            if (rc > 0)
+            {
+                count += rc;
+            }
+            else if (rc == 0 || sd_event_run(event.get(), 100000) <= 0)
+            {
+                break;
+            }
+        }
+        data.resize(count);
+        return data;
+    }
+
+    /** @brief Data with a pattern of its own for every offload */
+    static std::vector<char> pattern(size_t length, char seed)
+    {
+        std::vector<char> data(length);
+        for (size_t i = 0; i < length; ++i)
+        {
+            data[i] = static_cast<char>(i * 13 + i / 4096 + seed);
+        }
+        return data;
+    }
+
+    sdeventplus::Event event;
+    std::vector<int> clients;
+};
+
+TEST_F(DumpOffloadTest, writesFromEventLoop)
+{
+    int sock = -1;
+    auto client = connect(sock);
+    OffloadWriter writer(event, sock);
+
+    // Larger than the socket buffers, the rest is written from the event loop
+    auto data = pattern(4 * 1024 * 1024, 1);
+    const size_t chunkSize = 1024 * 1024;
+    for (size_t offset = 0; offset < data.size(); offset += chunkSize)
+    {
+        EXPECT_EQ(writer.write(data.data() + offset, chunkSize), 0);
+    }
+    EXPECT_FALSE(writer.drained());
+
+    EXPECT_TRUE(receive(client, data.size()) == data);
+    EXPECT_TRUE(writer.drained());
+    EXPECT_EQ(writer.error(), 0);
+}
+
+TEST_F(DumpOffloadTest, concurrentOffloads)
+{
+    int sock1 = -1;
+    int sock2 = -1;
+    auto client1 = connect(sock1);
+    auto client2 = connect(sock2);
+    OffloadWriter writer1(event, sock1);
+    OffloadWriter writer2(event, sock2);
+
+    auto data1 = pattern(2 * 1024 * 1024, 1);
+    auto data2 = pattern(2 * 1024 * 1024, 2);
+    EXPECT_EQ(writer1.write(data1.data(), data1.size()), 0);
+    EXPECT_EQ(writer2.write(data2.data(), data2.size()), 0);
+    EXPECT_FALSE(writer1.drained());
+    EXPECT_FALSE(writer2.drained());
+
+    // Neither offload waits for the other to drain
+    EXPECT_TRUE(receive(client2, data2.size()) == data2);
+    EXPECT_TRUE(writer2.drained());
+    EXPECT_TRUE(receive(client1, data1.size()) == data1);
+    EXPECT_TRUE(writer1.drained());
+}
+
+TEST_F(DumpOffloadTest, notReadyWhileQueued)
+{
+    int sock = -1;
+    auto client = connect(sock);
+    OffloadWriter writer(event, sock, 64 * 1024);
+    EXPECT_TRUE(writer.ready());
+
+    auto data = pattern(1024 * 1024, 3);
+    EXPECT_EQ(writer.write(data.data(), data.size()), 0);
+    EXPECT_FALSE(writer.ready());
+
+    EXPECT_TRUE(receive(client, data.size()) == data);
+    EXPECT_TRUE(writer.ready());
+}
@@ -0,0 +1,75 @@
+#include "dbus_impl_metrics.hpp"
+
+#include "common/metrics.hpp"
+
+#include <sdbusplus/message.hpp>
+
+#include <iostream>
+
+namespace pldm
+{
+namespace dbus_api
+{
+
+std::string Metrics::getMetrics() const
+{
+    return pldm::metrics::Metrics::GetInstance().toJson().dump();
+}
+
+void Metrics::reset()
+{
+    pldm::metrics::Metrics::GetInstance().reset();
+}
+
+int Metrics::callbackGetMetrics(sd_bus_message* msg, void* context,
+                                sd_bus_error* error)
+{
+    try
+    {
+        auto m = sdbusplus::message::message(msg);
+        auto o = static_cast<Metrics*>(context);
+
+        auto reply = m.new_method_return();
+        reply.append(o->getMetrics());
+        reply.method_return();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Failed to reply to GetMetrics, ERROR=" << e.what()
+                  << "\n";
+        return sd_bus_error_set(error, SD_BUS_ERROR_FAILED, e.what());
+    }
+
+    return 1;
+}
+
+int Metrics::callbackReset(sd_bus_message* msg, void* context,
+                           sd_bus_error* error)
+{
+    try
+    {
+        auto m = sdbusplus::message::message(msg);
+        auto o = static_cast<Metrics*>(context);
+
+        o->reset();
+        auto reply = m.new_method_return();
+        reply.method_return();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Failed to reply to Reset, ERROR=" << e.what() << "\n";
+        return sd_bus_error_set(error, SD_BUS_ERROR_FAILED, e.what());
+    }
+
+    return 1;
+}
+
+const sdbusplus::vtable::vtable_t Metrics::vtable[] = {
+    sdbusplus::vtable::start(),
+    sdbusplus::vtable::method("GetMetrics", "", "s",
+                              Metrics::callbackGetMetrics),
+    sdbusplus::vtable::method("Reset", "", "", Metrics::callbackReset),
+    sdbusplus::vtable::end()};
+
+} // namespace dbus_api
+} // namespace pldm
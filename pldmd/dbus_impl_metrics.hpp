@@ -0,0 +1,62 @@
+#pragma once
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/vtable.hpp>
+
+#include <string>
+
+namespace pldm
+{
+namespace dbus_api
+{
+
+/** @brief D-Bus interface of the pldmd metrics */
+constexpr auto metricsInterface = "xyz.openbmc_project.PLDM.Metrics";
+
+/** @class Metrics
+ *  @brief Exposes the metrics registry of pldmd
+ *  @details Implements the xyz.openbmc_project.PLDM.Metrics D-Bus interface:
+ *  GetMetrics returns the per command counters and latency histograms and the
+ *  request queue depths as a JSON string, Reset clears them.
+ */
+class Metrics
+{
+  public:
+    Metrics() = delete;
+    Metrics(const Metrics&) = delete;
+    Metrics& operator=(const Metrics&) = delete;
+    Metrics(Metrics&&) = delete;
+    Metrics& operator=(Metrics&&) = delete;
+    virtual ~Metrics() = default;
+
+    /** @brief Constructor to put object onto bus at a dbus path.
+     *  @param[in] bus - Bus to attach to.
+     *  @param[in] path - Path to attach at.
+     */
+    Metrics(sdbusplus::bus::bus& bus, const std::string& path) :
+        serverInterface(bus, path.c_str(), metricsInterface, vtable, this)
+    {}
+
+    /** @brief Implementation for GetMetrics */
+    std::string getMetrics() const;
+
+    /** @brief Implementation for Reset */
+    void reset();
+
+  private:
+    /** @brief sd-bus callback for GetMetrics */
+    static int callbackGetMetrics(sd_bus_message* msg, void* context,
+                                  sd_bus_error* error);
+
+    /** @brief sd-bus callback for Reset */
+    static int callbackReset(sd_bus_message* msg, void* context,
+                             sd_bus_error* error);
+
+    static const sdbusplus::vtable::vtable_t vtable[];
+
+    sdbusplus::server::interface::interface serverInterface;
+};
+
+} // namespace dbus_api
+} // namespace pldm
@@ -0,0 +1,53 @@
+#include "dbus_impl_rtt.hpp"
+
+#include <sdbusplus/message.hpp>
+
+#include <iostream>
+
+namespace pldm
+{
+namespace dbus_api
+{
+
+RttEstimates RoundTripTime::getEstimates() const
+{
+    RttEstimates estimates;
+    for (const auto& [eid, estimate] : estimator.get())
+    {
+        estimates.emplace(eid, std::make_tuple(estimate.srtt.count(),
+                                               estimate.rttvar.count(),
+                                               estimate.rto.count()));
+    }
+    return estimates;
+}
+
+int RoundTripTime::callbackGetEstimates(sd_bus_message* msg, void* context,
+                                        sd_bus_error* error)
+{
+    try
+    {
+        auto m = sdbusplus::message::message(msg);
+        auto o = static_cast<RoundTripTime*>(context);
+
+        auto reply = m.new_method_return();
+        reply.append(o->getEstimates());
+        reply.method_return();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Failed to reply to GetEstimates, ERROR=" << e.what()
+                  << "\n";
+        return sd_bus_error_set(error, SD_BUS_ERROR_FAILED, e.what());
+    }
+
+    return 1;
+}
+
+const sdbusplus::vtable::vtable_t RoundTripTime::vtable[] = {
+    sdbusplus::vtable::start(),
+    sdbusplus::vtable::method("GetEstimates", "", "a{y(ttt)}",
+                              RoundTripTime::callbackGetEstimates),
+    sdbusplus::vtable::end()};
+
+} // namespace dbus_api
+} // namespace pldm
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "requester/rtt_estimator.hpp"
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/vtable.hpp>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <tuple>
+
+namespace pldm
+{
+namespace dbus_api
+{
+
+/** @brief D-Bus interface of the round trip time estimates */
+constexpr auto rttInterface = "xyz.openbmc_project.PLDM.RoundTripTime";
+
+/** @brief Smoothed round trip time, round trip time variation and retry
+ *         timeout in microseconds, per MCTP endpoint
+ */
+using RttEstimates =
+    std::map<uint8_t, std::tuple<uint64_t, uint64_t, uint64_t>>;
+
+/** @class RoundTripTime
+ *  @brief Exposes the round trip time estimates of the PLDM requester
+ *  @details Implements the GetEstimates method of the
+ *  xyz.openbmc_project.PLDM.RoundTripTime D-Bus interface, which returns
+ *  a{y(ttt)}, the estimates keyed by the MCTP endpoint ID.
+ */
+class RoundTripTime
+{
+  public:
+    RoundTripTime() = delete;
+    RoundTripTime(const RoundTripTime&) = delete;
+    RoundTripTime& operator=(const RoundTripTime&) = delete;
+    RoundTripTime(RoundTripTime&&) = delete;
+    RoundTripTime& operator=(RoundTripTime&&) = delete;
+    virtual ~RoundTripTime() = default;
+
+    /** @brief Constructor to put object onto bus at a dbus path.
+     *  @param[in] bus - Bus to attach to.
+     *  @param[in] path - Path to attach at.
+     *  @param[in] estimator - round trip time estimates of the requester
+     */
+    RoundTripTime(sdbusplus::bus::bus& bus, const std::string& path,
+                  const requester::RttEstimator& estimator) :
+        estimator(estimator),
+        serverInterface(bus, path.c_str(), rttInterface, vtable, this)
+    {}
+
+    /** @brief Implementation for GetEstimates */
+    RttEstimates getEstimates() const;
+
+  private:
+    /** @brief round trip time estimates of the requester */
+    const requester::RttEstimator& estimator;
+
+    /** @brief sd-bus callback for GetEstimates */
+    static int callbackGetEstimates(sd_bus_message* msg, void* context,
+                                    sd_bus_error* error);
+
+    static const sdbusplus::vtable::vtable_t vtable[];
+
+    sdbusplus::server::interface::interface serverInterface;
+};
+
+} // namespace dbus_api
+} // namespace pldm
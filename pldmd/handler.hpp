@@ -2,8 +2,10 @@
 
 #include "libpldm/base.h"
 
+#include <array>
 #include <cassert>
 #include <functional>
+#include <limits>
 #include <map>
 #include <vector>
 
@@ -20,6 +22,51 @@ class CmdHandler;
 using HandlerFunc =
     std::function<Response(const pldm_msg* request, size_t reqMsgLen)>;
 
+/** @class CommandTable
+ *
+ *  Table of the handlers of the commands of a PLDM type, indexed by command
+ *  code so that dispatching a command is a single array access.
+ */
+class CommandTable
+{
+  public:
+    /** @brief Register the handler of a command, if it has none already
+     *
+     *  @param[in] pldmCommand - PLDM command code
+     *  @param[in] handler - handler of the command
+     */
+    void emplace(Command pldmCommand, HandlerFunc handler)
+    {
+        if (!table[pldmCommand])
+        {
+            table[pldmCommand] = std::move(handler);
+        }
+    }
+
+    /** @brief Check if a command has a handler
+     *
+     *  @param[in] pldmCommand - PLDM command code
+     *  @return true if the command is supported
+     */
+    bool contains(Command pldmCommand) const
+    {
+        return static_cast<bool>(table[pldmCommand]);
+    }
+
+    /** @brief Get the handler of a command
+     *
+     *  @param[in] pldmCommand - PLDM command code
+     *  @return handler of the command, empty if the command is not supported
+     */
+    const HandlerFunc& operator[](Command pldmCommand) const
+    {
+        return table[pldmCommand];
+    }
+
+  private:
+    std::array<HandlerFunc, std::numeric_limits<Command>::max() + 1> table;
+};
+
 class CmdHandler
 {
   public:
@@ -28,12 +75,18 @@ class CmdHandler
      *  @param[in] pldmCommand - PLDM command code
      *  @param[in] request - PLDM request message
      *  @param[in] reqMsgLen - PLDM request message size
-     *  @return PLDM response message
+     *  @return PLDM response message, with the ERROR_UNSUPPORTED_PLDM_CMD
+     *          completion code if the command has no handler
      */
     Response handle(Command pldmCommand, const pldm_msg* request,
                     size_t reqMsgLen)
     {
-        return handlers.at(pldmCommand)(request, reqMsgLen);
+        const auto& handler = handlers[pldmCommand];
+        if (!handler)
+        {
+            return ccOnlyResponse(request, PLDM_ERROR_UNSUPPORTED_PLDM_CMD);
+        }
+        return handler(request, reqMsgLen);
     }
 
     /** @brief Create a response message containing only cc
@@ -54,10 +107,10 @@ class CmdHandler
     }
 
   protected:
-    /** @brief map of PLDM command code to handler - to be populated by derived
-     *         classes.
+    /** @brief table of PLDM command code to handler - to be populated by
+     *         derived classes.
      */
-    std::map<Command, HandlerFunc> handlers;
+    CommandTable handlers;
 };
 
 } // namespace responder
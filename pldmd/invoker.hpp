@@ -4,6 +4,8 @@
 
 #include "handler.hpp"
 
+#include <array>
+#include <limits>
 #include <map>
 #include <memory>
 
@@ -25,7 +27,10 @@ class Invoker
      */
     void registerHandler(Type pldmType, std::unique_ptr<CmdHandler> handler)
     {
-        handlers.emplace(pldmType, std::move(handler));
+        if (!handlers[pldmType])
+        {
+            handlers[pldmType] = std::move(handler);
+        }
     }
 
     /** @brief Invoke a PLDM command handler
@@ -34,16 +39,26 @@ class Invoker
      *  @param[in] pldmCommand - PLDM command code
      *  @param[in] request - PLDM request message
      *  @param[in] reqMsgLen - PLDM request message size
-     *  @return PLDM response message
+     *  @return PLDM response message, with the ERROR_UNSUPPORTED_PLDM_CMD
+     *          completion code if the type or the command has no handler
      */
     Response handle(Type pldmType, Command pldmCommand, const pldm_msg* request,
                     size_t reqMsgLen)
     {
-        return handlers.at(pldmType)->handle(pldmCommand, request, reqMsgLen);
+        const auto& handler = handlers[pldmType];
+        if (!handler)
+        {
+            return CmdHandler::ccOnlyResponse(request,
+                                              PLDM_ERROR_UNSUPPORTED_PLDM_CMD);
+        }
+        return handler->handle(pldmCommand, request, reqMsgLen);
     }
 
   private:
-    std::map<Type, std::unique_ptr<CmdHandler>> handlers;
+    /** @brief table of PLDM type code to handler */
+    std::array<std::unique_ptr<CmdHandler>,
+               std::numeric_limits<Type>::max() + 1>
+        handlers;
 };
 
 } // namespace responder
@@ -3,9 +3,14 @@
 #include "libpldm/pdr.h"
 #include "libpldm/platform.h"
 
+#include "common/deferred_response.hpp"
 #include "common/flight_recorder.hpp"
+#include "common/metrics.hpp"
+#include "common/tx_batch.hpp"
 #include "common/utils.hpp"
+#include "dbus_impl_metrics.hpp"
 #include "dbus_impl_requester.hpp"
+#include "dbus_impl_rtt.hpp"
 #include "host-bmc/dbus/deserialize.hpp"
 #include "invoker.hpp"
 #include "requester/handler.hpp"
@@ -25,6 +30,7 @@
 #include <sdeventplus/source/signal.hpp>
 #include <stdplus/signal.hpp>
 
+#include <chrono>
 #include <cstdio>
 #include <cstring>
 #include <fstream>
@@ -40,6 +46,7 @@
 
 #ifdef LIBPLDMRESPONDER
 #include "dbus_impl_pdr.hpp"
+#include "host-bmc/dbus/serialize.hpp"
 #include "host-bmc/dbus_to_event_handler.hpp"
 #include "host-bmc/dbus_to_host_effecters.hpp"
 #include "host-bmc/host_associations_parser.hpp"
@@ -64,6 +71,11 @@
 
 constexpr uint8_t MCTP_MSG_TYPE_PLDM = 1;
 
+/** @brief Size of a receive buffer, the largest message the MCTP demux daemon
+ *         reassembles, with the EID and message type bytes it prefixes
+ */
+constexpr size_t MCTP_RX_BUFFER_SIZE = 64 * 1024 + 2;
+
 using namespace pldm;
 using namespace sdeventplus;
 using namespace sdeventplus::source;
@@ -71,6 +83,8 @@ using namespace pldm::responder;
 using namespace pldm::utils;
 using sdeventplus::source::Signal;
 using namespace pldm::flightrecorder;
+using namespace pldm::txbatch;
+using namespace pldm::deferred;
 
 void interruptFlightRecorderCallBack(Signal& /*signal*/,
                                      const struct signalfd_siginfo*)
@@ -79,19 +93,25 @@ void interruptFlightRecorderCallBack(Signal& /*signal*/,
 
     // obtain the flight recorder instance and dump the recorder
     FlightRecorder::GetInstance().playRecorder();
+
+    auto [hits, misses] = DBusHandler::getServiceCacheStats();
+    std::cerr << "D-Bus service name cache hits= " << hits
+              << " misses= " << misses << "\n";
 }
 
 static std::optional<Response>
-    processRxMsg(const std::vector<uint8_t>& requestMsg, Invoker& invoker,
+    processRxMsg(int fd, const uint8_t* requestMsg, size_t requestMsgLen,
+                 Invoker& invoker,
                  requester::Handler<requester::Request>& handler)
 {
     using type = uint8_t;
     uint8_t eid = requestMsg[0];
 
     pldm_header_info hdrFields{};
-    auto hdr = reinterpret_cast<const pldm_msg_hdr*>(
-        requestMsg.data() + sizeof(eid) + sizeof(type));
-    if (PLDM_SUCCESS != unpack_pldm_header(hdr, &hdrFields))
+    auto hdr = reinterpret_cast<const pldm_msg_hdr*>(requestMsg + sizeof(eid) +
+                                                     sizeof(type));
+    if (requestMsgLen < sizeof(eid) + sizeof(type) + sizeof(pldm_msg_hdr) ||
+        PLDM_SUCCESS != unpack_pldm_header(hdr, &hdrFields))
     {
         std::cerr << "Empty PLDM request header \n";
         return std::nullopt;
@@ -101,8 +121,11 @@ static std::optional<Response>
     {
         Response response;
         auto request = reinterpret_cast<const pldm_msg*>(hdr);
-        size_t requestLen = requestMsg.size() - sizeof(struct pldm_msg_hdr) -
+        size_t requestLen = requestMsgLen - sizeof(struct pldm_msg_hdr) -
                             sizeof(eid) - sizeof(type);
+        auto startTime = std::chrono::steady_clock::now();
+        auto& deferredResponse = DeferredResponse::GetInstance();
+        deferredResponse.begin(fd, eid, hdrFields);
         try
         {
             response = invoker.handle(hdrFields.pldm_type, hdrFields.command,
@@ -110,6 +133,8 @@ static std::optional<Response>
         }
         catch (const std::out_of_range& e)
         {
+            // Unsupported commands get their response from the invoker, this
+            // only covers handlers failing a lookup of their own
             uint8_t completion_code = PLDM_ERROR_UNSUPPORTED_PLDM_CMD;
             response.resize(sizeof(pldm_msg_hdr));
             auto responseHdr = reinterpret_cast<pldm_msg_hdr*>(response.data());
@@ -121,16 +146,30 @@ static std::optional<Response>
             if (PLDM_SUCCESS != pack_pldm_header(&header, responseHdr))
             {
                 std::cerr << "Failed adding response header \n";
+                deferredResponse.end();
                 return std::nullopt;
             }
             response.insert(response.end(), completion_code);
         }
+        if (deferredResponse.end())
+        {
+            // The handler sends the response once it is ready
+            return std::nullopt;
+        }
+        if (response.size() > sizeof(pldm_msg_hdr))
+        {
+            pldm::metrics::Metrics::GetInstance().handled(
+                hdrFields.pldm_type, hdrFields.command,
+                response[sizeof(pldm_msg_hdr)],
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - startTime));
+        }
         return response;
     }
     else if (PLDM_RESPONSE == hdrFields.msg_type)
     {
         auto response = reinterpret_cast<const pldm_msg*>(hdr);
-        size_t responseLen = requestMsg.size() - sizeof(struct pldm_msg_hdr) -
+        size_t responseLen = requestMsgLen - sizeof(struct pldm_msg_hdr) -
                              sizeof(eid) - sizeof(type);
         handler.handleResponse(eid, hdrFields.instance, hdrFields.pldm_type,
                                hdrFields.command, response, responseLen);
@@ -214,6 +253,9 @@ int main(int argc, char** argv)
     Invoker invoker{};
     requester::Handler<requester::Request> reqHandler(
         sockfd, event, dbusImplReq, currentSendbuffSize, verbose);
+    dbus_api::RoundTripTime dbusImplRtt(bus, "/xyz/openbmc_project/pldm",
+                                        reqHandler.getRttEstimator());
+    dbus_api::Metrics dbusImplMetrics(bus, "/xyz/openbmc_project/pldm/metrics");
 
 #ifdef LIBPLDMRESPONDER
     using namespace pldm::state_sensor;
@@ -236,9 +278,11 @@ int main(int argc, char** argv)
     std::unique_ptr<DbusToPLDMEvent> dbusToPLDMEventHandler;
     DBusHandler dbusHandler;
     auto hostEID = pldm::utils::readHostEID();
-    invoker.registerHandler(
-        PLDM_BIOS, std::make_unique<bios::Handler>(sockfd, hostEID,
-                                                   &dbusImplReq, &reqHandler));
+    auto biosHandler = std::make_unique<bios::Handler>(
+        sockfd, hostEID, &dbusImplReq, &reqHandler);
+    // Kept to write the pending BIOS attribute value changes on shutdown
+    auto biosHandlerPtr = biosHandler.get();
+    invoker.registerHandler(PLDM_BIOS, std::move(biosHandler));
     std::unique_ptr<oem_platform::Handler> oemPlatformHandler{};
     std::unique_ptr<oem_fru::Handler> oemFruHandler{};
 
@@ -295,13 +339,13 @@ int main(int argc, char** argv)
         FRU_JSONS_DIR, FRU_MASTER_JSON, pdrRepo.get(), entityTree.get(),
         bmcEntityTree.get(), oemFruHandler.get(), dbusImplReq, &reqHandler,
         hostEID, event, dbusToPLDMEventHandler.get());
-    // FRU table is built lazily when a FRU command or Get PDR command is
-    // handled. To enable building FRU table, the FRU handler is passed to the
-    // Platform handler.
+    // The Platform handler builds the FRU table and the PDRs in the
+    // background once the BMC is ready, so the FRU handler is passed to it.
     auto platformHandler = std::make_unique<platform::Handler>(
         &dbusHandler, PDR_JSONS_DIR, pdrRepo.get(), hostPDRHandler.get(),
         dbusToPLDMEventHandler.get(), fruHandler.get(), bmcEntityTree.get(),
         oemPlatformHandler.get(), event, true);
+    platformHandler->setPDRSnapshotFile(PDR_SNAPSHOT_FILE);
 #ifdef OEM_IBM
     pldm::responder::oem_ibm_platform::Handler* oemIbmPlatformHandler =
         dynamic_cast<pldm::responder::oem_ibm_platform::Handler*>(
@@ -354,114 +398,126 @@ int main(int argc, char** argv)
         exit(EXIT_FAILURE);
     }
 
-    auto callback = [verbose, &invoker, &reqHandler, currentSendbuffSize](
+    // The receive buffers are allocated once and reused for every message
+    auto callback = [verbose, &invoker, &reqHandler, currentSendbuffSize,
+                     rxBuffers = std::vector<std::vector<uint8_t>>(
+                         MCTP_BATCH_SIZE,
+                         std::vector<uint8_t>(MCTP_RX_BUFFER_SIZE)),
+                     rxIovs = std::vector<struct iovec>(MCTP_BATCH_SIZE),
+                     rxMsgs = std::vector<struct mmsghdr>(MCTP_BATCH_SIZE)](
                         IO& io, int fd, uint32_t revents) mutable {
         if (!(revents & EPOLLIN))
         {
             return;
         }
 
-        // Outgoing message.
-        struct iovec iov[2]{};
-
-        // This structure contains the parameter information for the response
-        // message.
-        struct msghdr msg
-        {};
-
-        int returnCode = 0;
-        ssize_t peekedLength = recv(fd, nullptr, 0, MSG_PEEK | MSG_TRUNC);
-        if (0 == peekedLength)
+        for (size_t i = 0; i < rxMsgs.size(); ++i)
         {
-            // MCTP daemon has closed the socket this daemon is connected to.
-            // This may or may not be an error scenario, in either case the
-            // recovery mechanism for this daemon is to restart, and hence exit
-            // the event loop, that will cause this daemon to exit with a
-            // failure code.
-            io.get_event().exit(0);
+            rxIovs[i].iov_base = rxBuffers[i].data();
+            rxIovs[i].iov_len = rxBuffers[i].size();
+            rxMsgs[i] = {};
+            rxMsgs[i].msg_hdr.msg_iov = &rxIovs[i];
+            rxMsgs[i].msg_hdr.msg_iovlen = 1;
         }
-        else if (peekedLength <= -1)
+
+        // Drain the messages queued on the socket, up to the batch size, with
+        // a single call
+        int numMsgs =
+            recvmmsg(fd, rxMsgs.data(), rxMsgs.size(), MSG_DONTWAIT, nullptr);
+        if (numMsgs <= -1)
         {
-            returnCode = -errno;
-            std::cerr << "recv system call failed, RC= " << returnCode << "\n";
+            int returnCode = -errno;
+            if (returnCode != -EAGAIN)
+            {
+                std::cerr << "recvmmsg system call failed, RC= " << returnCode
+                          << "\n";
+            }
+            return;
         }
-        else
+
+        // The responses and the requests made while handling the messages are
+        // sent together once all of them are handled
+        auto& txBatch = TxBatch::GetInstance();
+        txBatch.open(fd);
+        for (int i = 0; i < numMsgs; ++i)
         {
-            std::vector<uint8_t> requestMsg(peekedLength);
-            auto recvDataLength = recv(
-                fd, static_cast<void*>(requestMsg.data()), peekedLength, 0);
-            if (recvDataLength == peekedLength)
+            const auto requestMsg = rxBuffers[i].data();
+            const size_t requestMsgLen = rxMsgs[i].msg_len;
+            if (0 == requestMsgLen)
+            {
+                // MCTP daemon has closed the socket this daemon is connected
+                // to. This may or may not be an error scenario, in either case
+                // the recovery mechanism for this daemon is to restart, and
+                // hence exit the event loop, that will cause this daemon to
+                // exit with a failure code.
+                io.get_event().exit(0);
+                break;
+            }
+            else if (rxMsgs[i].msg_hdr.msg_flags & MSG_TRUNC)
+            {
+                std::cerr << "Dropped a message larger than the receive "
+                             "buffer\n";
+                continue;
+            }
+            else if (requestMsgLen < 2)
+            {
+                std::cerr << "Received a message without MCTP message type, "
+                             "length= "
+                          << requestMsgLen << "\n";
+                continue;
+            }
+
+            if (verbose)
+            {
+                printBuffer(Rx, std::vector<uint8_t>(
+                                    requestMsg, requestMsg + requestMsgLen));
+            }
+
+            if (MCTP_MSG_TYPE_PLDM != requestMsg[1])
             {
-                FlightRecorder::GetInstance().saveRecord(requestMsg, false);
+                // Skip this message and continue.
+                std::cerr << "Encountered Non-PLDM type message"
+                          << "\n";
+                continue;
+            }
+            FlightRecorder::GetInstance().saveRecord(
+                requestMsg[0], requestMsg + 2, requestMsgLen - 2, false);
+
+            // process message and queue the response
+            auto response = processRxMsg(fd, requestMsg, requestMsgLen,
+                                         invoker, reqHandler);
+            if (response.has_value())
+            {
+                FlightRecorder::GetInstance().saveRecord(
+                    requestMsg[0], response->data(), response->size(), true);
                 if (verbose)
                 {
-                    printBuffer(Rx, requestMsg);
+                    printBuffer(Tx, *response);
                 }
 
-                if (MCTP_MSG_TYPE_PLDM != requestMsg[1])
-                {
-                    // Skip this message and continue.
-                    std::cerr << "Encountered Non-PLDM type message"
-                              << "\n";
-                }
-                else
+                if (currentSendbuffSize >= 0 &&
+                    (size_t)currentSendbuffSize < (*response).size())
                 {
-                    // process message and send response
-                    auto response =
-                        processRxMsg(requestMsg, invoker, reqHandler);
-                    if (response.has_value())
-                    {
-                        FlightRecorder::GetInstance().saveRecord(*response,
-                                                                 true);
-                        if (verbose)
-                        {
-                            printBuffer(Tx, *response);
-                        }
-
-                        iov[0].iov_base = &requestMsg[0];
-                        iov[0].iov_len =
-                            sizeof(requestMsg[0]) + sizeof(requestMsg[1]);
-                        iov[1].iov_base = (*response).data();
-                        iov[1].iov_len = (*response).size();
-
-                        msg.msg_iov = iov;
-                        msg.msg_iovlen = sizeof(iov) / sizeof(iov[0]);
-                        if (currentSendbuffSize >= 0 &&
-                            (size_t)currentSendbuffSize < (*response).size())
-                        {
-                            currentSendbuffSize = (*response).size();
-                            int res = setsockopt(fd, SOL_SOCKET, SO_SNDBUF,
-                                                 &currentSendbuffSize,
-                                                 sizeof(currentSendbuffSize));
-                            if (res == -1)
-                                std::cerr
-                                    << "Tx: Error calling setsockopt. RC = "
-                                    << res << ", errno = " << errno
-                                    << std::endl;
-                        }
-
-                        int result = sendmsg(fd, &msg, 0);
-                        if (-1 == result)
-                        {
-                            returnCode = -errno;
-                            std::cerr << "sendto system call failed, RC= "
-                                      << returnCode << "\n";
-                        }
-                    }
+                    currentSendbuffSize = (*response).size();
+                    int res = setsockopt(fd, SOL_SOCKET, SO_SNDBUF,
+                                         &currentSendbuffSize,
+                                         sizeof(currentSendbuffSize));
+                    if (res == -1)
+                        std::cerr << "Tx: Error calling setsockopt. RC = "
+                                  << res << ", errno = " << errno
+                                  << std::endl;
                 }
-            }
-            else
-            {
-                std::cerr
-                    << "Failure to read peeked length packet. peekedLength= "
-                    << peekedLength << " recvDataLength=" << recvDataLength
-                    << "\n";
+
+                txBatch.add(requestMsg[0], std::move(*response));
             }
         }
+
+        txBatch.flush();
     };
 
     bus.attach_event(event.get(), SD_EVENT_PRIORITY_NORMAL);
     bus.request_name("xyz.openbmc_project.PLDM");
+    DBusHandler::enableServiceCache();
 
     IO io(event, socketFd(), EPOLLIN, std::move(callback));
 #ifdef LIBPLDMRESPONDER
@@ -474,6 +530,24 @@ int main(int argc, char** argv)
     stdplus::signal::block(SIGUSR1);
     sdeventplus::source::Signal sigUsr1(
         event, SIGUSR1, std::bind_front(&interruptFlightRecorderCallBack));
+
+    // The BIOS attribute value table and the persisted D-Bus objects are
+    // written a short delay after they change, write the pending changes
+    // before exiting when the service is stopped or the BMC reboots
+    auto shutdownCallBack = [&](Signal& /*signal*/,
+                                const struct signalfd_siginfo* si) {
+        std::cerr << "Received signal " << si->ssi_signo << ", exiting\n";
+#ifdef LIBPLDMRESPONDER
+        biosHandlerPtr->flushAttrValueTable();
+        pldm::serialize::Serialize::getSerialize().flush();
+#endif
+        event.exit(0);
+    };
+    stdplus::signal::block(SIGTERM);
+    stdplus::signal::block(SIGINT);
+    sdeventplus::source::Signal sigTerm(event, SIGTERM, shutdownCallBack);
+    sdeventplus::source::Signal sigInt(event, SIGINT, shutdownCallBack);
+
     returnCode = event.loop();
     if (shutdown(sockfd, SHUT_RDWR))
     {
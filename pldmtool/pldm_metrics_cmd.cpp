@@ -0,0 +1,61 @@
+#include "pldm_metrics_cmd.hpp"
+
+#include "pldm_cmd_helper.hpp"
+
+namespace pldmtool
+{
+
+namespace metrics
+{
+
+namespace
+{
+
+using namespace pldmtool::helper;
+
+constexpr auto metricsObjPath = "/xyz/openbmc_project/pldm/metrics";
+constexpr auto metricsInterface = "xyz.openbmc_project.PLDM.Metrics";
+
+bool reset = false;
+
+void exec()
+{
+    auto& bus = pldm::utils::DBusHandler::getBus();
+    try
+    {
+        auto service = pldm::utils::DBusHandler().getService(metricsObjPath,
+                                                             metricsInterface);
+        if (reset)
+        {
+            auto method = bus.new_method_call(service.c_str(), metricsObjPath,
+                                              metricsInterface, "Reset");
+            bus.call_noreply(method);
+            return;
+        }
+
+        auto method = bus.new_method_call(service.c_str(), metricsObjPath,
+                                          metricsInterface, "GetMetrics");
+        auto reply = bus.call(method);
+        std::string metrics;
+        reply.read(metrics);
+        DisplayInJson(ordered_json::parse(metrics));
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Failed to get the pldmd metrics, error = " << e.what()
+                  << "\n";
+    }
+}
+
+} // namespace
+
+void registerCommand(CLI::App& app)
+{
+    auto metrics = app.add_subcommand(
+        "metrics", "dump the per command counters and latencies of pldmd");
+    metrics->add_flag("-r,--reset", reset, "clear the metrics");
+    metrics->callback(exec);
+}
+
+} // namespace metrics
+} // namespace pldmtool
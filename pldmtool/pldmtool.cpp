@@ -2,6 +2,7 @@
 #include "pldm_bios_cmd.hpp"
 #include "pldm_cmd_helper.hpp"
 #include "pldm_fru_cmd.hpp"
+#include "pldm_metrics_cmd.hpp"
 #include "pldm_platform_cmd.hpp"
 #include "pldmtool/oem/ibm/pldm_oem_ibm.hpp"
 
@@ -72,6 +73,7 @@ int main(int argc, char** argv)
     pldmtool::bios::registerCommand(app);
     pldmtool::platform::registerCommand(app);
     pldmtool::fru::registerCommand(app);
+    pldmtool::metrics::registerCommand(app);
 
 #ifdef OEM_IBM
     pldmtool::oem_ibm::registerCommand(app);
@@ -0,0 +1,324 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iostream>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace pldm
+{
+
+namespace requester
+{
+
+template <typename T>
+class Task;
+
+namespace detail
+{
+
+/** @brief Resumes the awaiting coroutine when a task completes, or destroys
+ *         the frame of a detached task
+ */
+template <typename Promise>
+struct FinalAwaiter
+{
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    std::coroutine_handle<>
+        await_suspend(std::coroutine_handle<Promise> handle) noexcept
+    {
+        auto& promise = handle.promise();
+        if (promise.continuation)
+        {
+            return promise.continuation;
+        }
+        if (promise.detached)
+        {
+            handle.destroy();
+        }
+        return std::noop_coroutine();
+    }
+
+    void await_resume() const noexcept
+    {}
+};
+
+/** @brief Promise state shared by the tasks of any result type */
+struct PromiseBase
+{
+    std::coroutine_handle<> continuation; //!< coroutine awaiting the task
+    std::exception_ptr exception;         //!< exception the task ended with
+    bool detached = false; //!< no one awaits the task, it frees itself
+
+    std::suspend_always initial_suspend() const noexcept
+    {
+        return {};
+    }
+
+    void unhandled_exception()
+    {
+        if (detached)
+        {
+            try
+            {
+                std::rethrow_exception(std::current_exception());
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "Detached PLDM requester task failed, ERROR="
+                          << e.what() << "\n";
+            }
+            catch (...)
+            {
+                std::cerr << "Detached PLDM requester task failed\n";
+            }
+            return;
+        }
+        exception = std::current_exception();
+    }
+};
+
+template <typename T>
+struct Promise : PromiseBase
+{
+    std::optional<T> value;
+
+    Task<T> get_return_object();
+
+    FinalAwaiter<Promise> final_suspend() const noexcept
+    {
+        return {};
+    }
+
+    template <typename U>
+    void return_value(U&& result)
+    {
+        value.emplace(std::forward<U>(result));
+    }
+
+    T result()
+    {
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+        return std::move(*value);
+    }
+};
+
+template <>
+struct Promise<void> : PromiseBase
+{
+    Task<void> get_return_object();
+
+    FinalAwaiter<Promise> final_suspend() const noexcept
+    {
+        return {};
+    }
+
+    void return_void() const noexcept
+    {}
+
+    void result()
+    {
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+};
+
+} // namespace detail
+
+/** @class Task
+ *
+ *  Coroutine returning a T, for sequences of PLDM requests written as
+ *  straight-line code:
+ *
+ *    Task<int> getTID(Handler<Request>& handler, mctp_eid_t eid)
+ *    {
+ *        auto response = co_await handler.send(eid, std::move(request));
+ *        ...
+ *    }
+ *
+ *  A task starts running when it is awaited, or when it is detached from
+ *  code that is not a coroutine, such as an event callback.
+ *
+ * @tparam T - result type
+ */
+template <typename T = void>
+class Task
+{
+  public:
+    using promise_type = detail::Promise<T>;
+
+    Task() = delete;
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    Task(Task&& other) noexcept : handle(std::exchange(other.handle, {}))
+    {}
+
+    Task& operator=(Task&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (handle)
+            {
+                handle.destroy();
+            }
+            handle = std::exchange(other.handle, {});
+        }
+        return *this;
+    }
+
+    ~Task()
+    {
+        if (handle)
+        {
+            handle.destroy();
+        }
+    }
+
+    /** @brief Start the task without awaiting it, the task frees itself once
+     *         it completes
+     */
+    void detach()
+    {
+        auto h = std::exchange(handle, {});
+        h.promise().detached = true;
+        h.resume();
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting)
+    {
+        handle.promise().continuation = awaiting;
+        return handle;
+    }
+
+    T await_resume()
+    {
+        return handle.promise().result();
+    }
+
+  private:
+    friend promise_type;
+
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle)
+    {}
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+namespace detail
+{
+
+template <typename T>
+Task<T> Promise<T>::get_return_object()
+{
+    return Task<T>(std::coroutine_handle<Promise>::from_promise(*this));
+}
+
+inline Task<void> Promise<void>::get_return_object()
+{
+    return Task<void>(std::coroutine_handle<Promise>::from_promise(*this));
+}
+
+/** @brief Count of the tasks of whenAll() still running and the coroutine
+ *         awaiting them
+ */
+struct WhenAllState
+{
+    size_t pending;
+    std::coroutine_handle<> awaiting;
+    std::exception_ptr exception;
+
+    bool await_ready() const noexcept
+    {
+        return pending == 0;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) noexcept
+    {
+        awaiting = handle;
+    }
+
+    void await_resume() const noexcept
+    {}
+
+    void completed()
+    {
+        if (--pending == 0 && awaiting)
+        {
+            awaiting.resume();
+        }
+    }
+};
+
+template <typename T>
+Task<void> collect(Task<T>& task, std::optional<T>& result,
+                   WhenAllState& state)
+{
+    try
+    {
+        result.emplace(co_await task);
+    }
+    catch (...)
+    {
+        if (!state.exception)
+        {
+            state.exception = std::current_exception();
+        }
+    }
+    state.completed();
+}
+
+} // namespace detail
+
+/** @brief Run tasks concurrently, for instance to have requests to several
+ *         endpoints or for several records in flight at once
+ *
+ *  @param[in] tasks - tasks to run
+ *
+ *  @return results of the tasks in the order of the tasks, the first
+ *          exception a task ended with is rethrown once all of them completed
+ */
+template <typename T>
+Task<std::vector<T>> whenAll(std::vector<Task<T>> tasks)
+{
+    detail::WhenAllState state{tasks.size(), {}, {}};
+    std::vector<std::optional<T>> results(tasks.size());
+    for (size_t i = 0; i < tasks.size(); ++i)
+    {
+        detail::collect(tasks[i], results[i], state).detach();
+    }
+    co_await state;
+
+    if (state.exception)
+    {
+        std::rethrow_exception(state.exception);
+    }
+    std::vector<T> values;
+    values.reserve(results.size());
+    for (auto& result : results)
+    {
+        values.emplace_back(std::move(*result));
+    }
+    co_return values;
+}
+
+} // namespace requester
+
+} // namespace pldm
@@ -5,22 +5,29 @@
 #include "libpldm/base.h"
 #include "libpldm/requester/pldm.h"
 
+#include "common/metrics.hpp"
 #include "common/types.hpp"
+#include "coroutine.hpp"
 #include "pldmd/dbus_impl_requester.hpp"
 #include "request.hpp"
+#include "rtt_estimator.hpp"
+#include "timer_queue.hpp"
 
 #include <sys/socket.h>
 
 #include <function2/function2.hpp>
-#include <sdbusplus/timer.hpp>
 #include <sdeventplus/event.hpp>
 #include <sdeventplus/source/event.hpp>
 
 #include <cassert>
 #include <chrono>
+#include <coroutine>
+#include <deque>
 #include <memory>
+#include <optional>
 #include <tuple>
 #include <unordered_map>
+#include <vector>
 
 namespace pldm
 {
@@ -74,6 +81,17 @@ using ResponseHandler = fu2::unique_function<void(
  *  received within the instance ID expiration interval or any other failure the
  *  response handler is invoked with the empty response.
  *
+ *  Requests registered without an instance ID are queued per MCTP endpoint
+ *  while the endpoint has the maximum number of requests in flight, or while
+ *  no instance ID is free for it, and are sent as responses arrive or instance
+ *  IDs expire. Requests registered with an instance ID are queued the same
+ *  while the endpoint has the maximum number of requests in flight, their
+ *  instance ID is given back and another one allocated when they are sent.
+ *
+ *  The time to wait for a response before retrying a request adapts to the
+ *  round trip times measured per MCTP endpoint, starting from the response
+ *  time-out, and backs off with each retry.
+ *
  * @tparam RequestInterface - Request class type
  */
 template <class RequestInterface>
@@ -86,7 +104,17 @@ class Handler
     Handler(Handler&&) = delete;
     Handler& operator=(const Handler&) = delete;
     Handler& operator=(Handler&&) = delete;
-    ~Handler() = default;
+    ~Handler()
+    {
+        for (const auto& [key, value] : handlers)
+        {
+            timerQueue->cancel(std::get<TimerQueue::Id>(value));
+        }
+        if (queueRetryTimerId)
+        {
+            timerQueue->cancel(*queueRetryTimerId);
+        }
+    }
 
     /** @brief Constructor
      *
@@ -96,7 +124,10 @@ class Handler
      *  @param[in] verbose - verbose tracing flag
      *  @param[in] instanceIdExpiryInterval - instance ID expiration interval
      *  @param[in] numRetries - number of request retries
-     *  @param[in] responseTimeOut - time to wait between each retry
+     *  @param[in] responseTimeOut - time to wait between each retry, till the
+     *                              round trip time to the endpoint is known
+     *  @param[in] maxRequestsInFlight - maximum number of requests in flight
+     *                                   to an MCTP endpoint
      */
     explicit Handler(
         int fd, sdeventplus::Event& event, pldm::dbus_api::Requester& requester,
@@ -105,15 +136,27 @@ class Handler
             std::chrono::seconds(INSTANCE_ID_EXPIRATION_INTERVAL),
         uint8_t numRetries = static_cast<uint8_t>(NUMBER_OF_REQUEST_RETRIES),
         std::chrono::milliseconds responseTimeOut =
-            std::chrono::milliseconds(RESPONSE_TIME_OUT)) :
+            std::chrono::milliseconds(RESPONSE_TIME_OUT),
+        size_t maxRequestsInFlight = MAXIMUM_REQUESTS_IN_FLIGHT) :
         fd(fd),
         event(event), requester(requester),
         currentSendbuffSize(currentSendbuffSize), verbose(verbose),
         instanceIdExpiryInterval(instanceIdExpiryInterval),
-        numRetries(numRetries), responseTimeOut(responseTimeOut)
+        numRetries(numRetries), responseTimeOut(responseTimeOut),
+        maxRequestsInFlight(maxRequestsInFlight),
+        rttEstimator(responseTimeOut,
+                     std::chrono::milliseconds(MINIMUM_RESPONSE_TIME_OUT),
+                     std::chrono::duration_cast<std::chrono::milliseconds>(
+                         instanceIdExpiryInterval) /
+                         (numRetries + 1)),
+        timerQueue(TimerQueue::get(event))
     {}
 
     /** @brief Register a PLDM request message
+     *
+     *  The request is queued as with the overload without an instance ID if
+     *  the endpoint has the maximum number of requests in flight or requests
+     *  queued already, the instance ID is then freed.
      *
      *  @param[in] eid - endpoint ID of the remote MCTP endpoint
      *  @param[in] instanceId - instance ID to match request and response
@@ -127,6 +170,224 @@ class Handler
     int registerRequest(mctp_eid_t eid, uint8_t instanceId, uint8_t type,
                         uint8_t command, pldm::Request&& requestMsg,
                         ResponseHandler&& responseHandler)
+    {
+        auto& inFlight = requestsInFlight[eid];
+        if (inFlight >= maxRequestsInFlight || queuedRequests(eid))
+        {
+            requester.markFree(eid, instanceId);
+            return registerRequest(eid, type, command, std::move(requestMsg),
+                                   std::move(responseHandler));
+        }
+
+        auto rc = sendRequest(eid, instanceId, type, command,
+                              std::move(requestMsg), std::move(responseHandler));
+        if (rc == PLDM_SUCCESS)
+        {
+            ++inFlight;
+        }
+        return rc;
+    }
+
+    /** @brief Register a PLDM request message, the instance ID is allocated
+     *         when the request is sent
+     *
+     *  The request is queued while the endpoint has the maximum number of
+     *  requests in flight or no instance ID is free, if it fails to be sent
+     *  later the response handler is invoked with the empty response.
+     *
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     *  @param[in] type - PLDM type
+     *  @param[in] command - PLDM command
+     *  @param[in] requestMsg - PLDM request message, the instance ID in the
+     *                          header is overwritten
+     *  @param[in] responseHandler - Response handler for this request
+     *
+     *  @return return PLDM_SUCCESS on success and PLDM_ERROR otherwise
+     */
+    int registerRequest(mctp_eid_t eid, uint8_t type, uint8_t command,
+                        pldm::Request&& requestMsg,
+                        ResponseHandler&& responseHandler)
+    {
+        if (requestMsg.size() < sizeof(pldm_msg_hdr))
+        {
+            std::cerr << "Failed to register a PLDM request message without "
+                         "a header\n";
+            return PLDM_ERROR_INVALID_LENGTH;
+        }
+
+        auto& queue = requestQueues[eid];
+        queue.emplace_back(type, command, std::move(requestMsg),
+                           std::move(responseHandler));
+        if (queue.size() == 1)
+        {
+            sendQueuedRequests(eid);
+        }
+        else
+        {
+            pldm::metrics::Metrics::GetInstance().queueDepth(eid,
+                                                             queue.size());
+        }
+        return PLDM_SUCCESS;
+    }
+
+    /** @brief Handle PLDM response message
+     *
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     *  @param[in] instanceId - instance ID to match request and response
+     *  @param[in] type - PLDM type
+     *  @param[in] command - PLDM command
+     *  @param[in] response - PLDM response message
+     *  @param[in] respMsgLen - length of the response message
+     */
+    void handleResponse(mctp_eid_t eid, uint8_t instanceId, uint8_t type,
+                        uint8_t command, const pldm_msg* response,
+                        size_t respMsgLen)
+    {
+        RequestKey key{eid, instanceId, type, command};
+        if (handlers.contains(key))
+        {
+            auto& [request, responseHandler, timerId] = handlers[key];
+            request->stop();
+            timerQueue->cancel(timerId);
+            if (auto rtt = request->rttSample())
+            {
+                rttEstimator.update(eid, *rtt);
+            }
+            pldm::metrics::Metrics::GetInstance().responded(
+                type, command, request->getRetries(), request->elapsed());
+            responseHandler(eid, response, respMsgLen);
+            requester.markFree(key.eid, key.instanceId);
+            handlers.erase(key);
+            requestCompleted(key.eid);
+        }
+        else
+        {
+            // Got a response for a PLDM request message not registered with the
+            // request handler, so freeing up the instance ID, this can be other
+            // OpenBMC applications relying on PLDM D-Bus apis like
+            // openpower-occ-control and softoff
+            requester.markFree(key.eid, key.instanceId);
+            sendQueuedRequests(key.eid);
+        }
+    }
+
+    /** @brief Get the number of requests queued for an MCTP endpoint
+     *
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     *
+     *  @return number of requests waiting to be sent
+     */
+    size_t queuedRequests(mctp_eid_t eid) const
+    {
+        auto it = requestQueues.find(eid);
+        return it == requestQueues.end() ? 0 : it->second.size();
+    }
+
+    /** @class SendAwaiter
+     *
+     *  Awaitable of a PLDM request, registered without an instance ID when
+     *  the awaiting coroutine suspends. The coroutine is resumed from the
+     *  event loop with the response, or with an empty response if none was
+     *  received. The coroutine must not be destroyed while it is suspended.
+     */
+    class SendAwaiter
+    {
+      public:
+        SendAwaiter(Handler& handler, mctp_eid_t eid,
+                    pldm::Request&& requestMsg) :
+            handler(handler),
+            eid(eid), requestMsg(std::move(requestMsg))
+        {}
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> awaiting)
+        {
+            if (requestMsg.size() < sizeof(pldm_msg_hdr))
+            {
+                std::cerr << "Failed to send a PLDM request message without "
+                             "a header\n";
+                return false;
+            }
+
+            auto hdr = reinterpret_cast<const pldm_msg_hdr*>(requestMsg.data());
+            auto rc = handler.registerRequest(
+                eid, hdr->type, hdr->command, std::move(requestMsg),
+                [this, awaiting](mctp_eid_t /*eid*/, const pldm_msg* response,
+                                 size_t respMsgLen) {
+                    if (response != nullptr)
+                    {
+                        auto msg = reinterpret_cast<const uint8_t*>(response);
+                        responseMsg.assign(msg, msg + sizeof(pldm_msg_hdr) +
+                                                    respMsgLen);
+                    }
+                    // Resumed from the event loop, not from within the
+                    // handler that is still working on the request entry
+                    handler.timerQueue->schedule(
+                        std::chrono::microseconds(0),
+                        [awaiting]() { awaiting.resume(); });
+                });
+            return rc == PLDM_SUCCESS;
+        }
+
+        /** @brief Get the PLDM response message, header included, empty if
+         *         no response was received
+         */
+        pldm::Response await_resume() noexcept
+        {
+            return std::move(responseMsg);
+        }
+
+      private:
+        Handler& handler;
+        mctp_eid_t eid;
+        pldm::Request requestMsg;
+        pldm::Response responseMsg;
+    };
+
+    /** @brief Send a PLDM request message from a coroutine,
+     *         co_await handler.send(eid, std::move(requestMsg)) returns the
+     *         response
+     *
+     *  The PLDM type and command are taken from the header, the instance ID
+     *  in the header is overwritten as with the registerRequest overload
+     *  without an instance ID.
+     *
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     *  @param[in] requestMsg - PLDM request message
+     *
+     *  @return awaitable of the PLDM response message
+     */
+    SendAwaiter send(mctp_eid_t eid, pldm::Request&& requestMsg)
+    {
+        return SendAwaiter(*this, eid, std::move(requestMsg));
+    }
+
+    /** @brief Get the round trip time estimates of the MCTP endpoints */
+    const RttEstimator& getRttEstimator() const
+    {
+        return rttEstimator;
+    }
+
+  private:
+    /** @brief Send a PLDM request message and track it till the response
+     *         arrives or the instance ID expires
+     *
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     *  @param[in] instanceId - instance ID to match request and response
+     *  @param[in] type - PLDM type
+     *  @param[in] command - PLDM command
+     *  @param[in] requestMsg - PLDM request message
+     *  @param[in] responseHandler - Response handler for this request
+     *
+     *  @return return PLDM_SUCCESS on success and PLDM_ERROR otherwise
+     */
+    int sendRequest(mctp_eid_t eid, uint8_t instanceId, uint8_t type,
+                    uint8_t command, pldm::Request&& requestMsg,
+                    ResponseHandler&& responseHandler)
     {
         RequestKey key{eid, instanceId, type, command};
 
@@ -139,16 +400,11 @@ class Handler
                           << " INSTANCE_ID = " << (unsigned)key.instanceId
                           << " TYPE = " << (unsigned)key.type
                           << " COMMAND = " << (unsigned)key.command << "\n";
-                auto& [request, responseHandler, timerInstance] =
+                auto& [request, responseHandler, timerId] =
                     this->handlers[key];
                 request->stop();
-                auto rc = timerInstance->stop();
-                if (rc)
-                {
-                    std::cerr
-                        << "Failed to stop the instance ID expiry timer. RC = "
-                        << rc << "\n";
-                }
+                pldm::metrics::Metrics::GetInstance().timedOut(
+                    key.type, key.command, request->getRetries());
                 // Call response handler with an empty response to indicate no
                 // response
                 responseHandler(key.eid, nullptr, 0);
@@ -167,10 +423,9 @@ class Handler
         };
 
         auto request = std::make_unique<RequestInterface>(
-            fd, eid, event, std::move(requestMsg), numRetries, responseTimeOut,
-            currentSendbuffSize, verbose);
-        auto timer = std::make_unique<phosphor::Timer>(
-            event.get(), instanceIdExpiryCallBack);
+            fd, eid, event, std::move(requestMsg), numRetries,
+            rttEstimator.timeout(eid), currentSendbuffSize, verbose,
+            rttEstimator.maximum());
 
         auto rc = request->start();
         if (rc)
@@ -181,13 +436,17 @@ class Handler
             return rc;
         }
 
+        TimerQueue::Id timerId{};
         try
         {
-            timer->start(duration_cast<std::chrono::microseconds>(
-                instanceIdExpiryInterval));
+            timerId = timerQueue->schedule(
+                duration_cast<std::chrono::microseconds>(
+                    instanceIdExpiryInterval),
+                instanceIdExpiryCallBack);
         }
         catch (const std::runtime_error& e)
         {
+            request->stop();
             requester.markFree(eid, instanceId);
             std::cerr << "Failed to start the instance ID expiry timer. RC = "
                       << e.what() << "\n";
@@ -196,50 +455,11 @@ class Handler
 
         handlers.emplace(key, std::make_tuple(std::move(request),
                                               std::move(responseHandler),
-                                              std::move(timer)));
+                                              timerId));
+        pldm::metrics::Metrics::GetInstance().sent(type, command);
         return rc;
     }
 
-    /** @brief Handle PLDM response message
-     *
-     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
-     *  @param[in] instanceId - instance ID to match request and response
-     *  @param[in] type - PLDM type
-     *  @param[in] command - PLDM command
-     *  @param[in] response - PLDM response message
-     *  @param[in] respMsgLen - length of the response message
-     */
-    void handleResponse(mctp_eid_t eid, uint8_t instanceId, uint8_t type,
-                        uint8_t command, const pldm_msg* response,
-                        size_t respMsgLen)
-    {
-        RequestKey key{eid, instanceId, type, command};
-        if (handlers.contains(key))
-        {
-            auto& [request, responseHandler, timerInstance] = handlers[key];
-            request->stop();
-            auto rc = timerInstance->stop();
-            if (rc)
-            {
-                std::cerr
-                    << "Failed to stop the instance ID expiry timer. RC = "
-                    << rc << "\n";
-            }
-            responseHandler(eid, response, respMsgLen);
-            requester.markFree(key.eid, key.instanceId);
-            handlers.erase(key);
-        }
-        else
-        {
-            // Got a response for a PLDM request message not registered with the
-            // request handler, so freeing up the instance ID, this can be other
-            // OpenBMC applications relying on PLDM D-Bus apis like
-            // openpower-occ-control and softoff
-            requester.markFree(key.eid, key.instanceId);
-        }
-    }
-
-  private:
     int fd; //!< file descriptor of MCTP communications socket
     sdeventplus::Event& event; //!< reference to PLDM daemon's main event loop
     pldm::dbus_api::Requester& requester; //!< reference to Requester object
@@ -249,15 +469,40 @@ class Handler
         instanceIdExpiryInterval; //!< Instance ID expiration interval
     uint8_t numRetries;           //!< number of request retries
     std::chrono::milliseconds
-        responseTimeOut; //!< time to wait between each retry
+        responseTimeOut;        //!< time to wait between each retry
+    size_t maxRequestsInFlight; //!< maximum requests in flight to an endpoint
+
+    /** @brief Retry timeouts per MCTP endpoint, bounded so that the retries
+     *         of a request fit in the instance ID expiration interval
+     */
+    RttEstimator rttEstimator;
+
+    /** @brief Deadlines of the requests on the event loop */
+    std::shared_ptr<TimerQueue> timerQueue;
+
+    /** @brief Deadline to send the queued requests again when no instance ID
+     *         was free for them
+     */
+    std::optional<TimerQueue::Id> queueRetryTimerId;
+
+    /** @brief PLDM type, PLDM command, PLDM request message and response
+     *         handler of a request waiting to be sent
+     */
+    using QueuedRequest =
+        std::tuple<uint8_t, uint8_t, pldm::Request, ResponseHandler>;
+
+    /** @brief Requests waiting to be sent, per MCTP endpoint */
+    std::unordered_map<mctp_eid_t, std::deque<QueuedRequest>> requestQueues;
+
+    /** @brief Number of requests in flight, per MCTP endpoint */
+    std::unordered_map<mctp_eid_t, size_t> requestsInFlight;
 
     /** @brief Container for storing the details of the PLDM request
      *         message, handler for the corresponding PLDM response and the
-     *         timer object for the Instance ID expiration
+     *         deadline of the Instance ID expiration
      */
-    using RequestValue =
-        std::tuple<std::unique_ptr<RequestInterface>, ResponseHandler,
-                   std::unique_ptr<phosphor::Timer>>;
+    using RequestValue = std::tuple<std::unique_ptr<RequestInterface>,
+                                    ResponseHandler, TimerQueue::Id>;
 
     /** @brief Container for storing the PLDM request entries */
     std::unordered_map<RequestKey, RequestValue, RequestKeyHasher> handlers;
@@ -281,6 +526,95 @@ class Handler
             requester.markFree(key.eid, key.instanceId);
             handlers.erase(key);
             removeRequestContainer.erase(key);
+            requestCompleted(key.eid);
+        }
+    }
+
+    /** @brief Account for a request that got its response or whose instance
+     *         ID expired, and send the requests queued for the endpoint
+     *
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     */
+    void requestCompleted(mctp_eid_t eid)
+    {
+        auto& inFlight = requestsInFlight[eid];
+        if (inFlight)
+        {
+            --inFlight;
+        }
+        sendQueuedRequests(eid);
+    }
+
+    /** @brief Send the requests queued for an endpoint, as long as it has
+     *         less than the maximum requests in flight and instance IDs are
+     *         free
+     *
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     */
+    void sendQueuedRequests(mctp_eid_t eid)
+    {
+        // References to the elements stay valid if a response handler
+        // registers a request for another endpoint
+        auto& queue = requestQueues[eid];
+        auto& inFlight = requestsInFlight[eid];
+        while (!queue.empty() && inFlight < maxRequestsInFlight)
+        {
+            uint8_t instanceId{};
+            try
+            {
+                instanceId = requester.getInstanceId(eid);
+            }
+            catch (const std::exception& e)
+            {
+                // The instance IDs are held by the other requesters of the
+                // endpoint, they don't notify when they are done
+                if (!queueRetryTimerId)
+                {
+                    queueRetryTimerId = timerQueue->schedule(
+                        duration_cast<std::chrono::microseconds>(
+                            responseTimeOut),
+                        [this]() {
+                            queueRetryTimerId.reset();
+                            sendQueuedRequests();
+                        });
+                }
+                break;
+            }
+
+            auto [type, command, requestMsg, responseHandler] =
+                std::move(queue.front());
+            queue.pop_front();
+            reinterpret_cast<pldm_msg_hdr*>(requestMsg.data())->instance_id =
+                instanceId;
+
+            auto rc = sendRequest(eid, instanceId, type, command,
+                                  std::move(requestMsg),
+                                  std::move(responseHandler));
+            if (rc)
+            {
+                // sendRequest takes the response handler only on success
+                responseHandler(eid, nullptr, 0);
+                continue;
+            }
+            ++inFlight;
+        }
+        pldm::metrics::Metrics::GetInstance().queueDepth(eid, queue.size());
+    }
+
+    /** @brief Send the requests queued for every endpoint */
+    void sendQueuedRequests()
+    {
+        std::vector<mctp_eid_t> eids;
+        for (const auto& [eid, queue] : requestQueues)
+        {
+            if (!queue.empty())
+            {
+                eids.push_back(eid);
+            }
+        }
+        for (const auto& eid : eids)
+        {
+            sendQueuedRequests(eid);
         }
     }
 };
@@ -4,17 +4,22 @@
 #include "libpldm/requester/pldm.h"
 
 #include "common/flight_recorder.hpp"
+#include "common/tx_batch.hpp"
 #include "common/types.hpp"
 #include "common/utils.hpp"
+#include "timer_queue.hpp"
 
 #include <sys/socket.h>
 
-#include <sdbusplus/timer.hpp>
 #include <sdeventplus/event.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <functional>
 #include <iostream>
+#include <memory>
+#include <optional>
+#include <random>
 
 namespace pldm
 {
@@ -28,6 +33,10 @@ namespace requester
  *  class handles number of times the PLDM request needs to be retried if the
  *  response is not received and the time to wait between each retry. It
  *  provides APIs to start and stop the request flow.
+ *
+ *  Given a maximum timeout, the time to wait doubles with each retry up to
+ *  the maximum, less a random jitter of up to an eighth, so the retries of
+ *  requests that timed out together spread out.
  */
 class RequestRetryTimer
 {
@@ -37,20 +46,27 @@ class RequestRetryTimer
     RequestRetryTimer(RequestRetryTimer&&) = default;
     RequestRetryTimer& operator=(const RequestRetryTimer&) = delete;
     RequestRetryTimer& operator=(RequestRetryTimer&&) = default;
-    virtual ~RequestRetryTimer() = default;
+    virtual ~RequestRetryTimer()
+    {
+        stop();
+    }
 
     /** @brief Constructor
      *
      *  @param[in] event - reference to PLDM daemon's main event loop
      *  @param[in] numRetries - number of request retries
      *  @param[in] timeout - time to wait between each retry in milliseconds
+     *  @param[in] maxTimeout - bound of the time to wait as it backs off,
+     *                          no backoff if not more than timeout
      */
-    explicit RequestRetryTimer(sdeventplus::Event& event, uint8_t numRetries,
-                               std::chrono::milliseconds timeout) :
+    explicit RequestRetryTimer(
+        sdeventplus::Event& event, uint8_t numRetries,
+        std::chrono::milliseconds timeout,
+        std::chrono::milliseconds maxTimeout = std::chrono::milliseconds(0)) :
 
         event(event),
-        numRetries(numRetries), timeout(timeout),
-        timer(event.get(), std::bind_front(&RequestRetryTimer::callback, this))
+        numRetries(numRetries), timeout(timeout), maxTimeout(maxTimeout),
+        nextTimeout(timeout), timerQueue(TimerQueue::get(event))
     {}
 
     /** @brief Starts the request flow and arms the timer for request retries
@@ -59,6 +75,7 @@ class RequestRetryTimer
      */
     int start()
     {
+        sendTime = std::chrono::steady_clock::now();
         auto rc = send();
         if (rc)
         {
@@ -69,8 +86,7 @@ class RequestRetryTimer
         {
             if (numRetries)
             {
-                timer.start(duration_cast<std::chrono::microseconds>(timeout),
-                            true);
+                schedule(timeout);
             }
         }
         catch (const std::runtime_error& e)
@@ -86,20 +102,52 @@ class RequestRetryTimer
     /** @brief Stops the timer and no further request retries happen */
     void stop()
     {
-        auto rc = timer.stop();
-        if (rc)
+        if (timerId && timerQueue)
         {
-            std::cerr << "Failed to stop the request timer. RC = " << rc
-                      << "\n";
+            timerQueue->cancel(*timerId);
+            timerId.reset();
+        }
+    }
+
+    /** @brief Get the time since the request was first sent */
+    std::chrono::microseconds elapsed() const
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - sendTime);
+    }
+
+    /** @brief Get the number of times the request was sent again */
+    uint8_t getRetries() const
+    {
+        return retries;
+    }
+
+    /** @brief Get the round trip time of the request on getting its response
+     *
+     *  @return time since the request was sent, none if it was retried as
+     *          the response may be to either send (Karn's algorithm)
+     */
+    std::optional<std::chrono::microseconds> rttSample() const
+    {
+        if (retries)
+        {
+            return std::nullopt;
         }
+        return elapsed();
     }
 
   protected:
     sdeventplus::Event& event; //!< reference to PLDM daemon's main event loop
     uint8_t numRetries;        //!< number of request retries
     std::chrono::milliseconds
-        timeout;           //!< time to wait between each retry in milliseconds
-    phosphor::Timer timer; //!< manages starting timers and handling timeouts
+        timeout; //!< time to wait between each retry in milliseconds
+    std::chrono::milliseconds maxTimeout;  //!< bound of the backoff
+    std::chrono::milliseconds nextTimeout; //!< time to wait, backed off
+    std::chrono::steady_clock::time_point sendTime; //!< first send of request
+    uint8_t retries = 0; //!< number of times the request was sent again
+    /** @brief Deadlines of the requests on the event loop */
+    std::shared_ptr<TimerQueue> timerQueue;
+    std::optional<TimerQueue::Id> timerId; //!< deadline of the next retry
 
     /** @brief Sends the PLDM request message
      *
@@ -107,16 +155,49 @@ class RequestRetryTimer
      */
     virtual int send() const = 0;
 
+    /** @brief Schedules the next retry
+     *
+     *  @param[in] delay - time to wait before the retry
+     */
+    void schedule(std::chrono::microseconds delay)
+    {
+        timerId = timerQueue->schedule(
+            delay, std::bind_front(&RequestRetryTimer::callback, this));
+    }
+
+    /** @brief Get the time to wait before the next retry
+     *
+     *  @return time to wait, backed off and jittered if a maximum timeout is
+     *          set
+     */
+    std::chrono::microseconds backoff()
+    {
+        if (maxTimeout <= timeout)
+        {
+            return timeout;
+        }
+
+        static thread_local std::minstd_rand random(std::random_device{}());
+        nextTimeout = std::min(2 * nextTimeout, maxTimeout);
+        std::chrono::microseconds delay = nextTimeout;
+        std::uniform_int_distribution<std::chrono::microseconds::rep> jitter(
+            0, delay.count() / 8);
+        return delay - std::chrono::microseconds(jitter(random));
+    }
+
     /** @brief Callback function invoked when the timeout happens */
     void callback()
     {
-        if (numRetries--)
+        timerId.reset();
+        if (numRetries)
         {
+            --numRetries;
+            ++retries;
             send();
         }
-        else
+        if (numRetries)
         {
-            stop();
+            schedule(backoff());
         }
     }
 };
@@ -149,12 +230,15 @@ class Request final : public RequestRetryTimer
      *  @param[in] numRetries - number of request retries
      *  @param[in] timeout - time to wait between each retry in milliseconds
      *  @param[in] verbose - verbose tracing flag
+     *  @param[in] maxTimeout - bound of the time to wait as it backs off
      */
-    explicit Request(int fd, mctp_eid_t eid, sdeventplus::Event& event,
-                     pldm::Request&& requestMsg, uint8_t numRetries,
-                     std::chrono::milliseconds timeout,
-                     size_t currentSendbuffSize, bool verbose) :
-        RequestRetryTimer(event, numRetries, timeout),
+    explicit Request(
+        int fd, mctp_eid_t eid, sdeventplus::Event& event,
+        pldm::Request&& requestMsg, uint8_t numRetries,
+        std::chrono::milliseconds timeout, size_t currentSendbuffSize,
+        bool verbose,
+        std::chrono::milliseconds maxTimeout = std::chrono::milliseconds(0)) :
+        RequestRetryTimer(event, numRetries, timeout, maxTimeout),
         fd(fd), eid(eid), requestMsg(std::move(requestMsg)),
         currentSendbuffSize(currentSendbuffSize), verbose(verbose)
     {}
@@ -189,7 +273,17 @@ class Request final : public RequestRetryTimer
                           << res << ", errno = " << errno << std::endl;
         }
         pldm::flightrecorder::FlightRecorder::GetInstance().saveRecord(
-            requestMsg, true);
+            eid, requestMsg.data(), requestMsg.size(), true);
+
+        // Requests made while the daemon handles received messages are sent
+        // along with the responses, a failure is covered by the retries
+        auto& txBatch = pldm::txbatch::TxBatch::GetInstance();
+        if (txBatch.isOpen(fd))
+        {
+            txBatch.add(eid, pldm::Request(requestMsg));
+            return PLDM_SUCCESS;
+        }
+
         auto rc = pldm_send(eid, fd, requestMsg.data(), requestMsg.size());
         if (rc < 0)
         {
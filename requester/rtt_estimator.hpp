@@ -0,0 +1,124 @@
+#pragma once
+
+#include "libpldm/requester/pldm.h"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+
+namespace pldm
+{
+
+namespace requester
+{
+
+/** @struct RttEstimate
+ *
+ *  Smoothed round trip time of the PLDM requests to an MCTP endpoint, its
+ *  variation and the retry timeout derived from them
+ */
+struct RttEstimate
+{
+    std::chrono::microseconds srtt;   //!< smoothed round trip time
+    std::chrono::microseconds rttvar; //!< round trip time variation
+    std::chrono::microseconds rto;    //!< retry timeout
+};
+
+/** @class RttEstimator
+ *
+ *  Estimates the retry timeout of the PLDM requests per MCTP endpoint from the
+ *  measured request to response latency, as TCP does (RFC 6298):
+ *
+ *    RTTVAR = 3/4 * RTTVAR + 1/4 * |SRTT - R|
+ *    SRTT = 7/8 * SRTT + 1/8 * R
+ *    RTO = SRTT + 4 * RTTVAR
+ *
+ *  The RTO is kept between a minimum and a maximum, endpoints without samples
+ *  use the initial timeout.
+ */
+class RttEstimator
+{
+  public:
+    RttEstimator() = delete;
+
+    /** @brief Constructor
+     *
+     *  @param[in] initialTimeout - timeout of the endpoints without samples
+     *  @param[in] minTimeout - lower bound of the timeouts
+     *  @param[in] maxTimeout - upper bound of the timeouts, also the bound of
+     *                          the retry backoff
+     */
+    explicit RttEstimator(std::chrono::milliseconds initialTimeout,
+                          std::chrono::milliseconds minTimeout,
+                          std::chrono::milliseconds maxTimeout) :
+        initialTimeout(initialTimeout),
+        minTimeout(std::min(minTimeout, initialTimeout)),
+        maxTimeout(std::max(maxTimeout, initialTimeout))
+    {}
+
+    /** @brief Get the retry timeout of the requests to an endpoint
+     *
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     *
+     *  @return retry timeout
+     */
+    std::chrono::milliseconds timeout(mctp_eid_t eid) const
+    {
+        auto it = estimates.find(eid);
+        if (it == estimates.end())
+        {
+            return initialTimeout;
+        }
+        return std::chrono::ceil<std::chrono::milliseconds>(it->second.rto);
+    }
+
+    /** @brief Get the upper bound of the retry timeouts */
+    std::chrono::milliseconds maximum() const
+    {
+        return maxTimeout;
+    }
+
+    /** @brief Update the estimate of an endpoint with a round trip time sample
+     *
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     *  @param[in] rtt - time from sending the request to getting the response,
+     *                   of a request that was not retried
+     */
+    void update(mctp_eid_t eid, std::chrono::microseconds rtt)
+    {
+        auto [it, first] = estimates.try_emplace(eid);
+        auto& estimate = it->second;
+        if (first)
+        {
+            estimate.srtt = rtt;
+            estimate.rttvar = rtt / 2;
+        }
+        else
+        {
+            auto delta = estimate.srtt > rtt ? estimate.srtt - rtt
+                                             : rtt - estimate.srtt;
+            estimate.rttvar = (3 * estimate.rttvar + delta) / 4;
+            estimate.srtt = (7 * estimate.srtt + rtt) / 8;
+        }
+        estimate.rto = std::clamp<std::chrono::microseconds>(
+            estimate.srtt + 4 * estimate.rttvar, minTimeout, maxTimeout);
+    }
+
+    /** @brief Get the estimates of the endpoints that got responses */
+    const std::map<mctp_eid_t, RttEstimate>& get() const
+    {
+        return estimates;
+    }
+
+  private:
+    std::chrono::milliseconds initialTimeout;
+    std::chrono::milliseconds minTimeout;
+    std::chrono::milliseconds maxTimeout;
+
+    /** @brief Estimates per MCTP endpoint */
+    std::map<mctp_eid_t, RttEstimate> estimates;
+};
+
+} // namespace requester
+
+} // namespace pldm
@@ -151,3 +151,209 @@ TEST_F(HandlerTest, multipleRequestResponseScenario)
     EXPECT_EQ(callbackCount, 2);
     EXPECT_EQ(instanceId, dbusImplReq.getInstanceId(eid));
 }
+
+TEST_F(HandlerTest, requestsQueuedBeyondMaxInFlight)
+{
+    Handler<NiceMock<MockRequest>> reqHandler(fd, event, dbusImplReq, false,
+                                              90000, seconds(1), 2,
+                                              milliseconds(100), 2);
+    for (int i = 0; i < 3; ++i)
+    {
+        pldm::Request request(sizeof(pldm_msg_hdr));
+        auto rc = reqHandler.registerRequest(
+            eid, 0, 0, std::move(request),
+            std::move(
+                std::bind_front(&HandlerTest::pldmResponseCallBack, this)));
+        EXPECT_EQ(rc, PLDM_SUCCESS);
+    }
+    // The first two requests got instance IDs 0 and 1, the third waits
+    EXPECT_EQ(reqHandler.queuedRequests(eid), 1);
+
+    pldm::Response response(sizeof(pldm_msg_hdr) + sizeof(uint8_t));
+    auto responsePtr = reinterpret_cast<const pldm_msg*>(response.data());
+    reqHandler.handleResponse(eid, 0, 0, 0, responsePtr, sizeof(response));
+    EXPECT_EQ(validResponse, true);
+    EXPECT_EQ(callbackCount, 1);
+
+    // The response freed instance ID 0, the queued request is sent with it
+    EXPECT_EQ(reqHandler.queuedRequests(eid), 0);
+    reqHandler.handleResponse(eid, 1, 0, 0, responsePtr, sizeof(response));
+    reqHandler.handleResponse(eid, 0, 0, 0, responsePtr, sizeof(response));
+    EXPECT_EQ(callbackCount, 3);
+    EXPECT_EQ(nullResponse, false);
+}
+
+TEST_F(HandlerTest, queuedRequestSentOnInstanceIdExpiry)
+{
+    Handler<NiceMock<MockRequest>> reqHandler(fd, event, dbusImplReq, false,
+                                              90000, seconds(1), 2,
+                                              milliseconds(100), 1);
+    for (int i = 0; i < 2; ++i)
+    {
+        pldm::Request request(sizeof(pldm_msg_hdr));
+        auto rc = reqHandler.registerRequest(
+            eid, 0, 0, std::move(request),
+            std::move(
+                std::bind_front(&HandlerTest::pldmResponseCallBack, this)));
+        EXPECT_EQ(rc, PLDM_SUCCESS);
+    }
+    EXPECT_EQ(reqHandler.queuedRequests(eid), 1);
+
+    // Waiting for 500ms so that the instance ID of the first request expires
+    // and the queued request is sent with it
+    waitEventExpiry(milliseconds(500));
+    EXPECT_EQ(nullResponse, true);
+    EXPECT_EQ(reqHandler.queuedRequests(eid), 0);
+}
+
+TEST_F(HandlerTest, requestWithInstanceIdQueuedBeyondMaxInFlight)
+{
+    Handler<NiceMock<MockRequest>> reqHandler(fd, event, dbusImplReq, false,
+                                              90000, seconds(1), 2,
+                                              milliseconds(100), 1);
+    pldm::Request request(sizeof(pldm_msg_hdr));
+    auto instanceId = dbusImplReq.getInstanceId(eid);
+    auto rc = reqHandler.registerRequest(
+        eid, instanceId, 0, 0, std::move(request),
+        std::move(std::bind_front(&HandlerTest::pldmResponseCallBack, this)));
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+
+    pldm::Request requestNxt(sizeof(pldm_msg_hdr));
+    auto instanceIdNxt = dbusImplReq.getInstanceId(eid);
+    rc = reqHandler.registerRequest(
+        eid, instanceIdNxt, 0, 0, std::move(requestNxt),
+        std::move(std::bind_front(&HandlerTest::pldmResponseCallBack, this)));
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+
+    // The second request waits, it gave back its instance ID
+    EXPECT_EQ(reqHandler.queuedRequests(eid), 1);
+    EXPECT_EQ(instanceIdNxt, dbusImplReq.getInstanceId(eid));
+    dbusImplReq.markFree(eid, instanceIdNxt);
+
+    pldm::Response response(sizeof(pldm_msg_hdr) + sizeof(uint8_t));
+    auto responsePtr = reinterpret_cast<const pldm_msg*>(response.data());
+    reqHandler.handleResponse(eid, instanceId, 0, 0, responsePtr,
+                              sizeof(response));
+    EXPECT_EQ(callbackCount, 1);
+
+    // The queued request is sent with the instance ID the response freed
+    EXPECT_EQ(reqHandler.queuedRequests(eid), 0);
+    reqHandler.handleResponse(eid, instanceId, 0, 0, responsePtr,
+                              sizeof(response));
+    EXPECT_EQ(callbackCount, 2);
+    EXPECT_EQ(nullResponse, false);
+}
+
+TEST_F(HandlerTest, queuedRequestSendFailure)
+{
+    Handler<NiceMock<MockRequest>> reqHandler(
+        fd, event, dbusImplReq, false, 90000, seconds(1), 2, milliseconds(100));
+
+    // MockRequest::send fails, the response handler is invoked with the
+    // empty response before registerRequest returns
+    ::testing::DefaultValue<int>::Set(PLDM_ERROR);
+    pldm::Request request(sizeof(pldm_msg_hdr));
+    auto rc = reqHandler.registerRequest(
+        eid, 0, 0, std::move(request),
+        std::move(std::bind_front(&HandlerTest::pldmResponseCallBack, this)));
+    ::testing::DefaultValue<int>::Clear();
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+    EXPECT_EQ(nullResponse, true);
+    EXPECT_EQ(callbackCount, 1);
+    EXPECT_EQ(reqHandler.queuedRequests(eid), 0);
+
+    // The instance ID is freed
+    EXPECT_EQ(dbusImplReq.getInstanceId(eid), 0);
+}
+
+TEST_F(HandlerTest, noRttSampleFromRetriedRequest)
+{
+    Handler<NiceMock<MockRequest>> reqHandler(
+        fd, event, dbusImplReq, false, 90000, seconds(1), 2, milliseconds(100));
+    pldm::Response response(sizeof(pldm_msg_hdr) + sizeof(uint8_t));
+    auto responsePtr = reinterpret_cast<const pldm_msg*>(response.data());
+
+    auto rc = reqHandler.registerRequest(
+        eid, 0, 0, pldm::Request(sizeof(pldm_msg_hdr)),
+        std::move(std::bind_front(&HandlerTest::pldmResponseCallBack, this)));
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+
+    // The retry is the first deadline of the timer queue, the instance ID
+    // expires later
+    ASSERT_GT(sd_event_run(event.get(), 500000), 0);
+    EXPECT_EQ(callbackCount, 0);
+
+    // The response may be to either send, it is not a sample (Karn's
+    // algorithm)
+    reqHandler.handleResponse(eid, 0, 0, 0, responsePtr, sizeof(uint8_t));
+    EXPECT_EQ(validResponse, true);
+    EXPECT_FALSE(reqHandler.getRttEstimator().get().contains(eid));
+
+    rc = reqHandler.registerRequest(
+        eid, 0, 0, pldm::Request(sizeof(pldm_msg_hdr)),
+        std::move(std::bind_front(&HandlerTest::pldmResponseCallBack, this)));
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+    reqHandler.handleResponse(eid, 0, 0, 0, responsePtr, sizeof(uint8_t));
+    EXPECT_EQ(callbackCount, 2);
+    EXPECT_TRUE(reqHandler.getRttEstimator().get().contains(eid));
+}
+
+TEST_F(HandlerTest, coroutineSendAwaitsResponse)
+{
+    Handler<NiceMock<MockRequest>> reqHandler(
+        fd, event, dbusImplReq, false, 90000, seconds(1), 2, milliseconds(100));
+    pldm::Response received;
+    bool resumed = false;
+    auto getResponse = [&]() -> Task<> {
+        received =
+            co_await reqHandler.send(eid, pldm::Request(sizeof(pldm_msg_hdr)));
+        resumed = true;
+    };
+    getResponse().detach();
+    EXPECT_EQ(resumed, false);
+
+    pldm::Response response(sizeof(pldm_msg_hdr) + sizeof(uint8_t));
+    auto responsePtr = reinterpret_cast<const pldm_msg*>(response.data());
+    reqHandler.handleResponse(eid, 0, 0, 0, responsePtr, sizeof(uint8_t));
+
+    // The coroutine is resumed from the event loop
+    EXPECT_EQ(resumed, false);
+    waitEventExpiry(milliseconds(100));
+    EXPECT_EQ(resumed, true);
+    EXPECT_EQ(received, response);
+}
+
+TEST_F(HandlerTest, coroutineFanOut)
+{
+    Handler<NiceMock<MockRequest>> reqHandler(
+        fd, event, dbusImplReq, false, 90000, seconds(1), 2, milliseconds(100));
+    auto send = [&]() -> Task<pldm::Response> {
+        co_return co_await reqHandler.send(eid,
+                                           pldm::Request(sizeof(pldm_msg_hdr)));
+    };
+    std::vector<pldm::Response> received;
+    auto fanOut = [&]() -> Task<> {
+        std::vector<Task<pldm::Response>> tasks;
+        for (int i = 0; i < 3; ++i)
+        {
+            tasks.push_back(send());
+        }
+        received = co_await whenAll(std::move(tasks));
+    };
+    fanOut().detach();
+
+    // All three requests are in flight, with instance IDs 0 to 2, the
+    // responses arrive in any order and the one to the first never does
+    pldm::Response response(sizeof(pldm_msg_hdr) + sizeof(uint8_t));
+    auto responsePtr = reinterpret_cast<const pldm_msg*>(response.data());
+    reqHandler.handleResponse(eid, 2, 0, 0, responsePtr, sizeof(uint8_t));
+    reqHandler.handleResponse(eid, 1, 0, 0, responsePtr, sizeof(uint8_t));
+    EXPECT_TRUE(received.empty());
+
+    // Waiting for the instance ID of the first request to expire
+    waitEventExpiry(milliseconds(1000));
+    ASSERT_EQ(received.size(), 3u);
+    EXPECT_TRUE(received[0].empty());
+    EXPECT_EQ(received[1], response);
+    EXPECT_EQ(received[2], response);
+}
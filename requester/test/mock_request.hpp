@@ -17,8 +17,10 @@ class MockRequest : public RequestRetryTimer
     MockRequest(int /*fd*/, mctp_eid_t /*eid*/, sdeventplus::Event& event,
                 pldm::Request&& /*requestMsg*/, uint8_t numRetries,
                 std::chrono::milliseconds responseTimeOut,
-                size_t /*currentSendbuffSize*/, bool /*verbose*/) :
-        RequestRetryTimer(event, numRetries, responseTimeOut)
+                size_t /*currentSendbuffSize*/, bool /*verbose*/,
+                std::chrono::milliseconds maxTimeout =
+                    std::chrono::milliseconds(0)) :
+        RequestRetryTimer(event, numRetries, responseTimeOut, maxTimeout)
     {}
 
     MOCK_METHOD(int, send, (), (const, override));
@@ -5,6 +5,9 @@
 #include <sdbusplus/timer.hpp>
 #include <sdeventplus/event.hpp>
 
+#include <optional>
+#include <set>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -13,8 +16,35 @@ using namespace std::chrono;
 using ::testing::AtLeast;
 using ::testing::Between;
 using ::testing::Exactly;
+using ::testing::Invoke;
 using ::testing::Return;
 
+/** @class BackoffRequest
+ *
+ *  MockRequest with the time to wait before the next retry exposed
+ */
+class BackoffRequest : public MockRequest
+{
+  public:
+    using MockRequest::MockRequest;
+    using RequestRetryTimer::backoff;
+
+    /** @brief Get the time left till the next retry in the timer queue */
+    std::optional<microseconds> untilRetry() const
+    {
+        if (!timerId)
+        {
+            return std::nullopt;
+        }
+        auto deadline = timerQueue->deadline(*timerId);
+        if (!deadline)
+        {
+            return std::nullopt;
+        }
+        return duration_cast<microseconds>(*deadline - steady_clock::now());
+    }
+};
+
 class RequestIntfTest : public testing::Test
 {
   protected:
@@ -99,3 +129,97 @@ TEST_F(RequestIntfTest, 2Retries100msTimeoutsendReturnsError)
     auto rc = request.start();
     EXPECT_EQ(rc, PLDM_ERROR);
 }
+
+TEST_F(RequestIntfTest, backoffDoublesUpToMaxTimeout)
+{
+    BackoffRequest request(fd, eid, event, std::move(requestMsg), 8,
+                           milliseconds(100), 90000, false, milliseconds(800));
+
+    // Each delay is the backed off timeout less a jitter of up to an eighth
+    for (auto timeout : {200, 400, 800, 800, 800})
+    {
+        auto delay = request.backoff();
+        microseconds backedOff = milliseconds(timeout);
+        EXPECT_LE(delay, backedOff);
+        EXPECT_GE(delay, backedOff - backedOff / 8);
+    }
+
+    // The jitter spreads the retries out, and stays within an eighth
+    std::set<microseconds::rep> delays;
+    for (int i = 0; i < 1000; ++i)
+    {
+        auto delay = request.backoff();
+        EXPECT_LE(delay, milliseconds(800));
+        EXPECT_GE(delay, milliseconds(700));
+        delays.insert(delay.count());
+    }
+    EXPECT_GT(delays.size(), 1);
+}
+
+TEST_F(RequestIntfTest, noBackoffWithoutMaxTimeout)
+{
+    BackoffRequest request(fd, eid, event, std::move(requestMsg), 8,
+                           milliseconds(100), 90000, false);
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(request.backoff(), milliseconds(100));
+    }
+}
+
+TEST_F(RequestIntfTest, retriesBackOff)
+{
+    BackoffRequest request(fd, eid, event, std::move(requestMsg), 4,
+                           milliseconds(40), 90000, false, milliseconds(100));
+    int sends = 0;
+    EXPECT_CALL(request, send()).Times(5).WillRepeatedly(Invoke([&]() {
+        ++sends;
+        return PLDM_SUCCESS;
+    }));
+    auto rc = request.start();
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+
+    // The event loop may invoke the retries late, the deadlines in the timer
+    // queue are checked as each retry schedules the next. The first retry
+    // waits for the timeout, the next twice as long up to the maximum, less
+    // a jitter of up to an eighth.
+    auto untilRetry = request.untilRetry();
+    ASSERT_TRUE(untilRetry);
+    EXPECT_LE(*untilRetry, milliseconds(40));
+    EXPECT_GT(*untilRetry, milliseconds(30));
+    for (auto timeout : {80, 100, 100})
+    {
+        auto sent = sends;
+        while (sends == sent)
+        {
+            ASSERT_GT(sd_event_run(event.get(), 500000), 0);
+        }
+        microseconds backedOff = milliseconds(timeout);
+        untilRetry = request.untilRetry();
+        ASSERT_TRUE(untilRetry);
+        EXPECT_LE(*untilRetry, backedOff);
+        EXPECT_GT(*untilRetry, backedOff - backedOff / 8 - milliseconds(10));
+    }
+
+    // The last retry schedules none
+    waitEventExpiry(milliseconds(200));
+    EXPECT_EQ(sends, 5);
+    EXPECT_EQ(request.getRetries(), 4);
+    EXPECT_FALSE(request.untilRetry());
+}
+
+TEST_F(RequestIntfTest, noRttSampleAfterRetry)
+{
+    MockRequest request(fd, eid, event, std::move(requestMsg), 1,
+                        milliseconds(40), 90000, false);
+    EXPECT_CALL(request, send()).Times(2).WillRepeatedly(Return(PLDM_SUCCESS));
+    auto rc = request.start();
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+
+    // A response to the request as first sent is a sample
+    EXPECT_TRUE(request.rttSample().has_value());
+
+    // Once retried, the response may be to either send (Karn's algorithm)
+    waitEventExpiry(milliseconds(200));
+    EXPECT_EQ(request.getRetries(), 1);
+    EXPECT_FALSE(request.rttSample().has_value());
+}
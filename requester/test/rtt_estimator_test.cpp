@@ -0,0 +1,50 @@
+#include "requester/rtt_estimator.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace pldm::requester;
+using namespace std::chrono;
+
+TEST(RttEstimator, initialTimeoutWithoutSamples)
+{
+    RttEstimator estimator(milliseconds(2000), milliseconds(100),
+                           milliseconds(4000));
+    EXPECT_EQ(estimator.timeout(9), milliseconds(2000));
+    EXPECT_EQ(estimator.maximum(), milliseconds(4000));
+    EXPECT_TRUE(estimator.get().empty());
+}
+
+TEST(RttEstimator, smoothedSamples)
+{
+    RttEstimator estimator(milliseconds(2000), milliseconds(10),
+                           milliseconds(4000));
+
+    // The first sample sets SRTT and half of it as RTTVAR
+    estimator.update(9, milliseconds(40));
+    auto estimate = estimator.get().at(9);
+    EXPECT_EQ(estimate.srtt, milliseconds(40));
+    EXPECT_EQ(estimate.rttvar, milliseconds(20));
+    EXPECT_EQ(estimate.rto, milliseconds(120));
+    EXPECT_EQ(estimator.timeout(9), milliseconds(120));
+
+    estimator.update(9, milliseconds(80));
+    estimate = estimator.get().at(9);
+    EXPECT_EQ(estimate.rttvar, milliseconds(25));
+    EXPECT_EQ(estimate.srtt, milliseconds(45));
+    EXPECT_EQ(estimate.rto, milliseconds(145));
+
+    // The other endpoints are not affected
+    EXPECT_EQ(estimator.timeout(10), milliseconds(2000));
+}
+
+TEST(RttEstimator, boundedTimeout)
+{
+    RttEstimator estimator(milliseconds(2000), milliseconds(100),
+                           milliseconds(3000));
+
+    estimator.update(9, milliseconds(1));
+    EXPECT_EQ(estimator.timeout(9), milliseconds(100));
+
+    estimator.update(10, milliseconds(5000));
+    EXPECT_EQ(estimator.timeout(10), milliseconds(3000));
+}
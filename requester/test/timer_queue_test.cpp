@@ -0,0 +1,120 @@
+#include "requester/timer_queue.hpp"
+
+#include <sdeventplus/event.hpp>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::requester;
+using namespace std::chrono;
+
+class TimerQueueTest : public testing::Test
+{
+  protected:
+    TimerQueueTest() :
+        event(sdeventplus::Event::get_default()),
+        timerQueue(TimerQueue::get(event))
+    {}
+
+    /** @brief This function runs the sd_event_run in a loop till all the events
+     *         in the testcase are dispatched and exits when there are no events
+     *         for the timeout time.
+     *
+     *  @param[in] timeout - maximum time to wait for an event
+     */
+    void waitEventExpiry(milliseconds timeout)
+    {
+        while (1)
+        {
+            auto sleepTime = duration_cast<microseconds>(timeout);
+            // Returns 0 on timeout
+            if (!sd_event_run(event.get(), sleepTime.count()))
+            {
+                break;
+            }
+        }
+    }
+
+    sdeventplus::Event event;
+    std::shared_ptr<TimerQueue> timerQueue;
+};
+
+TEST_F(TimerQueueTest, deadlinesInOrder)
+{
+    std::vector<int> expired;
+    timerQueue->schedule(milliseconds(30), [&]() { expired.push_back(3); });
+    timerQueue->schedule(milliseconds(10), [&]() { expired.push_back(1); });
+    timerQueue->schedule(milliseconds(20), [&]() { expired.push_back(2); });
+    EXPECT_EQ(timerQueue->size(), 3u);
+
+    waitEventExpiry(milliseconds(100));
+    EXPECT_EQ(expired, std::vector<int>({1, 2, 3}));
+    EXPECT_EQ(timerQueue->size(), 0u);
+}
+
+TEST_F(TimerQueueTest, cancelledDeadlines)
+{
+    int expired = 0;
+    auto id = timerQueue->schedule(milliseconds(10), [&]() { ++expired; });
+    for (int i = 0; i < 1000; ++i)
+    {
+        timerQueue->cancel(
+            timerQueue->schedule(milliseconds(10), [&]() { ++expired; }));
+    }
+    EXPECT_EQ(timerQueue->size(), 1u);
+
+    waitEventExpiry(milliseconds(100));
+    EXPECT_EQ(expired, 1);
+
+    // The Id of an expired deadline is not reused for the next one
+    auto next = timerQueue->schedule(milliseconds(10), [&]() { ++expired; });
+    EXPECT_NE(id, next);
+    timerQueue->cancel(id);
+    EXPECT_EQ(timerQueue->size(), 1u);
+
+    waitEventExpiry(milliseconds(100));
+    EXPECT_EQ(expired, 2);
+}
+
+TEST_F(TimerQueueTest, scheduleFromCallback)
+{
+    int expired = 0;
+    timerQueue->schedule(milliseconds(10), [&]() {
+        ++expired;
+        timerQueue->schedule(milliseconds(10), [&]() { ++expired; });
+    });
+
+    waitEventExpiry(milliseconds(100));
+    EXPECT_EQ(expired, 2);
+}
+
+TEST_F(TimerQueueTest, deadlineOfScheduled)
+{
+    auto before = TimerQueue::Clock::now();
+    auto id = timerQueue->schedule(milliseconds(50), []() {});
+    auto deadline = timerQueue->deadline(id);
+    ASSERT_TRUE(deadline);
+    EXPECT_GE(*deadline, before + milliseconds(50));
+    EXPECT_LE(*deadline, TimerQueue::Clock::now() + milliseconds(50));
+
+    // None once cancelled
+    timerQueue->cancel(id);
+    EXPECT_FALSE(timerQueue->deadline(id));
+}
+
+TEST_F(TimerQueueTest, releasedWithLastUser)
+{
+    auto id = timerQueue->schedule(milliseconds(50), []() {});
+    EXPECT_EQ(TimerQueue::get(event), timerQueue);
+
+    std::weak_ptr<TimerQueue> released = timerQueue;
+    timerQueue.reset();
+    EXPECT_TRUE(released.expired());
+
+    // A new queue is created for the event loop, without the deadlines of the
+    // one released
+    timerQueue = TimerQueue::get(event);
+    EXPECT_EQ(timerQueue->size(), 0u);
+    EXPECT_FALSE(timerQueue->deadline(id));
+}
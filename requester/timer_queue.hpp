@@ -0,0 +1,251 @@
+#pragma once
+
+#include <sdbusplus/timer.hpp>
+#include <sdeventplus/event.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace pldm
+{
+
+namespace requester
+{
+
+/** @class TimerQueue
+ *
+ *  Deadlines of the PLDM requests, the request retries and the instance ID
+ *  expiries, kept in a min-heap driven by a single sd-event timer. Scheduling
+ *  and cancelling a deadline reuse the storage of expired ones, so they don't
+ *  create a timer source each.
+ */
+class TimerQueue
+{
+  public:
+    using Id = uint64_t;
+    using Callback = std::function<void()>;
+    using Clock = std::chrono::steady_clock;
+
+    TimerQueue() = delete;
+    TimerQueue(const TimerQueue&) = delete;
+    TimerQueue(TimerQueue&&) = delete;
+    TimerQueue& operator=(const TimerQueue&) = delete;
+    TimerQueue& operator=(TimerQueue&&) = delete;
+    ~TimerQueue() = default;
+
+    /** @brief Constructor
+     *
+     *  @param[in] event - reference to PLDM daemon's main event loop
+     */
+    explicit TimerQueue(sdeventplus::Event& event) :
+        timer(event.get(), std::bind_front(&TimerQueue::expire, this))
+    {}
+
+    /** @brief Get the queue of the deadlines of an event loop
+     *
+     *  @param[in] event - reference to PLDM daemon's main event loop
+     *
+     *  @return the queue, created on first use. It is destroyed along with
+     *          its timer, which holds a reference on the event loop, once
+     *          the last user drops it.
+     */
+    static std::shared_ptr<TimerQueue> get(sdeventplus::Event& event)
+    {
+        // The address of an event loop may be reused once it is freed, which
+        // only happens after its queue is gone
+        static std::map<sd_event*, std::weak_ptr<TimerQueue>> queues;
+        std::erase_if(queues,
+                      [](const auto& queue) { return queue.second.expired(); });
+
+        auto& weakQueue = queues[event.get()];
+        auto queue = weakQueue.lock();
+        if (!queue)
+        {
+            queue = std::make_shared<TimerQueue>(event);
+            weakQueue = queue;
+        }
+        return queue;
+    }
+
+    /** @brief Schedule a callback
+     *
+     *  @param[in] timeout - time to wait before invoking the callback
+     *  @param[in] callback - callback to invoke
+     *
+     *  @return Id to cancel the callback with
+     */
+    Id schedule(std::chrono::microseconds timeout, Callback&& callback)
+    {
+        uint32_t index{};
+        if (freeSlots.empty())
+        {
+            index = slots.size();
+            slots.emplace_back();
+        }
+        else
+        {
+            index = freeSlots.back();
+            freeSlots.pop_back();
+        }
+        auto& slot = slots[index];
+        slot.active = true;
+        slot.callback = std::move(callback);
+        ++active;
+
+        Id id = static_cast<Id>(slot.generation) << 32 | index;
+        auto deadline = Clock::now() + timeout;
+        deadlines.emplace_back(deadline, id);
+        std::push_heap(deadlines.begin(), deadlines.end(), later);
+        if (!armed || deadline < armedDeadline)
+        {
+            arm(deadline);
+        }
+        return id;
+    }
+
+    /** @brief Cancel a scheduled callback, no-op if it was invoked already
+     *
+     *  @param[in] id - Id returned by schedule()
+     */
+    void cancel(Id id)
+    {
+        if (!isActive(id))
+        {
+            return;
+        }
+        release(static_cast<uint32_t>(id));
+
+        // The deadline stays in the heap till it is due, drop the cancelled
+        // ones when they outnumber the active ones
+        if (deadlines.size() > 2 * active + minDeadlines)
+        {
+            std::erase_if(deadlines, [this](const auto& deadline) {
+                return !isActive(deadline.second);
+            });
+            std::make_heap(deadlines.begin(), deadlines.end(), later);
+        }
+    }
+
+    /** @brief Get the deadline of a scheduled callback
+     *
+     *  @param[in] id - Id returned by schedule()
+     *
+     *  @return the deadline, none if the callback is not scheduled
+     */
+    std::optional<Clock::time_point> deadline(Id id) const
+    {
+        if (!isActive(id))
+        {
+            return std::nullopt;
+        }
+        auto it = std::find_if(
+            deadlines.begin(), deadlines.end(),
+            [id](const auto& deadline) { return deadline.second == id; });
+        return it->first;
+    }
+
+    /** @brief Get the number of callbacks scheduled */
+    size_t size() const
+    {
+        return active;
+    }
+
+  private:
+    using Deadline = std::pair<Clock::time_point, Id>;
+
+    /** @struct Slot
+     *
+     *  Storage of a callback, reused once the callback is invoked or cancelled
+     */
+    struct Slot
+    {
+        uint32_t generation = 0; //!< bumped when the slot is released
+        bool active = false;
+        Callback callback;
+    };
+
+    /** @brief Number of cancelled deadlines tolerated in the heap */
+    static constexpr size_t minDeadlines = 64;
+
+    phosphor::Timer timer; //!< fires at the earliest deadline
+    bool armed = false;
+    Clock::time_point armedDeadline;
+    std::vector<Deadline> deadlines; //!< min-heap of the deadlines
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+    size_t active = 0; //!< number of callbacks scheduled
+
+    static bool later(const Deadline& lhs, const Deadline& rhs)
+    {
+        return lhs.first > rhs.first;
+    }
+
+    bool isActive(Id id) const
+    {
+        auto index = static_cast<uint32_t>(id);
+        return index < slots.size() && slots[index].active &&
+               slots[index].generation == static_cast<uint32_t>(id >> 32);
+    }
+
+    void release(uint32_t index)
+    {
+        auto& slot = slots[index];
+        slot.active = false;
+        slot.callback = nullptr;
+        ++slot.generation;
+        freeSlots.push_back(index);
+        --active;
+    }
+
+    void arm(Clock::time_point deadline)
+    {
+        auto timeout = std::max(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                deadline - Clock::now()),
+            std::chrono::microseconds(0));
+        timer.start(timeout);
+        armed = true;
+        armedDeadline = deadline;
+    }
+
+    /** @brief Invoke the callbacks that are due and arm the timer for the
+     *         next deadline
+     */
+    void expire()
+    {
+        armed = false;
+        auto now = Clock::now();
+        while (!deadlines.empty() && deadlines.front().first <= now)
+        {
+            std::pop_heap(deadlines.begin(), deadlines.end(), later);
+            auto id = deadlines.back().second;
+            deadlines.pop_back();
+            if (!isActive(id))
+            {
+                continue;
+            }
+
+            // The callback may schedule or cancel deadlines
+            auto index = static_cast<uint32_t>(id);
+            auto callback = std::move(slots[index].callback);
+            release(index);
+            callback();
+        }
+
+        if (!deadlines.empty() && (!armed || deadlines.front().first <
+                                                 armedDeadline))
+        {
+            arm(deadlines.front().first);
+        }
+    }
+};
+
+} // namespace requester
+
+} // namespace pldm
@@ -2,8 +2,6 @@
 
 #include "pldmd/invoker.hpp"
 
-#include <stdexcept>
-
 #include <gtest/gtest.h>
 
 using namespace pldm;
@@ -50,11 +48,24 @@ TEST(Registration, testSuccess)
 
 TEST(Registration, testFailure)
 {
+    std::vector<uint8_t> requestMsg(sizeof(pldm_msg_hdr));
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    request->hdr.command = testCmd;
+
+    // Unsupported types and commands get a response rather than an exception
     Invoker invoker{};
-    ASSERT_THROW(invoker.handle(testType, testCmd, nullptr, 0),
-                 std::out_of_range);
+    auto result = invoker.handle(testType, testCmd, request, 0);
+    auto response = reinterpret_cast<pldm_msg*>(result.data());
+    ASSERT_EQ(result.size(), sizeof(pldm_msg));
+    EXPECT_EQ(response->hdr.command, testCmd);
+    EXPECT_EQ(response->payload[0], PLDM_ERROR_UNSUPPORTED_PLDM_CMD);
+
     invoker.registerHandler(testType, std::make_unique<TestHandler>());
     uint8_t badCmd = 0xFE;
-    ASSERT_THROW(invoker.handle(testType, badCmd, nullptr, 0),
-                 std::out_of_range);
+    request->hdr.command = badCmd;
+    result = invoker.handle(testType, badCmd, request, 0);
+    response = reinterpret_cast<pldm_msg*>(result.data());
+    ASSERT_EQ(result.size(), sizeof(pldm_msg));
+    EXPECT_EQ(response->hdr.command, badCmd);
+    EXPECT_EQ(response->payload[0], PLDM_ERROR_UNSUPPORTED_PLDM_CMD);
 }
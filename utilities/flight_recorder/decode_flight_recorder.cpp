@@ -0,0 +1,56 @@
+#include "common/flight_recorder.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <CLI/CLI.hpp>
+
+#include <iostream>
+#include <string>
+
+using namespace pldm::flightrecorder;
+
+int main(int argc, char** argv)
+{
+    CLI::App app{"Decode the PLDM flight recorder"};
+    std::string path = FLIGHT_RECORDER_FILE;
+    app.add_option("-f,--file", path, "Flight recorder file");
+    CLI11_PARSE(app, argc, argv);
+
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        std::cerr << "Failed to open " << path << ", errno = " << errno
+                  << "\n";
+        return -1;
+    }
+
+    struct stat st
+    {};
+    if (fstat(fd, &st) || !st.st_size)
+    {
+        std::cerr << "Failed to get the size of " << path << "\n";
+        close(fd);
+        return -1;
+    }
+
+    // The file is mapped so that pldmd can keep recording while it is read
+    auto memory = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED)
+    {
+        std::cerr << "Failed to map " << path << ", errno = " << errno << "\n";
+        return -1;
+    }
+
+    auto rc = decodeRecorder(std::cout, memory, st.st_size);
+    munmap(memory, st.st_size);
+    if (rc < 0)
+    {
+        std::cerr << path << " is not a PLDM flight recorder\n";
+        return -1;
+    }
+    return 0;
+}